@@ -0,0 +1,185 @@
+// snap_tools_resample_bench: times the Resampler on a synthetic HiDPI-sized capture against a
+// naive per-pixel bilinear implementation, for the sizes used by export scaling and thumbnails.
+
+#include "image/Resampler.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Gradients, hard edges and fine stripes, so every filter has real work to do
+    Imaging::Image MakeTestImage(int width, int height)
+    {
+        Imaging::Image image;
+        image.Allocate(width, height);
+        for (int y = 0; y < height; y++)
+        {
+            uint32_t *row = image.Row(y);
+            for (int x = 0; x < width; x++)
+            {
+                uint32_t r = (uint32_t)(x * 255 / std::max(width - 1, 1));
+                uint32_t g = (uint32_t)(y * 255 / std::max(height - 1, 1));
+                uint32_t b = ((x / 3) & 1) ? 230 : 20;
+                uint32_t a = ((x / 256 + y / 256) & 1) ? 255 : 192;
+                row[x] = r | (g << 8) | (b << 16) | (a << 24);
+            }
+        }
+        return image;
+    }
+
+    float SrgbToLinear(float c)
+    {
+        return c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float LinearToSrgb(float l)
+    {
+        return l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+    }
+
+    // The straightforward version: weights and color conversion recomputed for every pixel
+    void NaiveBilinear(const Imaging::Image &src, Imaging::Image &dst, int width, int height)
+    {
+        dst.Allocate(width, height);
+        float scaleX = (float)src.width / width;
+        float scaleY = (float)src.height / height;
+        for (int y = 0; y < height; y++)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                float sx = std::clamp((x + 0.5f) * scaleX - 0.5f, 0.0f, (float)(src.width - 1));
+                float sy = std::clamp((y + 0.5f) * scaleY - 0.5f, 0.0f, (float)(src.height - 1));
+                int x0 = (int)sx;
+                int y0 = (int)sy;
+                int x1 = std::min(x0 + 1, src.width - 1);
+                int y1 = std::min(y0 + 1, src.height - 1);
+                float fx = sx - x0;
+                float fy = sy - y0;
+                const uint32_t taps[4] = {src.Row(y0)[x0], src.Row(y0)[x1], src.Row(y1)[x0], src.Row(y1)[x1]};
+                const float weights[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+
+                float acc[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                for (int t = 0; t < 4; t++)
+                {
+                    float a = (taps[t] >> 24) / 255.0f;
+                    for (int c = 0; c < 3; c++)
+                        acc[c] += weights[t] * SrgbToLinear(((taps[t] >> (c * 8)) & 0xFF) / 255.0f) * a;
+                    acc[3] += weights[t] * a;
+                }
+
+                uint32_t pixel = (uint32_t)std::lround(acc[3] * 255.0f) << 24;
+                for (int c = 0; c < 3 && acc[3] > 0.0f; c++)
+                    pixel |= (uint32_t)std::lround(std::clamp(LinearToSrgb(acc[c] / acc[3]), 0.0f, 1.0f) * 255.0f) << (c * 8);
+                dst.Row(y)[x] = pixel;
+            }
+        }
+    }
+
+    template <typename Fn>
+    double MedianMs(int iterations, Fn &&fn)
+    {
+        std::vector<double> times;
+        for (int i = 0; i < iterations; i++)
+        {
+            auto start = std::chrono::steady_clock::now();
+            fn();
+            times.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+        std::sort(times.begin(), times.end());
+        return times[times.size() / 2];
+    }
+
+    void PrintUsage(const char *program)
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --width <n>        Source width (default 6144)\n"
+                  << "  --height <n>       Source height (default 3456)\n"
+                  << "  --iterations <n>   Timed runs per case, median is reported (default 5)\n"
+                  << "  --threads <n>      Resampler threads, 0 = one per core (default 0)\n"
+                  << "  --skip-naive       Do not time the naive bilinear reference\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    int sourceWidth = 6144;
+    int sourceHeight = 3456;
+    int iterations = 5;
+    int threads = 0;
+    bool naive = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--skip-naive") == 0)
+            naive = false;
+        else if (value != nullptr && strcmp(arg, "--width") == 0)
+            sourceWidth = atoi(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--height") == 0)
+            sourceHeight = atoi(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--iterations") == 0)
+            iterations = atoi(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--threads") == 0)
+            threads = atoi(argv[++i]);
+        else
+        {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (sourceWidth <= 0 || sourceHeight <= 0 || iterations <= 0 || threads < 0)
+    {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    Imaging::Image source = MakeTestImage(sourceWidth, sourceHeight);
+    Imaging::Resampler resampler(threads);
+    Imaging::Image target;
+
+    struct TargetSize
+    {
+        const char *name;
+        int width;
+        int height;
+    };
+    const TargetSize targets[] = {
+        {"half", sourceWidth / 2, sourceHeight / 2},
+        {"export_1920", 1920, std::max(1, 1920 * sourceHeight / sourceWidth)},
+        {"thumbnail", 320, std::max(1, 320 * sourceHeight / sourceWidth)},
+    };
+    const Imaging::ResampleFilter filters[] = {Imaging::ResampleFilter::Box, Imaging::ResampleFilter::Mitchell, Imaging::ResampleFilter::Lanczos3};
+
+    printf("source %dx%d, %d iterations, median ms\n", sourceWidth, sourceHeight, iterations);
+    printf("%-14s %-11s %10s\n", "target", "filter", "ms");
+    for (const TargetSize &size : targets)
+    {
+        if (size.width <= 0 || size.height <= 0)
+            continue;
+
+        for (Imaging::ResampleFilter filter : filters)
+        {
+            double ms = MedianMs(iterations, [&]()
+                                 { resampler.Resample(source, target, size.width, size.height, filter); });
+            printf("%-14s %-11s %10.2f\n", size.name, Imaging::GetFilterName(filter), ms);
+        }
+
+        if (naive)
+        {
+            double ms = MedianMs(iterations, [&]()
+                                 { NaiveBilinear(source, target, size.width, size.height); });
+            printf("%-14s %-11s %10.2f\n", size.name, "naive", ms);
+        }
+    }
+
+    return 0;
+}
\ No newline at end of file
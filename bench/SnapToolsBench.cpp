@@ -0,0 +1,793 @@
+// snap_tools_bench: drives Application/UIManager through scripted UI scenarios on the headless
+// platform, records CPU time per frame phase, heap allocations and draw statistics, writes the
+// results as JSON and optionally compares them against a checked-in baseline.
+//
+// Timing baselines are only meaningful on the machine that recorded them. Every run therefore
+// times a fixed calibration workload first; the baseline stores the recording machine's
+// calibration time and timings are scaled by the ratio when compared elsewhere. Counts
+// (allocations, draw calls, vertices, check failures) are compared as they are.
+
+#include "Application.h"
+#include "Json.h"
+#include "platform/HeadlessPlatform.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Allocation counting: operator new covers the application, ImGui is routed through
+// SetAllocatorFunctions since it allocates with malloc by default
+namespace
+{
+    std::atomic<uint64_t> g_allocCount{0};
+    std::atomic<uint64_t> g_allocBytes{0};
+
+    void *CountedAlloc(size_t size)
+    {
+        g_allocCount.fetch_add(1, std::memory_order_relaxed);
+        g_allocBytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void *ImGuiAlloc(size_t size, void *) { return CountedAlloc(size); }
+    void ImGuiFree(void *ptr, void *) { std::free(ptr); }
+}
+
+void *operator new(std::size_t size)
+{
+    if (void *ptr = CountedAlloc(size))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace
+{
+    constexpr int DISPLAY_WIDTH = 1280;
+    constexpr int DISPLAY_HEIGHT = 800;
+
+    struct BenchContext
+    {
+        Application *app = nullptr;
+        Platform::HeadlessPlatform *platform = nullptr;
+        UIManager *ui = nullptr;
+        int frame = 0;
+    };
+
+    struct Scenario
+    {
+        const char *name;
+        void (*setup)(BenchContext &);
+        void (*input)(BenchContext &); // Queues ImGui input events before the frame
+        void (*draw)(BenchContext &);  // Extra content submitted inside RenderFrame()
+        int (*check)(BenchContext &) = nullptr; // Counts failed expectations after each frame
+    };
+
+    // Deterministic pseudo-random numbers so every run draws the same content
+    struct Lcg
+    {
+        uint32_t state;
+        float Next()
+        {
+            state = state * 1664525u + 1013904223u;
+            return (state >> 8) * (1.0f / 16777216.0f);
+        }
+
+        uint64_t NextHash()
+        {
+            uint64_t hash = 0;
+            for (int i = 0; i < 4; i++)
+            {
+                state = state * 1664525u + 1013904223u;
+                hash = (hash << 16) | (state >> 16);
+            }
+            return hash;
+        }
+    };
+
+    void MouseClick(float x, float y, bool down)
+    {
+        ImGuiIO &io = ImGui::GetIO();
+        io.AddMousePosEvent(x, y);
+        io.AddMouseButtonEvent(ImGuiMouseButton_Left, down);
+    }
+
+    // Menu positions assume the default font and style at scale 1
+    void MenuNavigationInput(BenchContext &ctx)
+    {
+        ImGuiIO &io = ImGui::GetIO();
+        switch (ctx.frame % 40)
+        {
+        case 0: // Open "File"
+            MouseClick(18.0f, 9.0f, true);
+            break;
+        case 1:
+            MouseClick(18.0f, 9.0f, false);
+            break;
+        case 8: // Slide over to "View" while the menu is open
+            io.AddMousePosEvent(52.0f, 9.0f);
+            break;
+        case 16: // Hover the items of "View"
+            io.AddMousePosEvent(60.0f, 30.0f);
+            break;
+        case 20:
+            io.AddMousePosEvent(60.0f, 50.0f);
+            break;
+        case 26: // "Help"
+            io.AddMousePosEvent(90.0f, 9.0f);
+            break;
+        case 34: // Click outside to close
+            MouseClick(700.0f, 500.0f, true);
+            break;
+        case 35:
+            MouseClick(700.0f, 500.0f, false);
+            break;
+        }
+    }
+
+    void SettingsSetup(BenchContext &ctx)
+    {
+        ctx.ui->SetToolOpen(UIManager::TOOL_DEMO, false);
+        ctx.ui->SetToolOpen(UIManager::TOOL_SETTINGS, true);
+    }
+
+    void SettingsInput(BenchContext &ctx)
+    {
+        // Sweep the cursor across the settings window to exercise hover states
+        float t = (ctx.frame % 120) / 120.0f;
+        ImGui::GetIO().AddMousePosEvent(70.0f + t * 300.0f, 80.0f + t * 120.0f);
+    }
+
+    void GalleryDraw(BenchContext &ctx)
+    {
+        constexpr int ITEM_COUNT = 20000;
+        constexpr float THUMB_SIZE = 96.0f;
+        static char label[32];
+
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 20.0f));
+        ImGui::SetNextWindowSize(ImVec2((float)DISPLAY_WIDTH, DISPLAY_HEIGHT - 20.0f));
+        ImGui::Begin("Bench Gallery", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoMove);
+
+        float cellWidth = THUMB_SIZE + 8.0f;
+        float cellHeight = THUMB_SIZE + ImGui::GetTextLineHeightWithSpacing() + 8.0f;
+        int columns = std::max(1, (int)(ImGui::GetContentRegionAvail().x / cellWidth));
+        int rows = (ITEM_COUNT + columns - 1) / columns;
+
+        // Continuous scrolling so every frame lays out a different set of rows
+        ImGui::SetScrollY((float)((ctx.frame * 37) % (int)(rows * cellHeight)));
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        ImTextureRef atlas = ImGui::GetIO().Fonts->TexRef;
+        ImGuiListClipper clipper;
+        clipper.Begin(rows, cellHeight);
+        while (clipper.Step())
+        {
+            for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+            {
+                for (int column = 0; column < columns; column++)
+                {
+                    int item = row * columns + column;
+                    if (item >= ITEM_COUNT)
+                        break;
+                    if (column > 0)
+                        ImGui::SameLine();
+
+                    ImGui::BeginGroup();
+                    ImVec2 p = ImGui::GetCursorScreenPos();
+                    ImU32 tint = IM_COL32(64 + item * 37 % 192, 64 + item * 91 % 192, 64 + item * 13 % 192, 255);
+                    drawList->AddRectFilled(p, ImVec2(p.x + THUMB_SIZE, p.y + THUMB_SIZE), tint, 4.0f);
+                    drawList->AddImage(atlas, ImVec2(p.x + 8, p.y + 8), ImVec2(p.x + THUMB_SIZE - 8, p.y + THUMB_SIZE - 8));
+                    ImGui::Dummy(ImVec2(THUMB_SIZE, THUMB_SIZE));
+                    snprintf(label, sizeof(label), "capture_%05d", item);
+                    ImGui::TextUnformatted(label);
+                    ImGui::EndGroup();
+                }
+            }
+        }
+        clipper.End();
+
+        ImGui::End();
+    }
+
+    void AnnotationDraw(BenchContext &)
+    {
+        constexpr int SHAPE_COUNT = 4000;
+
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 20.0f));
+        ImGui::SetNextWindowSize(ImVec2((float)DISPLAY_WIDTH, DISPLAY_HEIGHT - 20.0f));
+        ImGui::Begin("Bench Annotation", nullptr, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoMove);
+
+        ImDrawList *drawList = ImGui::GetWindowDrawList();
+        ImVec2 origin = ImGui::GetCursorScreenPos();
+        ImVec2 size = ImGui::GetContentRegionAvail();
+        Lcg rng{12345u};
+        for (int i = 0; i < SHAPE_COUNT; i++)
+        {
+            ImVec2 a(origin.x + rng.Next() * size.x, origin.y + rng.Next() * size.y);
+            ImVec2 b(a.x + (rng.Next() - 0.5f) * 200.0f, a.y + (rng.Next() - 0.5f) * 200.0f);
+            ImU32 color = IM_COL32(255, (int)(rng.Next() * 255), 64, 220);
+            float thickness = 1.0f + rng.Next() * 4.0f;
+            switch (i % 5)
+            {
+            case 0:
+                drawList->AddLine(a, b, color, thickness);
+                break;
+            case 1:
+                drawList->AddRect(a, b, color, 3.0f, 0, thickness);
+                break;
+            case 2:
+                drawList->AddCircle(a, 4.0f + rng.Next() * 40.0f, color, 0, thickness);
+                break;
+            case 3:
+                drawList->AddBezierCubic(a, ImVec2(a.x, b.y), ImVec2(b.x, a.y), b, color, thickness);
+                break;
+            case 4:
+                drawList->AddText(a, color, "annotation");
+                break;
+            }
+        }
+        ImGui::Dummy(size);
+
+        ImGui::End();
+    }
+
+    constexpr int HISTORY_CAPTURES = 100000;
+
+    void HistorySetup(BenchContext &ctx)
+    {
+        ctx.ui->SetToolOpen(UIManager::TOOL_DEMO, false);
+        ctx.ui->SetToolOpen(UIManager::TOOL_HISTORY, true);
+
+        CaptureHistory &history = ctx.ui->GetHistory();
+        Lcg rng{777u};
+        char path[32];
+        uint64_t pHash = 0;
+        uint64_t dHash = 0;
+        for (int i = 0; i < HISTORY_CAPTURES; i++)
+        {
+            // Bursts of near-identical captures, like repeated screenshots of the same window
+            if (i % 8 == 0)
+            {
+                pHash = rng.NextHash();
+                dHash = rng.NextHash();
+            }
+            uint64_t noise = 1ull << (int)(rng.Next() * 64.0f);
+            snprintf(path, sizeof(path), "capture_%06d.png", i);
+            history.AddHashed(path, 1920, 1080, dHash ^ noise, pHash ^ noise, i);
+        }
+    }
+
+    void HistoryInput(BenchContext &ctx)
+    {
+        // A new selection every frame, so every frame runs both index queries
+        ctx.ui->SelectCapture((uint32_t)((ctx.frame * 7919) % HISTORY_CAPTURES) + 1);
+    }
+
+    // Display scale changes every 90 frames, cycling through common monitor scales. The check
+    // compares the live style with one scaled directly from the defaults, so any drift from
+    // rescaling an already scaled style shows up as a failure.
+    constexpr float DPI_SCALES[] = {1.0f, 1.5f, 2.0f, 1.25f};
+    constexpr int DPI_SWITCH_INTERVAL = 90;
+
+    void DpiSwitchSetup(BenchContext &ctx)
+    {
+        ctx.ui->SetToolOpen(UIManager::TOOL_SETTINGS, true);
+    }
+
+    void DpiSwitchInput(BenchContext &ctx)
+    {
+        if (ctx.frame % DPI_SWITCH_INTERVAL == 0)
+        {
+            int step = ctx.frame / DPI_SWITCH_INTERVAL;
+            ctx.platform->SetDisplayScale(DPI_SCALES[step % (int)(sizeof(DPI_SCALES) / sizeof(DPI_SCALES[0]))]);
+        }
+        float t = (ctx.frame % 60) / 60.0f;
+        ImGui::GetIO().AddMousePosEvent(100.0f + t * 400.0f, 120.0f + t * 200.0f);
+    }
+
+    int DpiSwitchCheck(BenchContext &ctx)
+    {
+        const Platform::DpiScaler &scaler = ctx.platform->GetDpiScaler();
+        // A switch must complete within a few frames of the request
+        if (scaler.IsSwitching())
+            return ctx.frame % DPI_SWITCH_INTERVAL > 4 ? 1 : 0;
+
+        ImGuiStyle expected;
+        ImGui::StyleColorsDark(&expected);
+        expected.ScaleAllSizes(scaler.GetScale());
+        const ImGuiStyle &style = ImGui::GetStyle();
+        bool matches = style.WindowPadding.x == expected.WindowPadding.x && style.WindowPadding.y == expected.WindowPadding.y &&
+                       style.FramePadding.x == expected.FramePadding.x && style.FramePadding.y == expected.FramePadding.y &&
+                       style.ItemSpacing.x == expected.ItemSpacing.x && style.ItemSpacing.y == expected.ItemSpacing.y &&
+                       style.WindowRounding == expected.WindowRounding && style.FontScaleDpi == scaler.GetScale();
+        return matches ? 0 : 1;
+    }
+
+    // The cursor rests for a few frames between moves across the synthetic desktop, so both
+    // the full re-upload after a move and the nothing-changed frames are measured
+    void LoupeSetup(BenchContext &ctx)
+    {
+        ctx.ui->SetToolOpen(UIManager::TOOL_DEMO, false);
+        ctx.ui->SetToolOpen(UIManager::TOOL_LOUPE, true);
+    }
+
+    void LoupeInput(BenchContext &ctx)
+    {
+        int step = ctx.frame / 4;
+        ctx.platform->SetGlobalMousePosition((step * 37) % Platform::HeadlessPlatform::DESKTOP_WIDTH, (step * 23) % Platform::HeadlessPlatform::DESKTOP_HEIGHT);
+    }
+
+    const Scenario SCENARIOS[] = {
+        {"idle", nullptr, nullptr, nullptr},
+        {"menu_navigation", nullptr, MenuNavigationInput, nullptr},
+        {"settings_window", SettingsSetup, SettingsInput, nullptr},
+        {"large_gallery", nullptr, nullptr, GalleryDraw},
+        {"heavy_annotation", nullptr, nullptr, AnnotationDraw},
+        {"history_search", HistorySetup, HistoryInput, nullptr},
+        {"dpi_switch", DpiSwitchSetup, DpiSwitchInput, nullptr, DpiSwitchCheck},
+        {"loupe", LoupeSetup, LoupeInput, nullptr},
+    };
+
+    struct Metric
+    {
+        const char *name;
+        double value;
+    };
+
+    struct ScenarioResult
+    {
+        std::string name;
+        std::vector<Metric> metrics;
+    };
+
+    struct RunSettings
+    {
+        int warmupFrames = 60;
+        int frames = 600;
+        bool software = false;   // Rasterize on the CPU, so present_ms covers actual rendering
+        std::string snapshotDir; // Write the last frame of each scenario as <dir>/<name>.ppm
+    };
+
+    bool RunScenario(const Scenario &scenario, const RunSettings &settings, ScenarioResult &result)
+    {
+        const int warmupFrames = settings.warmupFrames;
+        const int frames = settings.frames;
+
+        auto platform = std::make_unique<Platform::HeadlessPlatform>();
+        Platform::HeadlessPlatform *headless = platform.get();
+
+        Application app;
+        if (!app.Initialize(std::move(platform)))
+            return false;
+        headless->SetWindowSize(DISPLAY_WIDTH, DISPLAY_HEIGHT);
+        if (settings.software || !settings.snapshotDir.empty())
+            headless->EnableSoftwareRenderer();
+
+        BenchContext ctx;
+        ctx.app = &app;
+        ctx.platform = headless;
+        ctx.ui = app.GetUI();
+        if (scenario.setup)
+            scenario.setup(ctx);
+        if (scenario.draw)
+            headless->SetFrameCallback([&ctx, &scenario]()
+                                       { scenario.draw(ctx); });
+
+        std::vector<double> frameMs;
+        frameMs.reserve(frames);
+        double pollMs = 0.0, updateMs = 0.0, newFrameMs = 0.0, uiMs = 0.0, presentMs = 0.0;
+        double drawCalls = 0.0, vertices = 0.0, indices = 0.0, textureBinds = 0.0, textureUploadBytes = 0.0;
+        uint64_t allocCount = 0, allocBytes = 0;
+        int checkFailures = 0;
+
+        for (int i = 0; i < warmupFrames + frames; i++)
+        {
+            ctx.frame = i;
+            if (scenario.input)
+                scenario.input(ctx);
+
+            uint64_t countBefore = g_allocCount.load(std::memory_order_relaxed);
+            uint64_t bytesBefore = g_allocBytes.load(std::memory_order_relaxed);
+            app.Tick();
+            if (scenario.check)
+                checkFailures += scenario.check(ctx);
+            if (i < warmupFrames)
+                continue;
+
+            allocCount += g_allocCount.load(std::memory_order_relaxed) - countBefore;
+            allocBytes += g_allocBytes.load(std::memory_order_relaxed) - bytesBefore;
+
+            const FrameTimings &timings = app.GetLastFrameTimings();
+            frameMs.push_back(timings.totalMs);
+            pollMs += timings.pollMs;
+            updateMs += timings.updateMs;
+            newFrameMs += timings.newFrameMs;
+            uiMs += timings.uiMs;
+            presentMs += timings.presentMs;
+
+            const Platform::FrameRenderStats &stats = headless->GetRenderStats().GetLastFrame();
+            drawCalls += stats.drawCalls;
+            vertices += stats.vertices;
+            indices += stats.indices;
+            textureBinds += stats.textureBinds;
+            textureUploadBytes += (double)stats.textureUploadBytes;
+        }
+
+        if (!settings.snapshotDir.empty())
+        {
+            std::string path = settings.snapshotDir + "/" + scenario.name + ".ppm";
+            if (!headless->SaveSnapshot(path))
+                std::cerr << "Failed to write snapshot " << path << std::endl;
+        }
+        app.Shutdown();
+
+        double total = 0.0;
+        for (double ms : frameMs)
+            total += ms;
+        std::sort(frameMs.begin(), frameMs.end());
+        double p95 = frameMs.empty() ? 0.0 : frameMs[std::min(frameMs.size() - 1, (size_t)(frameMs.size() * 0.95))];
+
+        double n = std::max(frames, 1);
+        result.name = scenario.name;
+        result.metrics = {
+            {"cpu_ms_per_frame", total / n},
+            {"cpu_ms_p95", p95},
+            {"poll_ms", pollMs / n},
+            {"update_ms", updateMs / n},
+            {"new_frame_ms", newFrameMs / n},
+            {"ui_ms", uiMs / n},
+            {"present_ms", presentMs / n},
+            {"allocs_per_frame", allocCount / n},
+            {"alloc_bytes_per_frame", allocBytes / n},
+            {"draw_calls", drawCalls / n},
+            {"vertices", vertices / n},
+            {"indices", indices / n},
+            {"texture_binds", textureBinds / n},
+            {"texture_upload_bytes", textureUploadBytes / n},
+        };
+        if (scenario.check)
+            result.metrics.push_back({"check_failures", (double)checkFailures});
+        return true;
+    }
+
+    // Describes where a set of results was measured
+    struct MachineInfo
+    {
+        std::string cpu;
+        int cores = 0;
+        std::string compiler;
+        double calibrationMs = 0.0;
+    };
+
+    // Sorting and summing pseudo-random data: branchy, cache-sensitive CPU work like UI code,
+    // but independent of the application so a regression cannot hide in the scale factor.
+    // Best of several runs, to ignore scheduler noise.
+    double MeasureCalibrationMs()
+    {
+        constexpr int COUNT = 1 << 18;
+        std::vector<uint32_t> data(COUNT);
+        double best = 1e9;
+        for (int run = 0; run < 7; run++)
+        {
+            uint32_t state = 12345u;
+            for (uint32_t &value : data)
+            {
+                state = state * 1664525u + 1013904223u;
+                value = state >> 4;
+            }
+            auto start = std::chrono::steady_clock::now();
+            std::sort(data.begin(), data.end());
+            double sum = 0.0;
+            for (uint32_t value : data)
+                sum += std::sqrt((double)value);
+            double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+            if (sum > 0.0)
+                best = std::min(best, ms);
+        }
+        return best;
+    }
+
+    MachineInfo DescribeMachine()
+    {
+        MachineInfo machine;
+        std::ifstream cpuinfo("/proc/cpuinfo");
+        std::string line;
+        while (std::getline(cpuinfo, line))
+        {
+            if (line.compare(0, 10, "model name") == 0)
+            {
+                size_t colon = line.find(':');
+                machine.cpu = colon != std::string::npos ? line.substr(colon + 2) : line;
+                break;
+            }
+        }
+        if (machine.cpu.empty())
+            machine.cpu = "unknown";
+        machine.cores = (int)std::thread::hardware_concurrency();
+#if defined(__clang__)
+        machine.compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+        machine.compiler = "gcc " __VERSION__;
+#else
+        machine.compiler = "unknown";
+#endif
+        machine.calibrationMs = MeasureCalibrationMs();
+        return machine;
+    }
+
+    std::string Escape(const std::string &text)
+    {
+        std::string escaped;
+        for (char c : text)
+        {
+            if (c == '"' || c == '\\')
+                escaped += '\\';
+            escaped += c;
+        }
+        return escaped;
+    }
+
+    // Deterministic on the headless platform, so every baselined scenario has to pin them; an
+    // empty scenario entry would otherwise compare nothing and pass
+    constexpr const char *REQUIRED_METRICS[] = {"allocs_per_frame", "draw_calls", "vertices", "texture_upload_bytes"};
+
+    bool IsTimingMetric(const std::string &name)
+    {
+        return name.find("_ms") != std::string::npos;
+    }
+
+    std::string ToJson(const std::vector<ScenarioResult> &results, int frames, const MachineInfo &machine, const JsonValue *tolerances)
+    {
+        std::ostringstream out;
+        char calibration[32];
+        snprintf(calibration, sizeof(calibration), "%.4f", machine.calibrationMs);
+        out << "{\n  \"frames\": " << frames << ",\n";
+        out << "  \"machine\": {\n    \"cpu\": \"" << Escape(machine.cpu) << "\",\n    \"cores\": " << machine.cores
+            << ",\n    \"compiler\": \"" << Escape(machine.compiler) << "\",\n    \"calibration_ms\": " << calibration << "\n  },\n";
+        if (tolerances != nullptr)
+        {
+            out << "  \"tolerances\": {\n";
+            for (size_t i = 0; i < tolerances->members.size(); i++)
+            {
+                out << "    \"" << tolerances->members[i].first << "\": " << tolerances->members[i].second.number
+                    << (i + 1 < tolerances->members.size() ? ",\n" : "\n");
+            }
+            out << "  },\n";
+        }
+        out << "  \"scenarios\": {\n";
+        for (size_t s = 0; s < results.size(); s++)
+        {
+            out << "    \"" << results[s].name << "\": {\n";
+            for (size_t m = 0; m < results[s].metrics.size(); m++)
+            {
+                char number[64];
+                snprintf(number, sizeof(number), "%.4f", results[s].metrics[m].value);
+                out << "      \"" << results[s].metrics[m].name << "\": " << number
+                    << (m + 1 < results[s].metrics.size() ? ",\n" : "\n");
+            }
+            out << "    }" << (s + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  }\n}\n";
+        return out.str();
+    }
+
+    // Returns the number of metrics that exceed baseline * (1 + tolerance), plus one for every
+    // scenario the baseline does not cover and every required metric it does not record
+    int CompareWithBaseline(const std::vector<ScenarioResult> &results, const JsonValue &baseline, const MachineInfo &machine)
+    {
+        const JsonValue *scenarios = baseline.Find("scenarios");
+        const JsonValue *tolerances = baseline.Find("tolerances");
+        const JsonValue *defaultTolerance = tolerances ? tolerances->Find("default") : nullptr;
+        if (scenarios == nullptr)
+        {
+            std::cerr << "Baseline has no \"scenarios\" object" << std::endl;
+            return 1;
+        }
+
+        // Timings recorded elsewhere are scaled by how much slower this machine runs the calibration
+        const JsonValue *reference = baseline.Find("machine");
+        double referenceCalibration = reference ? reference->GetNumber("calibration_ms", 0.0) : 0.0;
+        double timeScale = referenceCalibration > 0.0 ? machine.calibrationMs / referenceCalibration : 1.0;
+        if (reference != nullptr)
+            printf("Baseline recorded on %s (%d cores, %s); timings scaled by %.2f\n", reference->GetString("cpu", "?").c_str(),
+                   (int)reference->GetNumber("cores", 0), reference->GetString("compiler", "?").c_str(), timeScale);
+        else
+            printf("Baseline has no reference machine, timings compared unscaled\n");
+
+        int regressions = 0;
+        for (const ScenarioResult &result : results)
+        {
+            const JsonValue *expected = scenarios->Find(result.name);
+            if (expected == nullptr)
+            {
+                std::cout << "[" << result.name << "] MISSING from baseline, record it with --update-baseline" << std::endl;
+                regressions++;
+                continue;
+            }
+
+            for (const char *required : REQUIRED_METRICS)
+            {
+                if (expected->Find(required) == nullptr)
+                {
+                    std::cout << "[" << result.name << "] " << required << " NOT RECORDED in baseline, record it with --update-baseline" << std::endl;
+                    regressions++;
+                }
+            }
+
+            for (const Metric &metric : result.metrics)
+            {
+                const JsonValue *limit = expected->Find(metric.name);
+                if (limit == nullptr)
+                    continue;
+
+                const JsonValue *tolerance = tolerances ? tolerances->Find(metric.name) : nullptr;
+                double allowed = tolerance ? tolerance->number : (defaultTolerance ? defaultTolerance->number : 0.1);
+                double expectedValue = IsTimingMetric(metric.name) ? limit->number * timeScale : limit->number;
+                double ceiling = expectedValue * (1.0 + allowed);
+
+                // Tiny absolute differences are noise, not regressions
+                bool regressed = metric.value > ceiling && metric.value - expectedValue > 0.01;
+                printf("[%s] %-22s %12.4f  baseline %12.4f  (+%.0f%% allowed)%s\n", result.name.c_str(), metric.name,
+                       metric.value, expectedValue, allowed * 100.0, regressed ? "  REGRESSION" : "");
+                if (regressed)
+                    regressions++;
+            }
+        }
+        return regressions;
+    }
+
+    bool ReadFile(const std::string &path, std::string &contents)
+    {
+        std::ifstream file(path);
+        if (!file)
+            return false;
+        std::ostringstream buffer;
+        buffer << file.rdbuf();
+        contents = buffer.str();
+        return true;
+    }
+
+    void PrintUsage(const char *program)
+    {
+        std::cout << "Usage: " << program << " [options]\n"
+                  << "  --frames <n>          Measured frames per scenario (default 600)\n"
+                  << "  --warmup <n>          Unmeasured warm-up frames per scenario (default 60)\n"
+                  << "  --scenario <name>     Run only this scenario (repeatable)\n"
+                  << "  --output <file>       Write results as JSON (default: stdout)\n"
+                  << "  --baseline <file>     Compare against a baseline, exit 1 on regression\n"
+                  << "  --update-baseline     Rewrite the baseline file with these results and this machine\n"
+                  << "  --software            Rasterize frames with the CPU software renderer\n"
+                  << "  --snapshot-dir <dir>  Save each scenario's last frame as a PPM (implies --software)\n"
+                  << "  --list                List scenarios\n";
+    }
+}
+
+int main(int argc, char **argv)
+{
+    RunSettings settings;
+    std::vector<std::string> selected;
+    std::string outputPath;
+    std::string baselinePath;
+    bool updateBaseline = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+        if (strcmp(arg, "--update-baseline") == 0)
+            updateBaseline = true;
+        else if (strcmp(arg, "--software") == 0)
+            settings.software = true;
+        else if (strcmp(arg, "--list") == 0)
+        {
+            for (const Scenario &scenario : SCENARIOS)
+                std::cout << scenario.name << std::endl;
+            return 0;
+        }
+        else if (value != nullptr && strcmp(arg, "--frames") == 0)
+            settings.frames = atoi(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--warmup") == 0)
+            settings.warmupFrames = atoi(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--snapshot-dir") == 0)
+            settings.snapshotDir = argv[++i];
+        else if (value != nullptr && strcmp(arg, "--scenario") == 0)
+            selected.push_back(argv[++i]);
+        else if (value != nullptr && strcmp(arg, "--output") == 0)
+            outputPath = argv[++i];
+        else if (value != nullptr && strcmp(arg, "--baseline") == 0)
+            baselinePath = argv[++i];
+        else
+        {
+            PrintUsage(argv[0]);
+            return 2;
+        }
+    }
+
+    if (settings.frames <= 0 || settings.warmupFrames < 0 || (updateBaseline && baselinePath.empty()))
+    {
+        PrintUsage(argv[0]);
+        return 2;
+    }
+
+    ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+
+    MachineInfo machine = DescribeMachine();
+    printf("Machine: %s, %d cores, %s, calibration %.3f ms\n", machine.cpu.c_str(), machine.cores, machine.compiler.c_str(), machine.calibrationMs);
+
+    std::vector<ScenarioResult> results;
+    for (const Scenario &scenario : SCENARIOS)
+    {
+        if (!selected.empty() && std::find(selected.begin(), selected.end(), scenario.name) == selected.end())
+            continue;
+
+        ScenarioResult result;
+        if (!RunScenario(scenario, settings, result))
+        {
+            std::cerr << "Scenario " << scenario.name << " failed to initialize" << std::endl;
+            return 2;
+        }
+        results.push_back(std::move(result));
+    }
+
+    JsonValue baseline;
+    std::string baselineText;
+    bool haveBaseline = false;
+    if (!baselinePath.empty() && ReadFile(baselinePath, baselineText))
+    {
+        JsonReader reader(baselineText);
+        haveBaseline = reader.Parse(baseline);
+        if (!haveBaseline)
+        {
+            std::cerr << "Failed to parse baseline " << baselinePath << std::endl;
+            return 2;
+        }
+    }
+
+    std::string json = ToJson(results, settings.frames, machine, nullptr);
+    if (outputPath.empty())
+    {
+        std::cout << json;
+    }
+    else
+    {
+        std::ofstream output(outputPath, std::ios::trunc);
+        output << json;
+    }
+
+    if (updateBaseline)
+    {
+        // Keep the tolerances that are already checked in
+        std::ofstream output(baselinePath, std::ios::trunc);
+        output << ToJson(results, settings.frames, machine, haveBaseline ? baseline.Find("tolerances") : nullptr);
+        std::cout << "Baseline updated: " << baselinePath << std::endl;
+        return 0;
+    }
+
+    if (!baselinePath.empty())
+    {
+        if (!haveBaseline)
+        {
+            std::cerr << "Cannot read baseline " << baselinePath << std::endl;
+            return 2;
+        }
+        int regressions = CompareWithBaseline(results, baseline, machine);
+        std::cout << (regressions ? "FAILED: " : "OK: ") << regressions << " regression(s)" << std::endl;
+        return regressions ? 1 : 0;
+    }
+
+    return 0;
+}
\ No newline at end of file
@@ -0,0 +1,90 @@
+# Profile-guided and link-time optimization for release builds.
+#
+#   SNAP_TOOLS_PGO=GENERATE   instrumented build; running it writes profiles to SNAP_TOOLS_PGO_DIR
+#   SNAP_TOOLS_PGO=USE        rebuild optimized with the collected profiles
+#   SNAP_TOOLS_LTO=THIN|FULL  link-time optimization across the app and the imgui static library
+#
+# scripts/pgo_build.sh drives the whole generate/train/use cycle and compares the result
+# against a plain release build.
+
+set(SNAP_TOOLS_PGO "OFF" CACHE STRING "Profile-guided optimization phase: OFF, GENERATE or USE")
+set_property(CACHE SNAP_TOOLS_PGO PROPERTY STRINGS OFF GENERATE USE)
+set(SNAP_TOOLS_PGO_DIR "${CMAKE_BINARY_DIR}/pgo-profiles" CACHE PATH "Directory holding PGO profile data")
+set(SNAP_TOOLS_LTO "OFF" CACHE STRING "Link-time optimization: OFF, THIN or FULL")
+set_property(CACHE SNAP_TOOLS_LTO PROPERTY STRINGS OFF THIN FULL)
+
+if(NOT SNAP_TOOLS_PGO STREQUAL "OFF" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang|GNU")
+    message(WARNING "SNAP_TOOLS_PGO is only supported with GCC and Clang, disabling it")
+    set(SNAP_TOOLS_PGO "OFF")
+endif()
+
+if(NOT SNAP_TOOLS_LTO STREQUAL "OFF")
+    include(CheckIPOSupported)
+    check_ipo_supported(RESULT SNAP_TOOLS_IPO_SUPPORTED OUTPUT SNAP_TOOLS_IPO_ERROR LANGUAGES CXX)
+    if(NOT SNAP_TOOLS_IPO_SUPPORTED)
+        message(WARNING "LTO is not supported by this toolchain: ${SNAP_TOOLS_IPO_ERROR}")
+        set(SNAP_TOOLS_LTO "OFF")
+    elseif(SNAP_TOOLS_LTO STREQUAL "THIN" AND NOT CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+        message(STATUS "ThinLTO needs Clang, using parallel full LTO instead")
+    endif()
+endif()
+
+if(SNAP_TOOLS_PGO STREQUAL "USE")
+    if(CMAKE_CXX_COMPILER_ID MATCHES "Clang" AND NOT EXISTS "${SNAP_TOOLS_PGO_DIR}/default.profdata")
+        message(FATAL_ERROR "No merged profile at ${SNAP_TOOLS_PGO_DIR}/default.profdata, run llvm-profdata merge first")
+    endif()
+endif()
+
+message(STATUS "PGO: ${SNAP_TOOLS_PGO}, LTO: ${SNAP_TOOLS_LTO}")
+
+# Applies the selected PGO/LTO flags to the given targets
+function(snap_tools_enable_optimizations)
+    foreach(target IN LISTS ARGN)
+        get_target_property(target_type ${target} TYPE)
+
+        set(pgo_flags "")
+        if(SNAP_TOOLS_PGO STREQUAL "GENERATE")
+            if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+                set(pgo_flags -fprofile-generate=${SNAP_TOOLS_PGO_DIR})
+            else()
+                set(pgo_flags -fprofile-generate=${SNAP_TOOLS_PGO_DIR} -fprofile-update=atomic)
+            endif()
+        elseif(SNAP_TOOLS_PGO STREQUAL "USE")
+            if(CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+                set(pgo_flags -fprofile-use=${SNAP_TOOLS_PGO_DIR}/default.profdata
+                    -Wno-profile-instr-unprofiled -Wno-profile-instr-out-of-date)
+            else()
+                # Code not reached by the training runs keeps its normal optimization
+                set(pgo_flags -fprofile-use=${SNAP_TOOLS_PGO_DIR} -fprofile-partial-training -Wno-missing-profile)
+            endif()
+        endif()
+
+        if(pgo_flags)
+            target_compile_options(${target} PRIVATE ${pgo_flags})
+            if(NOT target_type STREQUAL "STATIC_LIBRARY")
+                target_link_options(${target} PRIVATE ${pgo_flags})
+            endif()
+        endif()
+
+        if(NOT SNAP_TOOLS_LTO STREQUAL "OFF")
+            # Also switches the archiver to the LTO-aware one for the imgui static library
+            set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION TRUE)
+            # Spelled out for Clang: with IPO alone, recent CMake versions pick -flto=thin
+            if(SNAP_TOOLS_LTO STREQUAL "THIN" AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+                set(lto_flags -flto=thin)
+            elseif(SNAP_TOOLS_LTO STREQUAL "FULL" AND CMAKE_CXX_COMPILER_ID MATCHES "Clang")
+                set(lto_flags -flto=full)
+            elseif(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+                set(lto_flags -flto=auto)
+            else()
+                set(lto_flags "")
+            endif()
+            if(lto_flags)
+                target_compile_options(${target} PRIVATE ${lto_flags})
+                if(NOT target_type STREQUAL "STATIC_LIBRARY")
+                    target_link_options(${target} PRIVATE ${lto_flags})
+                endif()
+            endif()
+        endif()
+    endforeach()
+endfunction()
\ No newline at end of file
@@ -1,20 +1,54 @@
 #ifndef APPLICATION_H
 #define APPLICATION_H
 
+#include <cstdint>
+#include <fstream>
 #include <memory>
+#include <string>
 #include "platform/IPlatform.h"
 #include "UIManager.h"
 
+// Command line driven options, see main.cpp
+struct ApplicationOptions
+{
+    std::string recordInputPath;      // Record every input event to this log
+    std::string replayInputPath;      // Replay a recorded log instead of live input
+    float replayDeltaTime = 1.0f / 60.0f;
+    std::string frameTimesPath;       // Write per-frame CPU timings as CSV
+    size_t residentBudgetMb = 0;      // Evict caches when RSS exceeds this, 0 = no budget
+    size_t gpuBudgetMb = 0;           // Same for tracked GPU memory
+};
+
+// CPU time spent in each phase of one frame
+struct FrameTimings
+{
+    double pollMs = 0.0;
+    double updateMs = 0.0;
+    double newFrameMs = 0.0;
+    double uiMs = 0.0;
+    double presentMs = 0.0;
+    double totalMs = 0.0;
+};
+
 class Application
 {
 public:
     Application();
     ~Application();
 
-    bool Initialize();
+    bool Initialize(const ApplicationOptions &options = ApplicationOptions());
+    // Uses the given platform instead of the native one, e.g. Platform::HeadlessPlatform
+    bool Initialize(std::unique_ptr<Platform::IPlatform> platform, const ApplicationOptions &options = ApplicationOptions());
     void Run();
     void Shutdown();
 
+    // Runs a single iteration of the main loop
+    void Tick();
+    const FrameTimings &GetLastFrameTimings() const { return m_lastFrameTimings; }
+
+    Platform::IPlatform *GetPlatform() const { return m_platform.get(); }
+    UIManager *GetUI() const { return m_ui.get(); }
+
     bool IsRunning() const { return m_running; }
     void Stop() { m_running = false; }
 
@@ -23,8 +57,11 @@ private:
     std::unique_ptr<UIManager> m_ui;
     bool m_running;
 
+    uint64_t m_frameIndex;
+    FrameTimings m_lastFrameTimings;
+    std::ofstream m_frameTimesFile;
+
     void Update();
-    void Render();
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+#ifndef BATCH_PROCESSOR_H
+#define BATCH_PROCESSOR_H
+
+#include "ThreadPool.h"
+#include "image/ImageCodec.h"
+#include "image/Redact.h"
+#include "image/Resampler.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct BatchOptions
+{
+    std::vector<std::string> inputs; // Files, directories, or patterns with * and ? in the file name
+    std::string outputDirectory;
+    std::string redactSpecPath; // JSON file listing regions to fill or pixelate
+
+    // Resize, at most one of: exact size (aspect kept if one side is 0), fit within a
+    // square, or a scale factor
+    int resizeWidth = 0;
+    int resizeHeight = 0;
+    int maxSize = 0;
+    float scale = 0.0f;
+    Imaging::ResampleFilter filter = Imaging::ResampleFilter::Lanczos3;
+
+    Imaging::ImageFormat format = Imaging::ImageFormat::Unknown; // Unknown keeps the format named by each input's extension
+    bool stripMetadata = false;
+    int compressionLevel = 6;
+    int jobs = 0; // Images in flight at once, 0 = one per core
+    bool verbose = false;
+};
+
+// Headless image pipeline for `snap_tools --batch`: read, decode, redact, resize, encode and
+// write each input. One worker takes an image from start to finish before picking up the
+// next, so at most `jobs` images are decoded at any time and memory stays bounded however
+// many files are queued.
+class BatchProcessor
+{
+public:
+    explicit BatchProcessor(const BatchOptions &options);
+
+    // Returns the process exit code: 0 if every image was written
+    int Run();
+
+private:
+    // An input and where it is written, planned up front so no two inputs share an output
+    struct BatchItem
+    {
+        std::string input;
+        std::string output;
+        Imaging::ImageFormat format; // Unknown: the input has no image extension, use the decoded format
+    };
+
+    // Redact regions as written in the spec; relative ones are fractions of the image size
+    struct RegionSpec
+    {
+        float x, y, width, height;
+        bool relative;
+        Imaging::RedactRegion region;
+    };
+
+    bool CollectInputs(std::vector<BatchItem> &items) const;
+    bool LoadRedactSpec();
+    void ProcessFile(const BatchItem &item);
+    bool TransformFile(const BatchItem &item, std::string &error);
+    bool ComputeTargetSize(int width, int height, int &targetWidth, int &targetHeight) const;
+
+    BatchOptions m_options;
+    ThreadPool m_pool;
+    std::vector<RegionSpec> m_regions;
+    std::mutex m_logMutex;
+
+    std::atomic<uint64_t> m_bytesRead;
+    std::atomic<uint64_t> m_bytesWritten;
+    std::atomic<uint64_t> m_pixels;
+    std::atomic<int> m_succeeded;
+    std::atomic<int> m_failed;
+};
+
+#endif // BATCH_PROCESSOR_H
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef CAPTURE_HISTORY_H
+#define CAPTURE_HISTORY_H
+
+#include "image/HashIndex.h"
+#include "image/Image.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct CaptureEntry
+{
+    uint32_t id = 0;
+    std::string path;
+    int64_t timestamp = 0; // Seconds since the epoch
+    int width = 0;
+    int height = 0;
+    uint64_t dHash = 0;
+    uint64_t pHash = 0;
+};
+
+struct CaptureMatch
+{
+    uint32_t id;
+    int distance; // pHash Hamming distance in bits
+};
+
+// Captures taken this session, in the order they were taken. Perceptual hashes are computed
+// once at ingest and indexed, so duplicate and similarity queries never touch pixels.
+class CaptureHistory
+{
+public:
+    // Near-duplicate: both dHash and pHash within this many bits
+    static constexpr int DUPLICATE_DISTANCE = 8;
+    // Default pHash radius for "similar captures"
+    static constexpr int SIMILAR_DISTANCE = 12;
+
+    struct AddResult
+    {
+        uint32_t id = 0;        // The new entry, or the existing one when skipped as a duplicate
+        bool duplicate = false; // True if dedup on save kept the capture out of the history
+    };
+
+    CaptureHistory();
+
+    // Hashes the image and records it. With dedup on save enabled, a capture that is a
+    // near-duplicate of an existing entry is not added.
+    AddResult Add(const Imaging::Image &image, const std::string &path);
+    // Records a capture whose hashes are already known, e.g. when reloading a history
+    AddResult AddHashed(const std::string &path, int width, int height, uint64_t dHash, uint64_t pHash, int64_t timestamp);
+    bool Remove(uint32_t id);
+    // Removes every listed entry with a single compaction; returns how many existed
+    size_t Remove(const std::vector<uint32_t> &ids);
+    void Clear();
+
+    // Both return matches nearest first, excluding the entry itself
+    void FindDuplicates(uint32_t id, std::vector<CaptureMatch> &out) const;
+    void FindSimilar(uint32_t id, int maxDistance, std::vector<CaptureMatch> &out) const;
+
+    const CaptureEntry *Find(uint32_t id) const;
+    const std::vector<CaptureEntry> &GetEntries() const { return m_entries; }
+    // Bumped by every add, remove and clear, so cached query results can tell they are stale
+    uint64_t GetGeneration() const { return m_generation; }
+
+    void SetDedupOnSave(bool enabled) { m_dedupOnSave = enabled; }
+    bool GetDedupOnSave() const { return m_dedupOnSave; }
+
+    // Approximate heap footprint of the entries and indexes
+    size_t GetMemoryBytes() const;
+
+private:
+    bool FindDuplicateOf(uint64_t dHash, uint64_t pHash, uint32_t exclude, std::vector<CaptureMatch> *out) const;
+
+    std::vector<CaptureEntry> m_entries;
+    std::unordered_map<uint32_t, size_t> m_indexById;
+    Imaging::HashIndex m_index; // Keyed by pHash
+    mutable std::vector<Imaging::HashIndex::Match> m_queryScratch;
+    uint64_t m_generation;
+    uint32_t m_nextId;
+    bool m_dedupOnSave;
+};
+
+#endif // CAPTURE_HISTORY_H
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef EDITOR_TOOL_H
+#define EDITOR_TOOL_H
+
+#include "CaptureHistory.h"
+#include "MemoryTracker.h"
+#include "ToolRegistry.h"
+#include "image/ImageCodec.h"
+#include "image/Resampler.h"
+#include "image/UndoHistory.h"
+#include "imgui.h"
+#include <memory>
+#include <string>
+#include <vector>
+
+// Redacts and crops a capture from the history, with undo. Every edit records through
+// UndoHistory, so a step costs the tiles it changed; the history's memory is reported to
+// the MemoryTracker and trimmed, oldest steps first, under memory pressure. The window shows
+// a downscaled preview, rebuilt after each edit, rather than uploading the full capture.
+class EditorTool : public ITool
+{
+public:
+    static constexpr int PREVIEW_SIZE = 640;
+
+    explicit EditorTool(CaptureHistory &history);
+    ~EditorTool() override;
+
+    void Render(bool *open) override;
+    // Drops the preview and its texture; the edited image and its undo steps are kept
+    bool ReleaseResources() override;
+
+    bool Open(uint32_t id);
+    bool Undo();
+    bool Redo();
+
+private:
+    void Redact();
+    void Crop();
+    bool Save();
+    void UpdatePreview();
+    void RetireTexture();
+    bool ReleaseRetiredTextures();
+
+    CaptureHistory &m_history;
+    std::string m_path;
+    Imaging::ImageFile m_file;
+    Imaging::UndoHistory m_undo;
+
+    Imaging::Resampler m_resampler;
+    Imaging::Image m_preview;
+    std::unique_ptr<ImTextureData> m_texture;
+    std::vector<std::unique_ptr<ImTextureData>> m_retiredTextures; // Waiting for the renderer to drop them
+    bool m_previewDirty;
+
+    int m_region[4]; // x, y, width, height in image pixels
+    int m_mode;      // Imaging::RedactMode
+    int m_blockSize;
+    char m_status[256];
+
+    ScopedMemorySource m_imageMemory;
+    ScopedMemorySource m_undoMemory;
+};
+
+#endif // EDITOR_TOOL_H
\ No newline at end of file
@@ -0,0 +1,55 @@
+#ifndef JSON_H
+#define JSON_H
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal JSON document model for configuration and baseline files
+struct JsonValue
+{
+    enum class Type
+    {
+        Null,
+        Bool,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;                            // Array elements
+    std::vector<std::pair<std::string, JsonValue>> members; // Object members, in file order
+
+    const JsonValue *Find(const std::string &key) const;
+    double GetNumber(const std::string &key, double fallback) const;
+    std::string GetString(const std::string &key, const std::string &fallback) const;
+};
+
+class JsonReader
+{
+public:
+    explicit JsonReader(const std::string &text) : m_text(text), m_pos(0) {}
+
+    // Parses the whole document; on failure GetErrorOffset() points at the offending character
+    bool Parse(JsonValue &value);
+    size_t GetErrorOffset() const { return m_pos; }
+
+private:
+    bool ParseValue(JsonValue &value, int depth);
+    bool ParseString(std::string &out);
+    bool ParseLiteral(const char *literal);
+    void SkipSpace();
+    bool Peek(char c);
+    bool Expect(char c);
+
+    const std::string &m_text;
+    size_t m_pos;
+};
+
+#endif // JSON_H
\ No newline at end of file
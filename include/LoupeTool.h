@@ -0,0 +1,52 @@
+#ifndef LOUPE_TOOL_H
+#define LOUPE_TOOL_H
+
+#include "MemoryTracker.h"
+#include "image/Image.h"
+#include "imgui.h"
+#include "ToolRegistry.h"
+#include "platform/IPlatform.h"
+#include <cstddef>
+#include <memory>
+
+// Magnifier and color picker that follows the cursor across the desktop. Every frame it
+// grabs only the GRAB_SIZE x GRAB_SIZE pixels around the cursor into a reused image and
+// compares them with what the texture already shows; only the changed cells are upscaled
+// into the texture and queued as a sub-rectangle update, so a still desktop uploads nothing.
+// The texture is stored at display zoom, which keeps pixel edges sharp with the linear
+// filtering every backend uses.
+class LoupeTool : public ITool
+{
+public:
+    static constexpr int GRAB_SIZE = 33; // Odd, so one pixel sits under the crosshair
+    static constexpr int ZOOM = 8;
+
+    explicit LoupeTool(Platform::IPlatform &platform);
+    ~LoupeTool() override;
+
+    void Render(bool *open) override;
+    // Drops the grab buffers and hands the texture back to the renderer; the next Render()
+    // recreates them
+    bool ReleaseResources() override;
+
+private:
+    void UpdateTexture();
+    void WriteCells(int x0, int y0, int x1, int y1);
+
+    Platform::IPlatform &m_platform;
+    Imaging::Image m_grab;  // Reused every frame
+    Imaging::Image m_shown; // Contents of the texture, one pixel per cell
+    std::unique_ptr<ImTextureData> m_texture;
+
+    int m_cursorX;
+    int m_cursorY;
+    bool m_available;
+    bool m_frozen;
+    size_t m_uploadBytes; // Queued for upload this frame
+    // Text formatting buffers, so drawing allocates no strings
+    char m_line[96];
+    char m_hex[8]; // Picked color, also what "Copy hex" copies
+    ScopedMemorySource m_textureMemory; // Last, so it is unregistered before the texture goes
+};
+
+#endif // LOUPE_TOOL_H
\ No newline at end of file
@@ -0,0 +1,152 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class MemoryKind
+{
+    Heap, // CPU memory, counted against the resident set budget
+    Gpu   // Textures and buffers we asked the graphics API for
+};
+
+struct MemorySourceStats
+{
+    int id = 0;
+    std::string name;
+    MemoryKind kind = MemoryKind::Heap;
+    bool evictable = false;
+    size_t bytes = 0;
+    size_t peakBytes = 0;
+    size_t evictedBytes = 0; // Total released by budget enforcement
+};
+
+// Process-wide memory accounting. Subsystems register a source that reports the bytes they
+// own; sources are polled when the tracker samples (twice a second from Update()), so
+// reporting costs nothing on hot paths. Resident set size comes from the OS.
+//
+// With a budget set, evictable sources (caches that can be rebuilt) are asked to release
+// memory, lowest priority first, until usage is back under 90% of the budget. Heap sources
+// are trimmed when RSS exceeds the resident budget, GPU sources when the tracked GPU total
+// exceeds the GPU budget. Evict callbacks are invoked on the sampling thread without the
+// tracker's lock held, so they may register and unregister sources.
+//
+// Measure callbacks, unlike evict callbacks, run with the tracker's lock held. That is what lets
+// an owner unregister from any thread and then destroy itself: once Unregister returns, its
+// callback is not running and will not run again. A measure callback must therefore only read
+// its owner's sizes (atomics, or state of the sampling thread). It must not call into the
+// tracker, which would deadlock, or wait on a lock whose holder may be registering a source.
+class MemoryTracker
+{
+public:
+    using MeasureFn = std::function<size_t()>;
+    // Receives the number of bytes wanted, returns the number actually released
+    using EvictFn = std::function<size_t(size_t)>;
+
+    static MemoryTracker &Get();
+
+    int Register(const std::string &name, MemoryKind kind, MeasureFn measure, EvictFn evict = nullptr, int priority = 0);
+    void Unregister(int id);
+
+    // Bytes, 0 disables the budget
+    void SetBudgets(size_t residentBytes, size_t gpuBytes);
+    size_t GetResidentBudget() const { return m_residentBudget; }
+    size_t GetGpuBudget() const { return m_gpuBudget; }
+
+    // Call once per frame; samples and enforces budgets at the sampling interval
+    void Update();
+    void Sample();
+
+    // Releases everything evictable of `kind`, regardless of budgets
+    size_t EvictAll(MemoryKind kind);
+
+    // Results of the last sample
+    size_t GetResidentBytes() const { return m_residentBytes; }
+    size_t GetPeakResidentBytes() const { return m_peakResidentBytes; }
+    size_t GetTrackedBytes(MemoryKind kind) const { return kind == MemoryKind::Heap ? m_trackedHeapBytes : m_trackedGpuBytes; }
+    const std::vector<MemorySourceStats> &GetSources() const { return m_stats; }
+    int GetEvictionCount() const { return m_evictionCount; }
+    // Increments with every sample, so views can tell when new numbers are available
+    uint64_t GetSampleCount() const { return m_sampleCount; }
+
+    // Resident set size of this process, 0 where unsupported
+    static size_t ReadResidentBytes();
+
+    // Routes ImGui's allocations through a counting allocator and registers it as the
+    // "ImGui" source. Must run before the first ImGui context is created.
+    static void InstallImGuiAllocator();
+
+private:
+    struct Source
+    {
+        int id;
+        std::string name;
+        MemoryKind kind;
+        MeasureFn measure;
+        EvictFn evict;
+        int priority;
+        size_t peakBytes;
+        size_t evictedBytes;
+    };
+
+    MemoryTracker();
+
+    // Takes the lock itself, only around copying the callbacks and recording the results
+    size_t Evict(MemoryKind kind, size_t bytesWanted);
+    // Callers hold m_mutex, which measure callbacks run under (see the class comment)
+    void RefreshStats();
+
+    std::mutex m_mutex;
+    std::vector<Source> m_sources;
+    std::vector<MemorySourceStats> m_stats;
+    int m_nextId;
+
+    size_t m_residentBudget;
+    size_t m_gpuBudget;
+    size_t m_residentBytes;
+    size_t m_peakResidentBytes;
+    size_t m_trackedHeapBytes;
+    size_t m_trackedGpuBytes;
+    int m_evictionCount;
+    uint64_t m_sampleCount;
+
+    std::chrono::steady_clock::time_point m_nextSample;
+    // Set after an eviction pass that freed nothing, so an unreachable budget does not
+    // trigger eviction (and cache rebuilds) every sample
+    std::chrono::steady_clock::time_point m_evictionBackoff;
+};
+
+// Registration owned by a member, unregistered when it goes out of scope
+class ScopedMemorySource
+{
+public:
+    ScopedMemorySource() : m_id(0) {}
+    ~ScopedMemorySource() { Reset(); }
+
+    ScopedMemorySource(const ScopedMemorySource &) = delete;
+    ScopedMemorySource &operator=(const ScopedMemorySource &) = delete;
+
+    void Register(const std::string &name, MemoryKind kind, MemoryTracker::MeasureFn measure,
+                  MemoryTracker::EvictFn evict = nullptr, int priority = 0)
+    {
+        Reset();
+        m_id = MemoryTracker::Get().Register(name, kind, std::move(measure), std::move(evict), priority);
+    }
+
+    void Reset()
+    {
+        if (m_id != 0)
+            MemoryTracker::Get().Unregister(m_id);
+        m_id = 0;
+    }
+
+private:
+    int m_id;
+};
+
+#endif // MEMORY_TRACKER_H
\ No newline at end of file
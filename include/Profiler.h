@@ -0,0 +1,67 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+
+// Named CPU scopes summed per frame, for work that is not a frame phase of its own (tools,
+// screen grabs). Results are shown in the renderer stats overlay. Main thread only; scope
+// names are compared by pointer first and must outlive the program, e.g. string literals.
+class Profiler
+{
+public:
+    static constexpr int MAX_SCOPES = 32;
+    static constexpr int HISTORY_SIZE = 120;
+
+    struct ScopeStats
+    {
+        const char *name = nullptr;
+        double lastMs = 0.0;     // Total of the last finished frame
+        int lastCalls = 0;
+        double averageMs = 0.0;  // Exponential moving average over frames
+        float history[HISTORY_SIZE] = {};
+    };
+
+    static Profiler &Get();
+
+    void AddSample(const char *name, double milliseconds);
+    // Publishes the totals of the current frame; called once per frame by Application
+    void EndFrame();
+
+    int GetScopeCount() const { return m_scopeCount; }
+    const ScopeStats &GetScope(int index) const { return m_scopes[index].stats; }
+    int GetHistoryIndex() const { return m_historyIndex; }
+
+private:
+    struct Scope
+    {
+        double currentMs = 0.0;
+        int currentCalls = 0;
+        ScopeStats stats;
+    };
+
+    Profiler();
+
+    Scope m_scopes[MAX_SCOPES];
+    int m_scopeCount;
+    int m_historyIndex;
+};
+
+// Adds the time between construction and destruction to a profiler scope
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *name) : m_name(name), m_start(std::chrono::steady_clock::now()) {}
+    ~ProfileScope()
+    {
+        Profiler::Get().AddSample(m_name, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_start).count());
+    }
+
+    ProfileScope(const ProfileScope &) = delete;
+    ProfileScope &operator=(const ProfileScope &) = delete;
+
+private:
+    const char *m_name;
+    std::chrono::steady_clock::time_point m_start;
+};
+
+#endif // PROFILER_H
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops. ParallelFor hands out indices
+// dynamically, so uneven work items (e.g. busy and empty screen tiles) balance out.
+// Post queues background tasks on the same workers.
+class ThreadPool
+{
+public:
+    // 0 picks one thread per hardware core, including the calling thread
+    explicit ThreadPool(int threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    // Total threads taking part in ParallelFor, including the caller
+    int GetThreadCount() const { return (int)m_workers.size() + 1; }
+
+    // Runs fn(index) for every index in [0, count) and blocks until all calls returned.
+    // The calling thread participates. Must not be called from inside fn.
+    void ParallelFor(int count, const std::function<void(int)> &fn);
+
+    // Queues task to run on a worker and returns at once. Tasks start in the order they were
+    // posted; a ParallelFor waits for tasks already running. Without workers the task runs
+    // inline. Tasks still queued at destruction run before the workers exit.
+    void Post(std::function<void()> task);
+
+private:
+    void WorkerLoop();
+    void RunItems();
+
+    std::vector<std::thread> m_workers;
+    std::mutex m_callMutex; // Serializes concurrent ParallelFor callers
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+
+    const std::function<void(int)> *m_job;
+    std::deque<std::function<void()>> m_tasks;
+    std::atomic<int> m_nextIndex;
+    int m_count;
+    int m_busyWorkers;
+    uint64_t m_generation;
+    bool m_stop;
+};
+
+#endif // THREAD_POOL_H
\ No newline at end of file
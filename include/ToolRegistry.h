@@ -0,0 +1,85 @@
+#ifndef TOOL_REGISTRY_H
+#define TOOL_REGISTRY_H
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+struct ImTextureData;
+
+// A window of the application. Tools own their state; nothing is kept in function statics.
+class ITool
+{
+public:
+    virtual ~ITool() = default;
+
+    // Called every frame once the tool exists, whether it is open or not
+    virtual void Update() {}
+    // Draws the window; clearing `*open` closes it
+    virtual void Render(bool *open) = 0;
+    // Frees what Render() rebuilds on demand (textures, caches, query results). Returns false
+    // while a release is still in progress, e.g. a texture the renderer has yet to drop; it is
+    // then called again next frame.
+    virtual bool ReleaseResources() { return true; }
+};
+
+// For ReleaseResources(): hands a user texture back to the renderer and, once the renderer has
+// dropped its GPU copy, unregisters and deletes it. Returns true when `texture` is empty; until
+// then call it again on a later frame.
+bool ReleaseToolTexture(std::unique_ptr<ImTextureData> &texture);
+
+struct ToolDescriptor
+{
+    const char *name = nullptr; // Menu label, lookup key and profiler scope; must outlive the registry
+    std::function<std::unique_ptr<ITool>()> create;
+    bool openAtStartup = false;
+    // Closed this long, the tool's resources are released; negative keeps them
+    double releaseAfterSeconds = -1.0;
+};
+
+// Owns the application's tool windows. A tool is registered by descriptor and only
+// constructed, with whatever it allocates, the first time it is opened, so startup cost and
+// resident memory follow the tools actually used rather than the number of tools that exist.
+class ToolRegistry
+{
+public:
+    ToolRegistry() = default;
+    ~ToolRegistry() { Clear(); }
+
+    ToolRegistry(const ToolRegistry &) = delete;
+    ToolRegistry &operator=(const ToolRegistry &) = delete;
+
+    void Register(ToolDescriptor descriptor);
+    // Destroys every tool, in reverse registration order
+    void Clear();
+
+    void SetOpen(const char *name, bool open);
+    bool IsOpen(const char *name) const;
+    // Constructs the tool if needed, e.g. to hand it data before it is first shown
+    ITool *Acquire(const char *name);
+    int GetConstructedCount() const;
+
+    // A checkable menu item per tool, in registration order
+    void RenderMenuItems();
+    void Update();
+    // Renders open tools and releases the resources of tools closed for long enough.
+    // `now` is in seconds.
+    void Render(double now);
+
+private:
+    struct Entry
+    {
+        ToolDescriptor descriptor;
+        std::unique_ptr<ITool> tool;
+        bool open = false;
+        bool holdsResources = false; // Rendered since the last completed release
+        double closedAt = 0.0;
+    };
+
+    Entry *Find(const char *name);
+    const Entry *Find(const char *name) const;
+
+    std::vector<Entry> m_entries;
+};
+
+#endif // TOOL_REGISTRY_H
\ No newline at end of file
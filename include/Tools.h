@@ -0,0 +1,98 @@
+#ifndef TOOLS_H
+#define TOOLS_H
+
+#include "CaptureHistory.h"
+#include "ToolRegistry.h"
+#include "imgui.h"
+#include <cstdint>
+#include <vector>
+
+// Built-in windows, registered with the ToolRegistry by UIManager
+
+class DemoTool : public ITool
+{
+public:
+    explicit DemoTool(const float &averageFrameTimeMs);
+
+    void Render(bool *open) override;
+
+private:
+    const float &m_averageFrameTimeMs; // Kept up to date by UIManager
+    float m_value;
+    int m_counter;
+    ImVec4 m_clearColor;
+    // Text formatting buffers, so drawing allocates no strings
+    char m_counterText[64];
+    char m_frameStats[128];
+};
+
+class SettingsTool : public ITool
+{
+public:
+    SettingsTool();
+
+    void Render(bool *open) override;
+
+private:
+    bool m_vsync;
+    int m_samples;
+};
+
+// Browses the capture history with duplicate and similarity queries. Query results are
+// cached until the selection, the distance or the history changes.
+class HistoryTool : public ITool
+{
+public:
+    explicit HistoryTool(CaptureHistory &history);
+
+    void Render(bool *open) override;
+    bool ReleaseResources() override;
+
+    void SelectCapture(uint32_t id);
+
+private:
+    CaptureHistory &m_history;
+    uint32_t m_selectedCapture;
+    int m_similarDistance;
+    uint64_t m_queriedGeneration;
+    bool m_queryDirty;
+    double m_lastQueryUs;
+    std::vector<CaptureMatch> m_duplicates;
+    std::vector<CaptureMatch> m_similar;
+    std::vector<uint32_t> m_removeIds;
+    char m_label[192]; // Text formatting buffer, so drawing allocates no strings
+};
+
+class MemoryTool : public ITool
+{
+public:
+    MemoryTool();
+
+    // Keeps sampling while closed, so the plot has history when reopened
+    void Update() override;
+    void Render(bool *open) override;
+
+private:
+    // Resident set size in MB, one value per memory tracker sample
+    static constexpr int HISTORY_SIZE = 240;
+    float m_residentHistory[HISTORY_SIZE];
+    int m_residentHistoryIndex;
+    uint64_t m_lastSample;
+    char m_line[160]; // Text formatting buffer, so drawing allocates no strings
+};
+
+// CPU time of the profiler scopes (tools, screen grabs) per frame, with each scope's recent
+// history. The same numbers as the renderer stats overlay, in a window of its own.
+class ProfilerTool : public ITool
+{
+public:
+    ProfilerTool();
+
+    void Render(bool *open) override;
+
+private:
+    int m_selectedScope; // Plotted large below the table; -1 for none
+    char m_line[128];    // Text formatting buffer, so drawing allocates no strings
+};
+
+#endif // TOOLS_H
\ No newline at end of file
@@ -1,7 +1,16 @@
 #ifndef UIMANAGER_H
 #define UIMANAGER_H
 
+#include "CaptureHistory.h"
+#include "MemoryTracker.h"
+#include "ThreadPool.h"
+#include "ToolRegistry.h"
 #include "imgui.h"
+#include "platform/IPlatform.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
 
 class UIManager
 {
@@ -9,19 +18,72 @@ public:
     UIManager();
     ~UIManager();
 
-    void Initialize();
+    void Initialize(Platform::IPlatform *platform);
     void Shutdown();
     void Update();
     void Render();
 
+    // Tool names as shown in the View menu
+    static constexpr const char *TOOL_DEMO = "Demo Window";
+    static constexpr const char *TOOL_SETTINGS = "Settings";
+    static constexpr const char *TOOL_HISTORY = "Capture History";
+    static constexpr const char *TOOL_MEMORY = "Memory";
+    static constexpr const char *TOOL_LOUPE = "Loupe";
+    static constexpr const char *TOOL_EDITOR = "Editor";
+    static constexpr const char *TOOL_PROFILER = "Profiler";
+
+    // Tool visibility, also driven by scripted benchmark scenarios
+    void SetToolOpen(const char *name, bool open) { m_tools.SetOpen(name, open); }
+    const ToolRegistry &GetTools() const { return m_tools; }
+
+    CaptureHistory &GetHistory() { return m_history; }
+    // Grabs every monitor into one image. Saving it as a PNG in the working directory runs in
+    // the background; the capture joins the history on the first Update after its file is
+    // written. Returns false only if the grab failed.
+    bool CaptureDesktop();
+    void SelectCapture(uint32_t id);
+
 private:
+    // A grabbed desktop on its way to disk; filled in by the save pool
+    struct SavedCapture
+    {
+        std::string path;
+        Imaging::Image image; // Handed back so the next capture can reuse the buffer
+        uint64_t canvasEvictions = 0; // m_canvasEvictions when the capture was taken
+        size_t outputCount = 0;
+        double captureMs = 0.0;
+        double saveMs = 0.0;
+        uint64_t dHash = 0;
+        uint64_t pHash = 0;
+        int64_t timestamp = 0;
+        bool saved = false;
+    };
+
+    void RegisterTools();
     void RenderMainMenuBar();
-    void RenderDemoWindow();
-    void RenderSettingsWindow();
+    // Runs on the save pool
+    void SaveCapture(SavedCapture capture);
+    // Adds finished saves to the history, on the UI thread
+    void CollectSavedCaptures();
 
-    // UI state
-    bool m_showDemo;
-    bool m_showSettings;
+    Platform::IPlatform *m_platform; // Not owned
+    ToolRegistry m_tools;
+
+    // Shared with the tools; outlives them
+    CaptureHistory m_history;
+    ScopedMemorySource m_historyMemory;
+
+    // Reused by every desktop capture, so repeated captures do not reallocate
+    Imaging::Image m_desktopCanvas;
+    std::vector<Platform::DesktopOutput> m_desktopOutputs;
+    ScopedMemorySource m_canvasMemory;
+    std::atomic<size_t> m_savingBytes; // Canvases still being encoded
+    uint64_t m_canvasEvictions;        // Saves started before an eviction drop their canvas
+    int64_t m_lastCaptureMs;           // Wall clock of the last capture, to number same-millisecond names
+    int m_captureSequence;
+
+    std::mutex m_savedMutex;
+    std::vector<SavedCapture> m_savedCaptures; // Guarded by m_savedMutex
 
     // Performance tracking to avoid string allocations
     static constexpr int FRAME_HISTORY_SIZE = 120;
@@ -31,6 +93,10 @@ private:
 
     // Cached strings to avoid repeated allocations
     void UpdateFrameStats();
+
+    // One worker, so captures are written in the order they were taken. Declared last: its
+    // destructor finishes queued saves while the members they use still exist.
+    ThreadPool m_savePool;
 };
 
 #endif // UIMANAGER_H
\ No newline at end of file
@@ -0,0 +1,26 @@
+#ifndef DEFLATE_H
+#define DEFLATE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Imaging
+{
+
+    // zlib-wrapped deflate streams (RFC 1950/1951), as used by PNG IDAT data. A thin layer
+    // over the zlib library, so the rest of the codec works on std::vector and size_t.
+
+    // Appends the compressed stream to `out`. Level 0 stores, 1-9 trade speed for size.
+    void ZlibCompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out, int level = 6);
+
+    // Replaces `out` with the decompressed stream. Fails on corrupt input, a bad checksum,
+    // or output growing past `maxSize` (when non-zero), which guards against zip bombs.
+    bool ZlibDecompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out, size_t maxSize = 0);
+
+    uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t size);
+    uint32_t Adler32(uint32_t adler, const uint8_t *data, size_t size);
+
+} // namespace Imaging
+
+#endif // DEFLATE_H
\ No newline at end of file
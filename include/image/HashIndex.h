@@ -0,0 +1,65 @@
+#ifndef HASH_INDEX_H
+#define HASH_INDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Imaging
+{
+
+    // Multi-index hash table for Hamming-distance search over 64-bit perceptual hashes.
+    // Hashes are split into four 16-bit chunks, each with its own bucket table. Any hash within
+    // distance r of the query matches it on at least one chunk within r / 4 bits (pigeonhole),
+    // so a query probes only those chunk neighbourhoods and verifies candidates with a popcount
+    // instead of comparing against every entry.
+    class HashIndex
+    {
+    public:
+        struct Match
+        {
+            uint32_t id;
+            int distance;
+        };
+
+        HashIndex();
+
+        void Insert(uint32_t id, uint64_t hash);
+        bool Remove(uint32_t id);
+        void Clear();
+        size_t Size() const { return m_entries.size() - m_removedCount; }
+        size_t GetMemoryBytes() const;
+
+        // Replaces `out` with every entry within maxDistance bits of `hash`, nearest first
+        void Query(uint64_t hash, int maxDistance, std::vector<Match> &out) const;
+
+    private:
+        static constexpr int CHUNKS = 4;
+        static constexpr int CHUNK_BITS = 16;
+        static constexpr uint32_t BUCKETS = 1u << CHUNK_BITS;
+        static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+        struct Entry
+        {
+            uint64_t hash;
+            uint32_t id;
+            uint32_t next[CHUNKS]; // Bucket chains, one per chunk table
+            bool removed;
+        };
+
+        static uint32_t Chunk(uint64_t hash, int chunk) { return (uint32_t)(hash >> (chunk * CHUNK_BITS)) & (BUCKETS - 1); }
+        void Link(uint32_t index);
+        void Compact();
+        void ProbeBucket(uint32_t bucket, int chunk, uint64_t hash, int maxDistance, int chunkRadius, std::vector<Match> &out) const;
+        void ProbeNeighbours(uint32_t key, int firstBit, int flipsLeft, int chunk, uint64_t hash, int maxDistance, int chunkRadius, std::vector<Match> &out) const;
+
+        std::vector<uint32_t> m_heads; // CHUNKS tables of BUCKETS chain heads
+        std::vector<Entry> m_entries;
+        std::unordered_map<uint32_t, uint32_t> m_entryById;
+        size_t m_removedCount;
+    };
+
+} // namespace Imaging
+
+#endif // HASH_INDEX_H
\ No newline at end of file
@@ -0,0 +1,33 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Imaging
+{
+
+    // 8-bit sRGB RGBA pixels with R in the lowest byte, the same layout as ImGui's RGBA32
+    // textures and the software renderer. Rows are tightly packed.
+    struct Image
+    {
+        int width = 0;
+        int height = 0;
+        std::vector<uint32_t> pixels;
+
+        void Allocate(int w, int h)
+        {
+            width = w;
+            height = h;
+            pixels.resize((size_t)w * h);
+        }
+
+        bool IsEmpty() const { return width <= 0 || height <= 0; }
+        uint32_t *Row(int y) { return pixels.data() + (size_t)y * width; }
+        const uint32_t *Row(int y) const { return pixels.data() + (size_t)y * width; }
+    };
+
+} // namespace Imaging
+
+#endif // IMAGE_H
\ No newline at end of file
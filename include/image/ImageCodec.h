@@ -0,0 +1,60 @@
+#ifndef IMAGE_CODEC_H
+#define IMAGE_CODEC_H
+
+#include "image/Image.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Imaging
+{
+
+    enum class ImageFormat
+    {
+        Unknown,
+        Png,
+        Bmp,
+        Tga,
+        Ppm
+    };
+
+    const char *GetFormatExtension(ImageFormat format);
+
+    // "png", "bmp", "tga", "ppm" (also "pnm"), case-insensitive
+    ImageFormat FormatFromName(const std::string &name);
+
+    // Looks at the file extension only
+    ImageFormat FormatFromPath(const std::string &path);
+
+    // A PNG ancillary chunk carried over from the source file
+    struct MetadataChunk
+    {
+        char type[5];
+        std::vector<uint8_t> data;
+    };
+
+    struct ImageFile
+    {
+        Image image;
+        ImageFormat format = ImageFormat::Unknown;
+        std::vector<MetadataChunk> metadata;
+    };
+
+    // Decodes PNG (all color types and bit depths, interlaced or not; 16-bit samples are
+    // reduced to 8), BMP (8/24/32-bit), TGA (true color and grayscale, RLE or raw) and binary
+    // PPM/PGM. The format is detected from the data, not the file name. PNG text, EXIF, time
+    // and other copy-safe chunks plus color space chunks are kept in `file.metadata`.
+    bool DecodeImage(const uint8_t *data, size_t size, ImageFile &file, std::string &error);
+
+    // Encodes into `format`. Metadata is only written to PNG; opaque images are stored
+    // without an alpha channel where the format allows it.
+    bool EncodeImage(const ImageFile &file, ImageFormat format, std::vector<uint8_t> &out, int compressionLevel = 6);
+
+    // Drops everything but color space information (iCCP, sRGB, gAMA, cHRM), i.e. text,
+    // EXIF (which may hold location and device data), timestamps and private chunks
+    void StripMetadata(ImageFile &file);
+
+} // namespace Imaging
+
+#endif // IMAGE_CODEC_H
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef PERCEPTUAL_HASH_H
+#define PERCEPTUAL_HASH_H
+
+#include "image/Image.h"
+#include <bit>
+#include <cstdint>
+
+namespace Imaging
+{
+
+    // 64-bit perceptual hashes: visually similar images differ in few bits, so similarity is
+    // the Hamming distance between hashes. Both work on a small grayscale reduction and ignore
+    // resolution, mild recompression and small edits like a moved cursor.
+
+    // Difference hash: 9x8 grayscale, one bit per horizontally adjacent pair being brighter.
+    // Very cheap and good at catching exact and near-exact duplicates.
+    uint64_t ComputeDHash(const Image &image);
+
+    // DCT hash: 32x32 grayscale, low 8x8 DCT coefficients compared against their median.
+    // More robust to scaling and brightness changes, used for "similar" queries.
+    uint64_t ComputePHash(const Image &image);
+
+    inline int HammingDistance(uint64_t a, uint64_t b) { return std::popcount(a ^ b); }
+
+} // namespace Imaging
+
+#endif // PERCEPTUAL_HASH_H
\ No newline at end of file
@@ -0,0 +1,32 @@
+#ifndef REDACT_H
+#define REDACT_H
+
+#include "image/Image.h"
+#include <cstdint>
+
+namespace Imaging
+{
+
+    enum class RedactMode
+    {
+        Fill,    // Solid color
+        Pixelate // Coarse blocks of the averaged content
+    };
+
+    // Pixel rectangle to hide; parts outside the image are ignored
+    struct RedactRegion
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+        RedactMode mode = RedactMode::Fill;
+        uint32_t color = 0xFF000000; // RGBA, R in the lowest byte
+        int blockSize = 16;          // Pixelate cell size
+    };
+
+    void Redact(Image &image, const RedactRegion &region);
+
+} // namespace Imaging
+
+#endif // REDACT_H
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef RESAMPLER_H
+#define RESAMPLER_H
+
+#include "ThreadPool.h"
+#include "image/Image.h"
+#include <vector>
+
+namespace Imaging
+{
+
+    enum class ResampleFilter
+    {
+        Box,      // Area average, fastest, soft
+        Mitchell, // Cubic B=C=1/3, little ringing
+        Lanczos3  // Sharpest, slight halos on hard edges
+    };
+
+    const char *GetFilterName(ResampleFilter filter);
+
+    // Separable image scaler. Pixels are converted to premultiplied linear light, filtered
+    // horizontally then vertically, and converted back to sRGB. Kernel weights are computed
+    // once per (source size, target size, filter) and reused across calls. The target is split
+    // into bands of rows processed in parallel; each band filters only the source rows it needs,
+    // so the intermediate buffer stays small and in cache.
+    class Resampler
+    {
+    public:
+        explicit Resampler(int threadCount = 0);
+
+        // Scales src into dst, which is reallocated to width x height
+        bool Resample(const Image &src, Image &dst, int width, int height, ResampleFilter filter);
+
+        // Scales down to fit within maxWidth x maxHeight keeping the aspect ratio; never upscales
+        bool ResampleToFit(const Image &src, Image &dst, int maxWidth, int maxHeight, ResampleFilter filter);
+
+    private:
+        // For target pixel i: weights[i * stride .. + count[i]] apply to source pixels start[i]..
+        struct WeightTable
+        {
+            int srcSize = 0;
+            int dstSize = 0;
+            ResampleFilter filter = ResampleFilter::Box;
+            int stride = 0;
+            std::vector<int> start;
+            std::vector<int> count;
+            std::vector<float> weights;
+        };
+
+        static void BuildWeights(WeightTable &table, int srcSize, int dstSize, ResampleFilter filter);
+        void ResampleBand(const Image &src, Image &dst, int y0, int y1);
+
+        ThreadPool m_pool;
+        WeightTable m_horizontal;
+        WeightTable m_vertical;
+    };
+
+} // namespace Imaging
+
+#endif // RESAMPLER_H
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef UNDO_HISTORY_H
+#define UNDO_HISTORY_H
+
+#include "image/Image.h"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <vector>
+
+namespace Imaging
+{
+
+    // Undo/redo for in-place image edits, stored as copy-on-write 64x64 tile deltas. An edit
+    // saves a tile the first time it is touched and, when it ends, the new contents of the
+    // same tiles, so a step costs memory for what it changed rather than for the whole image,
+    // and undo/redo only decode the tiles of that step. Tiles are compressed with a small
+    // pixel codec (runs of the previous pixel or the pixel above, plus literals), which
+    // shrinks flat UI content several times over without the cost of a general LZ search.
+    // Once the total exceeds the memory limit the oldest steps are dropped; the newest step
+    // is always kept.
+    //
+    //     history.BeginEdit(image, "Redact");
+    //     history.Touch(region.x, region.y, region.width, region.height);
+    //     Redact(image, region);
+    //     history.EndEdit(image);
+    //
+    // Edits that change the image size (crop, resize) call TouchAll() before modifying it.
+    class UndoHistory
+    {
+    public:
+        static constexpr int TILE_SIZE = 64;
+        static constexpr size_t DEFAULT_MEMORY_LIMIT = 256u * 1024 * 1024;
+
+        explicit UndoHistory(size_t memoryLimit = DEFAULT_MEMORY_LIMIT);
+
+        // Starts recording an edit of `image`, which must not change until it is touched
+        void BeginEdit(const Image &image, const std::string &label);
+        // Saves the tiles overlapping the rectangle that this edit has not saved yet
+        void Touch(int x, int y, int width, int height);
+        void TouchAll();
+        // Stores the edited contents of the touched tiles as a new step, replacing the redo
+        // steps. Returns false, and records nothing, if the image size changed without TouchAll().
+        bool EndEdit(const Image &image);
+        bool IsEditing() const { return m_editing; }
+
+        bool CanUndo() const { return m_cursor > 0; }
+        bool CanRedo() const { return m_cursor < m_steps.size(); }
+        const std::string &GetUndoLabel() const;
+        const std::string &GetRedoLabel() const;
+
+        // Both expect `image` in the state the history left it in, and fail otherwise
+        bool Undo(Image &image);
+        bool Redo(Image &image);
+
+        void Clear();
+        void SetMemoryLimit(size_t bytes);
+        size_t GetMemoryLimit() const { return m_memoryLimit; }
+        size_t GetMemoryBytes() const { return m_memoryBytes; }
+        size_t GetStepCount() const { return m_steps.size(); }
+
+        // Drops the oldest steps until at most `targetBytes` remain, for memory pressure.
+        // Returns the number of bytes released.
+        size_t Trim(size_t targetBytes);
+
+    private:
+        struct TileRef
+        {
+            uint32_t index;  // Row-major tile index in that state's tile grid
+            uint32_t offset; // Into Step::data
+            uint32_t size;
+        };
+
+        struct Step
+        {
+            std::string label;
+            int beforeWidth = 0;
+            int beforeHeight = 0;
+            int afterWidth = 0;
+            int afterHeight = 0;
+            std::vector<TileRef> before;
+            std::vector<TileRef> after;
+            std::vector<uint8_t> data;
+        };
+
+        static int TilesAcross(int size) { return (size + TILE_SIZE - 1) / TILE_SIZE; }
+        static void SaveTile(const Image &image, uint32_t index, std::vector<TileRef> &refs, std::vector<uint8_t> &data);
+        static bool RestoreTiles(Image &image, int width, int height, const std::vector<TileRef> &refs, const std::vector<uint8_t> &data);
+        static size_t StepBytes(const Step &step) { return step.data.capacity() + (step.before.capacity() + step.after.capacity()) * sizeof(TileRef); }
+        void DropOldest();
+
+        std::deque<Step> m_steps;
+        size_t m_cursor; // Steps before the cursor can be undone, the rest redone
+        size_t m_memoryLimit;
+        size_t m_memoryBytes;
+
+        // Edit in progress. A tile is saved when its stamp equals the edit serial, so starting
+        // an edit does not have to clear a flag per tile.
+        const Image *m_editImage;
+        Step m_pending;
+        std::vector<uint32_t> m_tileStamps;
+        uint32_t m_editSerial;
+        bool m_editing;
+        bool m_touchedAll;
+    };
+
+} // namespace Imaging
+
+#endif // UNDO_HISTORY_H
\ No newline at end of file
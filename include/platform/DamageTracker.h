@@ -0,0 +1,71 @@
+#ifndef DAMAGE_TRACKER_H
+#define DAMAGE_TRACKER_H
+
+#include "imgui.h"
+#include <cstdint>
+#include <vector>
+
+namespace Platform
+{
+
+    // Framebuffer rectangle with a bottom-left origin, as expected by glScissor and EGL damage rects
+    struct FramebufferRect
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
+    // Finds the screen region that changed between frames by diffing ImDrawData commands.
+    // Every command is reduced to a signature (hash of its vertices, texture, clip rect and
+    // position in the draw order) plus its screen bounds; commands present in only one of
+    // two consecutive frames contribute their bounds to that frame's damage. A short
+    // history is kept so a back buffer that is several frames old can be brought up to date.
+    class DamageTracker
+    {
+    public:
+        static constexpr int MAX_BUFFER_AGE = 4;
+
+        DamageTracker();
+
+        // Call once per frame after ImGui::Render(), before the draw data is rendered
+        void Update(const ImDrawData *drawData);
+
+        // Forces the next frames to redraw everything, e.g. after the clear color changed
+        void Invalidate();
+
+        // Region, in draw data coordinates, that must be redrawn into a back buffer that was
+        // last presented `bufferAge` frames ago. Returns false when a full redraw is required.
+        bool GetDamage(int bufferAge, ImVec4 &damage) const;
+
+        // Restricts every command's clip rect to the damaged region so the backend only
+        // touches pixels inside it; commands entirely outside end up with an empty clip rect
+        static void ClipDrawData(ImDrawData *drawData, const ImVec4 &damage);
+
+        static FramebufferRect ToFramebufferRect(const ImDrawData *drawData, const ImVec4 &rect);
+
+    private:
+        struct CommandSignature
+        {
+            uint64_t hash;
+            ImVec4 bounds;
+        };
+
+        void BuildSignatures(const ImDrawData *drawData, std::vector<CommandSignature> &out) const;
+
+        std::vector<CommandSignature> m_previous;
+        std::vector<CommandSignature> m_current;
+        std::vector<ImTextureData *> m_updatedTextures;
+
+        ImVec4 m_history[MAX_BUFFER_AGE]; // Damage of the most recent frames, newest first
+        bool m_historyFull[MAX_BUFFER_AGE];
+        int m_historyCount;
+        ImVec2 m_displayPos;
+        ImVec2 m_displaySize;
+        ImVec2 m_framebufferScale;
+    };
+
+} // namespace Platform
+
+#endif // DAMAGE_TRACKER_H
\ No newline at end of file
@@ -0,0 +1,50 @@
+#ifndef DPI_SCALER_H
+#define DPI_SCALER_H
+
+#include "imgui.h"
+
+namespace Platform
+{
+
+    // Owns the ImGui style's DPI scale. The unscaled style is kept as a base and every scale
+    // is derived from it, so switching back and forth between monitors never accumulates
+    // rounding. A new scale does not take effect immediately: the glyphs the UI needs at
+    // the new font size are rasterized a slice per frame first, then the style switches in
+    // one frame, so moving a window to another monitor does not stall on a full glyph bake.
+    class DpiScaler
+    {
+    public:
+        DpiScaler();
+
+        // Captures the current style as the unscaled base and applies `scale` right away.
+        // Call once, after the style colors are set up.
+        void Initialize(float scale);
+
+        // Starts switching to a new scale, e.g. on SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED
+        void RequestScale(float scale);
+
+        // Call before ImGui::NewFrame(); applies the pending scale once its glyphs are ready
+        void BeginFrame();
+        // Call after ImGui::NewFrame(); rasterizes the next slice of pending glyphs
+        void Prewarm();
+
+        float GetScale() const { return m_scale; }
+        float GetTargetScale() const { return m_targetScale; }
+        bool IsSwitching() const { return m_targetScale != m_scale; }
+        const ImGuiStyle &GetBaseStyle() const { return m_baseStyle; }
+
+    private:
+        void ApplyStyle(float scale);
+
+        ImGuiStyle m_baseStyle;
+        float m_scale;
+        float m_targetScale;
+
+        // Prewarm cursor: font index in the atlas and next code point
+        int m_prewarmFont;
+        unsigned int m_prewarmCodepoint;
+    };
+
+} // namespace Platform
+
+#endif // DPI_SCALER_H
\ No newline at end of file
@@ -0,0 +1,39 @@
+#ifndef EGL_DAMAGE_SWAP_H
+#define EGL_DAMAGE_SWAP_H
+
+#include "DamageTracker.h"
+#include <SDL3/SDL.h>
+
+namespace Platform
+{
+
+    // Optional EGL presentation path for partial redraws. Uses EGL_EXT_buffer_age to learn how
+    // stale the back buffer is and eglSwapBuffersWithDamage to tell the compositor which region
+    // changed. When SDL is not running on EGL (e.g. GLX) every query reports "unknown" and the
+    // caller falls back to a full redraw and a regular swap.
+    class EGLDamageSwap
+    {
+    public:
+        EGLDamageSwap();
+
+        // Requires the window's GL context to be current
+        bool Initialize(SDL_Window *window);
+        bool IsBufferAgeSupported() const { return m_bufferAgeSupported; }
+
+        // Number of frames since the current back buffer was presented; 0 means undefined contents
+        int QueryBufferAge() const;
+
+        // Presents the frame; `damage` may be null to mark the whole surface as damaged
+        void Swap(const FramebufferRect *damage);
+
+    private:
+        SDL_Window *m_window;
+        void *m_display;
+        void *m_surface;
+        bool m_bufferAgeSupported;
+        bool m_swapWithDamageSupported;
+    };
+
+} // namespace Platform
+
+#endif // EGL_DAMAGE_SWAP_H
\ No newline at end of file
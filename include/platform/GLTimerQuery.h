@@ -0,0 +1,38 @@
+#ifndef GL_TIMER_QUERY_H
+#define GL_TIMER_QUERY_H
+
+namespace Platform
+{
+
+    // Measures GPU time per frame with GL_TIME_ELAPSED queries. Queries are kept in a small
+    // ring and results are only read once GL reports them available, so the CPU never stalls
+    // waiting for the GPU; the reported time therefore lags a couple of frames behind.
+    class GLTimerQuery
+    {
+    public:
+        GLTimerQuery();
+        ~GLTimerQuery();
+
+        // Requires a current GL context; returns false when timer queries are unsupported
+        bool Initialize();
+        void Shutdown();
+        bool IsSupported() const { return m_supported; }
+
+        void BeginFrame();
+        void EndFrame();
+
+        // Returns true and writes the most recent completed measurement, if any
+        bool ReadLatest(double &milliseconds);
+
+    private:
+        static constexpr int QUERY_COUNT = 3;
+        unsigned int m_queries[QUERY_COUNT];
+        bool m_pending[QUERY_COUNT];
+        int m_writeIndex;
+        bool m_active;
+        bool m_supported;
+    };
+
+} // namespace Platform
+
+#endif // GL_TIMER_QUERY_H
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef HEADLESS_PLATFORM_H
+#define HEADLESS_PLATFORM_H
+
+#include "DpiScaler.h"
+#include "IPlatform.h"
+#include "RenderStats.h"
+#include "SoftwareRenderer.h"
+#include "imgui.h"
+#include <functional>
+#include <memory>
+
+namespace Platform
+{
+
+    // Platform without a window or GPU. ImGui runs with a fixed display size and delta time,
+    // texture requests are acknowledged without uploading anything and the draw data is only
+    // inspected for statistics, unless the software renderer is enabled to produce pixels.
+    // Used by benchmarks and other scripted runs.
+    class HeadlessPlatform : public IPlatform
+    {
+    public:
+        // Size of the synthetic desktop served to screen tools
+        static constexpr int DESKTOP_WIDTH = 3840;
+        static constexpr int DESKTOP_HEIGHT = 2160;
+
+        HeadlessPlatform();
+        ~HeadlessPlatform() override;
+
+        // Window management
+        bool Initialize(const WindowConfig &config) override;
+        void Shutdown() override;
+        bool ShouldClose() override;
+        void PollEvents() override;
+        void SetWindowTitle(const std::string &title) override;
+        void GetWindowSize(int &width, int &height) override;
+        void SetWindowSize(int width, int height) override;
+
+        // Renderer management
+        bool InitializeRenderer() override;
+        void NewFrame() override;
+        void RenderFrame() override;
+        void SetClearColor(ImVec4 &color) override;
+        RendererType GetRendererType() const override { return RendererType::Headless; }
+
+        // ImGui integration
+        bool InitializeImGui() override;
+
+        // Platform-specific getters
+        void *GetNativeWindow() override;
+        void *GetNativeRenderer() override;
+
+        // Desktop access, backed by a synthetic desktop so screen tools can be scripted
+        bool GetGlobalMousePosition(int &x, int &y) override;
+        bool GrabScreenRegion(int x, int y, int width, int height, Imaging::Image &out) override;
+        bool CaptureDesktop(Imaging::Image &out, std::vector<DesktopOutput> &outputs) override;
+
+        // Headless controls
+        void SetDeltaTime(float seconds) { m_deltaTime = seconds; }
+        void RequestClose() { m_shouldClose = true; }
+        // Simulates the window moving to a display with a different content scale
+        void SetDisplayScale(float scale) { m_dpiScaler.RequestScale(scale); }
+        void SetGlobalMousePosition(int x, int y)
+        {
+            m_globalMouseX = x;
+            m_globalMouseY = y;
+        }
+        const DpiScaler &GetDpiScaler() const { return m_dpiScaler; }
+        const RenderStats &GetRenderStats() const { return m_renderStats; }
+
+        // Rasterize every frame on the CPU; must be called before the first frame
+        void EnableSoftwareRenderer(int threadCount = 0);
+        const SoftwareRenderer *GetSoftwareRenderer() const { return m_softwareRenderer.get(); }
+        bool SaveSnapshot(const std::string &path) const;
+
+        // Called inside RenderFrame() before ImGui::Render(), to submit extra scripted content
+        void SetFrameCallback(std::function<void()> callback) { m_frameCallback = std::move(callback); }
+
+    private:
+        void UpdateTextures(ImDrawData *drawData);
+
+        WindowConfig m_config;
+        int m_width;
+        int m_height;
+        float m_deltaTime;
+        ImVec4 m_clearColor;
+        bool m_shouldClose;
+        int m_globalMouseX;
+        int m_globalMouseY;
+
+        ImGuiContext *m_imguiContext;
+        DpiScaler m_dpiScaler;
+        RenderStats m_renderStats;
+        std::function<void()> m_frameCallback;
+        std::unique_ptr<SoftwareRenderer> m_softwareRenderer;
+    };
+
+} // namespace Platform
+
+#endif // HEADLESS_PLATFORM_H
\ No newline at end of file
@@ -1,9 +1,11 @@
 #ifndef IPLATFORM_H
 #define IPLATFORM_H
 
+#include "image/Image.h"
 #include "imgui.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 // Forward declarations
 struct ImGuiContext;
@@ -16,7 +18,9 @@ namespace Platform
     {
         OpenGL3,
         DirectX11,
-        Metal
+        Metal,
+        Headless,
+        Software
     };
 
     struct WindowConfig
@@ -28,6 +32,16 @@ namespace Platform
         bool vsync = true;
     };
 
+    // One monitor's area within a whole-desktop capture, in capture pixels. Monitors are copied
+    // at their native resolution; with mixed scale factors they keep their own pixel density.
+    struct DesktopOutput
+    {
+        int x = 0;
+        int y = 0;
+        int width = 0;
+        int height = 0;
+    };
+
     class IPlatform
     {
     public:
@@ -55,6 +69,21 @@ namespace Platform
         // Platform-specific getters
         virtual void *GetNativeWindow() = 0;
         virtual void *GetNativeRenderer() = 0;
+
+        // Input record/replay; platforms without support keep these defaults
+        virtual bool StartInputRecording(const std::string &) { return false; }
+        virtual bool StartInputReplay(const std::string &, float) { return false; }
+
+        // Desktop access for screen tools, in desktop pixel coordinates spanning all monitors;
+        // platforms without support keep these defaults
+        virtual bool GetGlobalMousePosition(int &, int &) { return false; }
+        // Copies a desktop rectangle into `out`, which is only reallocated when its size
+        // changes. Parts outside the desktop come back black.
+        virtual bool GrabScreenRegion(int, int, int, int, Imaging::Image &) { return false; }
+        // Copies every monitor into one canvas covering the bounding box of the desktop; gaps
+        // between monitors of different sizes are black. `out` is only reallocated when the
+        // desktop size changes.
+        virtual bool CaptureDesktop(Imaging::Image &, std::vector<DesktopOutput> &) { return false; }
     };
 
     // Factory function
@@ -0,0 +1,76 @@
+#ifndef INPUT_RECORDER_H
+#define INPUT_RECORDER_H
+
+#include <SDL3/SDL.h>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Platform
+{
+
+    // Binary input log layout: a header (magic, format version, SDL version) followed by one
+    // record per event. Each record stores varint-encoded deltas for the frame number and the
+    // SDL timestamp, the event type, and the type-specific part of the event struct (the
+    // common type/timestamp header is not repeated). Text events store their string inline.
+    // A record with type 0 terminates the log and carries the total frame count.
+
+    class InputRecorder
+    {
+    public:
+        InputRecorder();
+        ~InputRecorder();
+
+        bool Open(const std::string &path);
+        void Close();
+        bool IsOpen() const { return m_file.is_open(); }
+
+        // Events of types that do not affect the UI (e.g. gamepad polling state) are skipped
+        void Record(const SDL_Event &event, uint64_t frame);
+        void EndFrame(uint64_t frame) { m_lastFrame = frame; }
+
+    private:
+        void WriteVarint(uint64_t value);
+
+        std::ofstream m_file;
+        uint64_t m_previousFrame;
+        uint64_t m_previousTimestamp;
+        uint64_t m_lastFrame;
+        uint64_t m_eventCount;
+    };
+
+    class InputReplayer
+    {
+    public:
+        InputReplayer();
+
+        bool Open(const std::string &path);
+        bool IsActive() const { return m_active; }
+        bool IsFinished(uint64_t frame) const;
+
+        // Returns the next recorded event for `frame`, or false once that frame's events are exhausted.
+        // Window IDs are rewritten to `windowID` so the events target the replaying window.
+        bool Next(uint64_t frame, SDL_WindowID windowID, SDL_Event &event);
+
+        // Last mouse position seen in the log, used to override the live cursor while replaying
+        bool GetMousePosition(float &x, float &y) const;
+
+    private:
+        bool ReadVarint(uint64_t &value);
+
+        std::vector<uint8_t> m_data;
+        size_t m_cursor;
+        uint64_t m_recordFrame;
+        uint64_t m_recordTimestamp;
+        uint64_t m_totalFrames;
+        std::string m_text; // Backing storage for the current text input event
+        float m_mouseX;
+        float m_mouseY;
+        bool m_hasMouse;
+        bool m_active;
+    };
+
+} // namespace Platform
+
+#endif // INPUT_RECORDER_H
\ No newline at end of file
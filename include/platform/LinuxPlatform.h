@@ -1,9 +1,20 @@
 #ifndef UNIX_PLATFORM_H
 #define UNIX_PLATFORM_H
 
+#include "DamageTracker.h"
+#include "DpiScaler.h"
+#include "EGLDamageSwap.h"
+#include "GLTimerQuery.h"
 #include "IPlatform.h"
+#include "InputRecorder.h"
+#include "MemoryTracker.h"
+#include "RenderStats.h"
+#include "SoftwareRenderer.h"
+#include "X11DesktopCapture.h"
+#include "X11ScreenGrabber.h"
 #include "imgui.h"
 #include <SDL3/SDL.h>
+#include <memory>
 
 namespace Platform
 {
@@ -28,7 +39,7 @@ namespace Platform
         void NewFrame() override;
         void RenderFrame() override;
         void SetClearColor(ImVec4 &color) override;
-        RendererType GetRendererType() const override { return RendererType::OpenGL3; }
+        RendererType GetRendererType() const override { return m_softwareRenderer ? RendererType::Software : RendererType::OpenGL3; }
 
         // ImGui integration
         bool InitializeImGui() override;
@@ -37,17 +48,61 @@ namespace Platform
         void *GetNativeWindow() override;
         void *GetNativeRenderer() override;
 
+        // Input record/replay
+        bool StartInputRecording(const std::string &path) override;
+        bool StartInputReplay(const std::string &path, float fixedDeltaTime) override;
+
+        // Desktop access for screen tools
+        bool GetGlobalMousePosition(int &x, int &y) override;
+        bool GrabScreenRegion(int x, int y, int width, int height, Imaging::Image &out) override;
+        bool CaptureDesktop(Imaging::Image &out, std::vector<DesktopOutput> &outputs) override;
+
     private:
+        void UploadTextures(ImDrawData *drawData);
+        void PresentSoftwareFrame(ImDrawData *drawData, const ImVec4 *damage);
+        void RegisterMemorySources();
+
         SDL_Window *m_window;
         SDL_GLContext m_glContext;
         WindowConfig m_config;
 
         ImGuiContext *m_imguiContext;
         ImGuiIO *m_io;
-        ImGuiStyle *m_style;
         ImVec4 m_clearColor;
         bool m_shouldClose;
         char *m_glslVersion;
+
+        // Style scale, follows the display the window is on
+        DpiScaler m_dpiScaler;
+
+        // Renderer stats overlay, toggled with F3
+        GLTimerQuery m_gpuTimer;
+        RenderStats m_renderStats;
+        bool m_showRenderStats;
+
+        // Partial redraw of the damaged region when the back buffer age is known
+        DamageTracker m_damageTracker;
+        EGLDamageSwap m_damageSwap;
+
+        // Deterministic input record/replay, keyed by the number of PollEvents() calls
+        uint64_t m_frameIndex;
+        InputRecorder m_recorder;
+        InputReplayer m_replayer;
+        float m_replayDeltaTime;
+
+        // CPU rendering into the window surface, used when OpenGL is unavailable or when
+        // SNAP_TOOLS_SOFTWARE_RENDERER is set
+        std::unique_ptr<SoftwareRenderer> m_softwareRenderer;
+
+        // Root window grabs over a separate X connection, opened on first use
+        X11ScreenGrabber m_screenGrabber;
+        // Whole-desktop captures, one connection and worker per monitor
+        X11DesktopCapture m_desktopCapture;
+
+        // Renderer memory reported to the memory tracker
+        ScopedMemorySource m_textureMemory;
+        ScopedMemorySource m_bufferMemory;
+        ScopedMemorySource m_softwareMemory;
     };
 
 } // namespace Platform
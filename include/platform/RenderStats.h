@@ -0,0 +1,100 @@
+#ifndef RENDER_STATS_H
+#define RENDER_STATS_H
+
+#include "imgui.h"
+#include <chrono>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace Platform
+{
+
+    // Counters for a single ImDrawList, which maps to one ImGui window
+    struct DrawListStats
+    {
+        char owner[48] = {};
+        int drawCalls = 0;
+        int vertices = 0;
+        int indices = 0;
+        int textureBinds = 0;
+        size_t uploadBytes = 0;
+    };
+
+    // One texture created or updated by the renderer this frame
+    struct TextureUploadStats
+    {
+        int textureId = 0; // ImTextureData::UniqueID
+        size_t bytes = 0;
+        double ms = 0.0; // CPU time of the backend's upload calls, negative if not measured
+    };
+
+    struct FrameRenderStats
+    {
+        int drawCalls = 0;
+        int vertices = 0;
+        int indices = 0;
+        int textureBinds = 0;
+        size_t geometryUploadBytes = 0;
+        size_t textureUploadBytes = 0;
+        double textureUploadMs = 0.0;
+        double cpuTimeMs = 0.0;      // NewFrame() until the frame is handed to the GPU, swap excluded
+        double frameIntervalMs = 0.0; // Wall time between frames, which vsync pads up to the refresh period
+        double gpuTimeMs = -1.0;     // Negative until a timer query result is available
+        std::vector<DrawListStats> lists;
+        std::vector<TextureUploadStats> textureUploads;
+    };
+
+    // Collects per-frame draw/upload counters from ImDrawData and shows them in an overlay.
+    // Collect() must run before the renderer backend consumes the draw data, because the
+    // backend resets texture upload requests once they are processed. It also follows texture
+    // create/destroy requests to account for the GPU memory the backend holds on our behalf.
+    class RenderStats
+    {
+    public:
+        RenderStats();
+
+        // Bracket the CPU work of a frame: Begin at the start of NewFrame(), End once the draw
+        // data is submitted and before the buffer swap, which blocks under vsync and would
+        // make every frame look CPU-bound
+        void BeginCpuFrame();
+        void EndCpuFrame();
+
+        void Collect(const ImDrawData *drawData);
+        // Time the backend spent uploading one texture collected this frame; backends that
+        // upload inside their draw call leave it unmeasured
+        void SetTextureUploadTime(int textureId, double milliseconds);
+        void SetGpuTime(double milliseconds);
+        const FrameRenderStats &GetLastFrame() const { return m_frame; }
+
+        // Bytes of live textures created through ImGui's texture requests
+        size_t GetTextureBytes() const { return m_textureBytes; }
+        // The backend streams geometry through one vertex and index buffer, which the driver
+        // keeps sized for the largest draw list uploaded so far
+        size_t GetBufferBytes() const { return m_bufferBytes; }
+
+        // Must be called between ImGui::NewFrame() and ImGui::Render()
+        void DrawOverlay(bool *open);
+
+    private:
+        void TrackTexture(int id, size_t bytes);
+
+        FrameRenderStats m_frame;
+        int m_listCount;
+        std::chrono::steady_clock::time_point m_cpuFrameStart;
+
+        std::unordered_map<int, size_t> m_textureSizes; // Keyed by ImTextureData::UniqueID
+        size_t m_textureBytes;
+        size_t m_bufferBytes;
+
+        static constexpr int HISTORY_SIZE = 120;
+        float m_gpuHistory[HISTORY_SIZE];
+        float m_cpuHistory[HISTORY_SIZE];
+        int m_historyIndex;
+
+        char m_line[160]; // Text formatting buffer, so the overlay allocates no strings
+    };
+
+} // namespace Platform
+
+#endif // RENDER_STATS_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef SOFTWARE_RENDERER_H
+#define SOFTWARE_RENDERER_H
+
+#include "ThreadPool.h"
+#include "imgui.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Platform
+{
+
+    // CPU rasterizer for ImDrawData, producing an RGBA8 image (R in the lowest byte, like
+    // ImGui's RGBA32 textures). Triangles are set up and binned into 64x64 screen tiles in
+    // submission order, then tiles are rasterized in parallel; each tile is owned by one
+    // thread, so blending order matches the GPU path without any locking. Edge functions
+    // and texture/color blending use SSE2 where available.
+    class SoftwareRenderer
+    {
+    public:
+        explicit SoftwareRenderer(int threadCount = 0);
+        ~SoftwareRenderer();
+
+        // Handles ImGui texture create/update/destroy requests, like a GPU backend would
+        void UpdateTextures(ImDrawData *drawData);
+        void DestroyAllTextures();
+
+        // Rasterizes the draw data into the internal buffer, which is resized to the draw
+        // data's framebuffer size. When `region` is given (draw data coordinates, e.g. from
+        // DamageTracker), only that part of the buffer is cleared and redrawn.
+        void Render(const ImDrawData *drawData, const ImVec4 &clearColor, const ImVec4 *region = nullptr);
+
+        const uint32_t *GetPixels() const { return m_pixels.data(); }
+        int GetWidth() const { return m_width; }
+        int GetHeight() const { return m_height; }
+        int GetPitch() const { return m_width * 4; }
+
+        // Binary PPM (alpha dropped), for golden-image comparisons
+        bool SaveSnapshot(const std::string &path) const;
+
+        // Framebuffer, texture copies and binning scratch
+        size_t GetMemoryBytes() const;
+        // Frees the binning scratch, which is rebuilt by the next Render(); returns bytes released
+        size_t TrimMemory();
+
+    private:
+        static constexpr int TILE_SIZE = 64;
+
+        struct Texture
+        {
+            int width = 0;
+            int height = 0;
+            std::vector<uint32_t> pixels;
+        };
+
+        // Everything a tile needs to rasterize one triangle, computed once during binning
+        struct TriangleSetup
+        {
+            float edgeA[3];
+            float edgeB[3];
+            float edgeC[3];
+            bool topLeft[3];
+            float invArea;
+            float u[3];
+            float v[3];
+            float color[3][4];
+            int minX, minY, maxX, maxY; // Inclusive pixel bounds, already clipped
+            const Texture *texture;
+        };
+
+        void CopyTextureRect(Texture &dst, ImTextureData *src, int x, int y, int width, int height);
+        void BinTriangles(const ImDrawData *drawData, int limitX0, int limitY0, int limitX1, int limitY1);
+        void RasterizeTile(int tileIndex, uint32_t clearPixel, int limitX0, int limitY0, int limitX1, int limitY1);
+        void RasterizeTriangle(const TriangleSetup &tri, int x0, int y0, int x1, int y1);
+
+        ThreadPool m_pool;
+        std::vector<std::unique_ptr<Texture>> m_textures;
+
+        int m_width;
+        int m_height;
+        int m_tilesX;
+        int m_tilesY;
+        std::vector<uint32_t> m_pixels;
+        std::vector<TriangleSetup> m_triangles;
+        std::vector<std::vector<uint32_t>> m_bins;
+    };
+
+} // namespace Platform
+
+#endif // SOFTWARE_RENDERER_H
\ No newline at end of file
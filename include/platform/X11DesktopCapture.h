@@ -0,0 +1,58 @@
+#ifndef X11_DESKTOP_CAPTURE_H
+#define X11_DESKTOP_CAPTURE_H
+
+#include "IPlatform.h"
+#include "ThreadPool.h"
+#include "X11ScreenGrabber.h"
+#include <memory>
+#include <vector>
+
+namespace Platform
+{
+
+    // Captures the whole virtual desktop. Every monitor has its own grabber, and with it its
+    // own X connection, so all monitors are grabbed at the same time on a thread pool with one
+    // thread per monitor. Each grab converts its pixels straight into the monitor's place in
+    // the shared canvas; there is no per-monitor image and no compositing pass.
+    class X11DesktopCapture
+    {
+    public:
+        X11DesktopCapture();
+        ~X11DesktopCapture();
+
+        X11DesktopCapture(const X11DesktopCapture &) = delete;
+        X11DesktopCapture &operator=(const X11DesktopCapture &) = delete;
+
+        // Monitors are enumerated on the first capture and again after a grab fails, e.g.
+        // when a monitor was added or removed. Output scales are left at 1.
+        bool Capture(Imaging::Image &canvas, std::vector<DesktopOutput> &outputs);
+        void Shutdown();
+
+        // Desktop position of the canvas' top-left corner
+        int GetOriginX() const { return m_originX; }
+        int GetOriginY() const { return m_originY; }
+
+    private:
+        bool Configure();
+
+        struct Output
+        {
+            X11Output source;
+            std::unique_ptr<X11ScreenGrabber> grabber;
+            bool captured = false;
+        };
+
+        X11ScreenGrabber m_probe; // Enumerates the monitors
+        std::vector<Output> m_outputs;
+        std::unique_ptr<ThreadPool> m_pool;
+        int m_originX;
+        int m_originY;
+        int m_width;
+        int m_height;
+        bool m_hasGaps;
+        bool m_configured;
+    };
+
+} // namespace Platform
+
+#endif // X11_DESKTOP_CAPTURE_H
\ No newline at end of file
@@ -0,0 +1,86 @@
+#ifndef X11_SCREEN_GRABBER_H
+#define X11_SCREEN_GRABBER_H
+
+#include "image/Image.h"
+#include <cstdint>
+#include <vector>
+
+namespace Platform
+{
+
+    // One monitor as X11 reports it: a rectangle of a screen's root window, and where that
+    // rectangle sits in the virtual desktop
+    struct X11Output
+    {
+        int screen;
+        int x, y, width, height;
+        int desktopX, desktopY;
+    };
+
+    // Copies rectangles of an X11 root window, i.e. the whole desktop across all monitors of
+    // that screen. On a local server the pixels arrive through a shared memory segment
+    // (MIT-SHM), otherwise through XGetSubImage into an XImage that wraps a buffer we own;
+    // either way only the requested rectangle is transferred and nothing is allocated while
+    // the size stays the same. libX11 and libXext are loaded at runtime, so the application
+    // still starts without them. Each grabber has its own connection and may be used from one
+    // thread at a time.
+    class X11ScreenGrabber
+    {
+    public:
+        X11ScreenGrabber();
+        ~X11ScreenGrabber();
+
+        X11ScreenGrabber(const X11ScreenGrabber &) = delete;
+        X11ScreenGrabber &operator=(const X11ScreenGrabber &) = delete;
+
+        // The X screen whose root window is grabbed; the default screen unless set before
+        // the grabber connects
+        void SetScreen(int screen) { m_screen = screen; }
+
+        // Connects to the X server; returns false (once per grabber, without retrying) when
+        // libX11 or the server is unavailable, e.g. on a Wayland session without XWayland
+        bool Initialize();
+        void Shutdown();
+        bool IsConnected() const { return m_display != nullptr; }
+
+        int GetDesktopWidth() const { return m_desktopWidth; }
+        int GetDesktopHeight() const { return m_desktopHeight; }
+
+        // Connects on first use. `out` is only reallocated when its size changes; parts of the
+        // rectangle outside the desktop are black.
+        bool Grab(int x, int y, int width, int height, Imaging::Image &out);
+        // Writes a rectangle, which must lie inside the desktop, straight into `canvas` at
+        // (canvasX, canvasY)
+        bool GrabInto(int x, int y, int width, int height, Imaging::Image &canvas, int canvasX, int canvasY);
+
+        // Monitors of every screen on this connection. Multiple X screens (e.g. a multi-screen
+        // Xvfb) are placed side by side; a single screen is split by Xinerama when active.
+        bool QueryOutputs(std::vector<X11Output> &outputs);
+
+    private:
+        bool EnsureImage(int width, int height);
+        void DestroyImage();
+        bool EnsureSharedImage(int width, int height);
+        void DestroySharedImage();
+        void RefreshDesktopSize();
+
+        void *m_display; // Display *
+        void *m_image;   // XImage *, its data points into m_buffer
+        unsigned long m_root;
+        int m_desktopWidth;
+        int m_desktopHeight;
+        int m_imageWidth;
+        int m_imageHeight;
+        std::vector<uint8_t> m_buffer;
+        int m_screen;
+
+        // MIT-SHM image, sized exactly to the last shared grab
+        void *m_sharedImage;   // XImage *
+        void *m_sharedSegment; // XShmSegmentInfo *
+        bool m_sharedAvailable;
+        bool m_failed;
+    };
+
+} // namespace Platform
+
+#endif // X11_SCREEN_GRABBER_H
\ No newline at end of file
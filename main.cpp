@@ -1,14 +1,222 @@
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <memory>
 #include "Application.h"
+#include "BatchProcessor.h"
 
-int main()
+static void PrintUsage(const char *program)
+{
+    std::cout << "Usage: " << program << " [options]\n"
+              << "  --record <file>       Record all input events to a binary log\n"
+              << "  --replay <file>       Replay a recorded input log, then exit\n"
+              << "  --replay-dt <seconds> Fixed frame delta used while replaying (default 1/60)\n"
+              << "  --frame-times <file>  Write per-frame CPU timings as CSV\n"
+              << "  --memory-budget <MB>  Evict caches when the resident set grows past this size\n"
+              << "  --gpu-budget <MB>     Evict GPU caches when tracked GPU memory grows past this size\n"
+              << "\n"
+              << "       " << program << " --batch <inputs...> --output <dir> [pipeline options]\n"
+              << "  Processes images without opening a window. Inputs are files, directories or\n"
+              << "  patterns with * and ? in the file name.\n"
+              << "  --output <dir>        Destination directory (required)\n"
+              << "  --resize <W>x<H>      Resize to W x H; 0 for one side keeps the aspect ratio\n"
+              << "  --max-size <n>        Shrink to fit within n x n, never upscaling\n"
+              << "  --scale <factor>      Scale both sides by a factor\n"
+              << "  --filter <name>       box, mitchell or lanczos3 (default lanczos3)\n"
+              << "  --redact <file>       Fill or pixelate the regions listed in a JSON spec\n"
+              << "  --format <name>       png, bmp, tga or ppm (default: same as the input)\n"
+              << "  --strip-metadata      Drop text, EXIF and timestamp chunks\n"
+              << "  --compression <0-9>   PNG compression level (default 6)\n"
+              << "  --jobs <n>            Images in flight at once, 0 = one per core (default 0)\n"
+              << "  --verbose             Print every processed file\n";
+}
+
+static bool ParseBatchArguments(int argc, char **argv, BatchOptions &options)
+{
+    int resizeModes = 0;
+    for (int i = 2; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (arg[0] != '-')
+        {
+            options.inputs.push_back(arg);
+            continue;
+        }
+        if (strcmp(arg, "--strip-metadata") == 0)
+        {
+            options.stripMetadata = true;
+            continue;
+        }
+        if (strcmp(arg, "--verbose") == 0)
+        {
+            options.verbose = true;
+            continue;
+        }
+
+        if (value == nullptr)
+        {
+            std::cerr << "Missing value or unknown option: " << arg << std::endl;
+            return false;
+        }
+
+        if (strcmp(arg, "--output") == 0 || strcmp(arg, "-o") == 0)
+            options.outputDirectory = value;
+        else if (strcmp(arg, "--resize") == 0)
+        {
+            if (sscanf(value, "%dx%d", &options.resizeWidth, &options.resizeHeight) != 2 ||
+                options.resizeWidth < 0 || options.resizeHeight < 0 || options.resizeWidth + options.resizeHeight == 0)
+            {
+                std::cerr << "--resize expects <W>x<H>" << std::endl;
+                return false;
+            }
+            resizeModes++;
+        }
+        else if (strcmp(arg, "--max-size") == 0)
+        {
+            options.maxSize = atoi(value);
+            resizeModes++;
+        }
+        else if (strcmp(arg, "--scale") == 0)
+        {
+            options.scale = (float)atof(value);
+            resizeModes++;
+        }
+        else if (strcmp(arg, "--filter") == 0)
+        {
+            const Imaging::ResampleFilter filters[] = {Imaging::ResampleFilter::Box, Imaging::ResampleFilter::Mitchell, Imaging::ResampleFilter::Lanczos3};
+            bool found = false;
+            for (Imaging::ResampleFilter filter : filters)
+            {
+                if (strcmp(value, Imaging::GetFilterName(filter)) == 0)
+                {
+                    options.filter = filter;
+                    found = true;
+                }
+            }
+            if (!found)
+            {
+                std::cerr << "Unknown filter: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--redact") == 0)
+            options.redactSpecPath = value;
+        else if (strcmp(arg, "--format") == 0)
+        {
+            options.format = Imaging::FormatFromName(value);
+            if (options.format == Imaging::ImageFormat::Unknown)
+            {
+                std::cerr << "Unknown format: " << value << std::endl;
+                return false;
+            }
+        }
+        else if (strcmp(arg, "--compression") == 0)
+            options.compressionLevel = atoi(value);
+        else if (strcmp(arg, "--jobs") == 0)
+            options.jobs = atoi(value);
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+        i++;
+    }
+
+    if (options.inputs.empty() || options.outputDirectory.empty())
+    {
+        std::cerr << "--batch needs at least one input and --output" << std::endl;
+        return false;
+    }
+    if (resizeModes > 1 || options.maxSize < 0 || options.scale < 0.0f)
+    {
+        std::cerr << "Use one of --resize, --max-size or --scale, with positive values" << std::endl;
+        return false;
+    }
+    if (options.compressionLevel < 0 || options.compressionLevel > 9 || options.jobs < 0)
+    {
+        std::cerr << "--compression must be 0-9 and --jobs non-negative" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+static bool ParseArguments(int argc, char **argv, ApplicationOptions &options)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        const char *arg = argv[i];
+        const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0)
+        {
+            PrintUsage(argv[0]);
+            std::exit(0);
+        }
+
+        if (value == nullptr)
+        {
+            std::cerr << "Missing value or unknown option: " << arg << std::endl;
+            return false;
+        }
+
+        if (strcmp(arg, "--record") == 0)
+            options.recordInputPath = value;
+        else if (strcmp(arg, "--replay") == 0)
+            options.replayInputPath = value;
+        else if (strcmp(arg, "--replay-dt") == 0)
+            options.replayDeltaTime = (float)atof(value);
+        else if (strcmp(arg, "--frame-times") == 0)
+            options.frameTimesPath = value;
+        else if (strcmp(arg, "--memory-budget") == 0)
+            options.residentBudgetMb = strtoul(value, nullptr, 10);
+        else if (strcmp(arg, "--gpu-budget") == 0)
+            options.gpuBudgetMb = strtoul(value, nullptr, 10);
+        else
+        {
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return false;
+        }
+        i++;
+    }
+
+    if (options.replayDeltaTime <= 0.0f)
+    {
+        std::cerr << "--replay-dt must be positive" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
 {
     try
     {
+        // Batch mode never touches the windowing platform, so it runs on headless machines
+        if (argc > 1 && strcmp(argv[1], "--batch") == 0)
+        {
+            BatchOptions batchOptions;
+            if (!ParseBatchArguments(argc, argv, batchOptions))
+            {
+                PrintUsage(argv[0]);
+                return 2;
+            }
+            BatchProcessor processor(batchOptions);
+            return processor.Run();
+        }
+
+        ApplicationOptions options;
+        if (!ParseArguments(argc, argv, options))
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+
         auto app = std::make_unique<Application>();
 
-        if (!app->Initialize())
+        if (!app->Initialize(options))
         {
             std::cerr << "Failed to initialize application" << std::endl;
             return -1;
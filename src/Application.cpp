@@ -1,9 +1,13 @@
 #include "Application.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
 #include "platform/IPlatform.h"
+#include <chrono>
 #include <iostream>
+#include <utility>
 
 Application::Application()
-    : m_running(false)
+    : m_running(false), m_frameIndex(0)
 {
 }
 
@@ -12,10 +16,15 @@ Application::~Application()
     Shutdown();
 }
 
-bool Application::Initialize()
+bool Application::Initialize(const ApplicationOptions &options)
 {
     // Create platform-specific implementation
-    m_platform = Platform::CreatePlatform();
+    return Initialize(Platform::CreatePlatform(), options);
+}
+
+bool Application::Initialize(std::unique_ptr<Platform::IPlatform> platform, const ApplicationOptions &options)
+{
+    m_platform = std::move(platform);
     if (!m_platform)
     {
         std::cerr << "Failed to create platform implementation" << std::endl;
@@ -30,6 +39,10 @@ bool Application::Initialize()
     config.resizable = true;
     config.vsync = true;
 
+    // ImGui allocations are only counted if the allocator is in place before the context exists
+    MemoryTracker::InstallImGuiAllocator();
+    MemoryTracker::Get().SetBudgets(options.residentBudgetMb * 1024 * 1024, options.gpuBudgetMb * 1024 * 1024);
+
     // Initialize platform
     if (!m_platform->Initialize(config))
     {
@@ -37,9 +50,32 @@ bool Application::Initialize()
         return false;
     }
 
+    if (!options.replayInputPath.empty() && !m_platform->StartInputReplay(options.replayInputPath, options.replayDeltaTime))
+    {
+        std::cerr << "Failed to start input replay from " << options.replayInputPath << std::endl;
+        return false;
+    }
+
+    if (!options.recordInputPath.empty() && !m_platform->StartInputRecording(options.recordInputPath))
+    {
+        std::cerr << "Failed to start input recording to " << options.recordInputPath << std::endl;
+        return false;
+    }
+
+    if (!options.frameTimesPath.empty())
+    {
+        m_frameTimesFile.open(options.frameTimesPath, std::ios::trunc);
+        if (!m_frameTimesFile)
+        {
+            std::cerr << "Failed to open frame times file " << options.frameTimesPath << std::endl;
+            return false;
+        }
+        m_frameTimesFile << "frame,poll_ms,update_ms,new_frame_ms,ui_ms,present_ms,total_ms\n";
+    }
+
     // Create UI manager
     m_ui = std::make_unique<UIManager>();
-    m_ui->Initialize();
+    m_ui->Initialize(m_platform.get());
 
     m_running = true;
 
@@ -56,6 +92,12 @@ bool Application::Initialize()
     case Platform::RendererType::Metal:
         std::cout << "Metal" << std::endl;
         break;
+    case Platform::RendererType::Headless:
+        std::cout << "Headless" << std::endl;
+        break;
+    case Platform::RendererType::Software:
+        std::cout << "Software" << std::endl;
+        break;
     }
 
     return true;
@@ -63,39 +105,66 @@ bool Application::Initialize()
 
 void Application::Run()
 {
-    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
-
     while (m_running && !m_platform->ShouldClose())
     {
-        m_platform->PollEvents();
-        m_platform->SetClearColor(clear_color);
-        Update();
-        Render();
+        Tick();
     }
 }
 
-void Application::Update()
+void Application::Tick()
 {
-    // Update application logic here
-    if (m_ui)
-    {
-        m_ui->Update();
-    }
-}
+    using Clock = std::chrono::steady_clock;
+    ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
+
+    auto start = Clock::now();
+    m_platform->PollEvents();
+    m_platform->SetClearColor(clear_color);
+    auto polled = Clock::now();
+    Update();
+    auto updated = Clock::now();
 
-void Application::Render()
-{
     // Start the Dear ImGui frame
     m_platform->NewFrame();
+    auto frameStarted = Clock::now();
 
     // Render UI
     if (m_ui)
     {
         m_ui->Render();
     }
+    auto uiBuilt = Clock::now();
 
     // Rendering
     m_platform->RenderFrame();
+    auto presented = Clock::now();
+
+    auto toMs = [](Clock::duration d)
+    { return std::chrono::duration<double, std::milli>(d).count(); };
+    m_lastFrameTimings.pollMs = toMs(polled - start);
+    m_lastFrameTimings.updateMs = toMs(updated - polled);
+    m_lastFrameTimings.newFrameMs = toMs(frameStarted - updated);
+    m_lastFrameTimings.uiMs = toMs(uiBuilt - frameStarted);
+    m_lastFrameTimings.presentMs = toMs(presented - uiBuilt);
+    m_lastFrameTimings.totalMs = toMs(presented - start);
+    Profiler::Get().EndFrame();
+
+    if (m_frameTimesFile.is_open())
+    {
+        m_frameTimesFile << m_frameIndex << ',' << m_lastFrameTimings.pollMs << ',' << m_lastFrameTimings.updateMs << ','
+                         << m_lastFrameTimings.newFrameMs << ',' << m_lastFrameTimings.uiMs << ','
+                         << m_lastFrameTimings.presentMs << ',' << m_lastFrameTimings.totalMs << '\n';
+    }
+    m_frameIndex++;
+}
+
+void Application::Update()
+{
+    // Update application logic here
+    if (m_ui)
+    {
+        m_ui->Update();
+    }
+    MemoryTracker::Get().Update();
 }
 
 void Application::Shutdown()
@@ -112,6 +181,11 @@ void Application::Shutdown()
         m_platform.reset();
     }
 
+    if (m_frameTimesFile.is_open())
+    {
+        m_frameTimesFile.close();
+    }
+
     m_running = false;
     std::cout << "Application shutdown complete" << std::endl;
 }
@@ -0,0 +1,383 @@
+#include "BatchProcessor.h"
+#include "Json.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <sstream>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    // Matches a file name against a pattern with * and ? wildcards
+    bool MatchWildcard(const char *pattern, const char *name)
+    {
+        const char *star = nullptr;
+        const char *resume = nullptr;
+        while (*name != '\0')
+        {
+            if (*pattern == '*')
+            {
+                star = pattern++;
+                resume = name;
+            }
+            else if (*pattern == '?' || *pattern == *name)
+            {
+                pattern++;
+                name++;
+            }
+            else if (star != nullptr)
+            {
+                pattern = star + 1;
+                name = ++resume;
+            }
+            else
+                return false;
+        }
+        while (*pattern == '*')
+            pattern++;
+        return *pattern == '\0';
+    }
+
+    bool HasImageExtension(const fs::path &path)
+    {
+        return Imaging::FormatFromPath(path.string()) != Imaging::ImageFormat::Unknown;
+    }
+
+    bool ReadFile(const std::string &path, std::vector<uint8_t> &data)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (!file)
+            return false;
+        std::streamoff size = file.tellg();
+        if (size < 0)
+            return false;
+        data.resize((size_t)size);
+        file.seekg(0);
+        return file.read(reinterpret_cast<char *>(data.data()), size).good() || size == 0;
+    }
+
+    bool WriteFile(const std::string &path, const std::vector<uint8_t> &data)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        return file && file.write(reinterpret_cast<const char *>(data.data()), (std::streamsize)data.size()).good();
+    }
+
+    // "#RRGGBB" or "#RRGGBBAA"
+    bool ParseColor(const std::string &text, uint32_t &color)
+    {
+        if ((text.size() != 7 && text.size() != 9) || text[0] != '#')
+            return false;
+        char *end = nullptr;
+        unsigned long value = strtoul(text.c_str() + 1, &end, 16);
+        if (*end != '\0')
+            return false;
+        if (text.size() == 7)
+            value = (value << 8) | 0xFF;
+        color = (uint32_t)(((value >> 24) & 0xFF) | (((value >> 16) & 0xFF) << 8) | (((value >> 8) & 0xFF) << 16) | ((value & 0xFF) << 24));
+        return true;
+    }
+
+    // Per-worker state, kept across images so steady-state processing reuses its buffers
+    struct WorkerState
+    {
+        Imaging::Resampler resampler{1};
+        std::vector<uint8_t> input;
+        std::vector<uint8_t> output;
+        Imaging::ImageFile file;
+        Imaging::Image scaled;
+    };
+}
+
+BatchProcessor::BatchProcessor(const BatchOptions &options)
+    : m_options(options), m_pool(options.jobs), m_bytesRead(0), m_bytesWritten(0), m_pixels(0), m_succeeded(0), m_failed(0)
+{
+}
+
+int BatchProcessor::Run()
+{
+    std::vector<BatchItem> items;
+    if (!CollectInputs(items))
+        return 2;
+    if (items.empty())
+    {
+        std::cerr << "No input images found" << std::endl;
+        return 2;
+    }
+    if (!m_options.redactSpecPath.empty() && !LoadRedactSpec())
+        return 2;
+
+    std::error_code ec;
+    fs::create_directories(m_options.outputDirectory, ec);
+    if (ec)
+    {
+        std::cerr << "Failed to create output directory " << m_options.outputDirectory << ": " << ec.message() << std::endl;
+        return 2;
+    }
+
+    std::cout << "Processing " << items.size() << " images with " << m_pool.GetThreadCount() << " workers" << std::endl;
+
+    auto start = std::chrono::steady_clock::now();
+    m_pool.ParallelFor((int)items.size(), [&](int index)
+                       { ProcessFile(items[index]); });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    seconds = std::max(seconds, 1e-6);
+
+    const double MB = 1024.0 * 1024.0;
+    printf("Processed %d images (%d failed) in %.2f s\n", m_succeeded.load(), m_failed.load(), seconds);
+    printf("  %.1f images/s, %.1f MB/s read, %.1f MB/s written, %.1f Mpixel/s\n",
+           m_succeeded / seconds, m_bytesRead / MB / seconds, m_bytesWritten / MB / seconds, m_pixels / 1e6 / seconds);
+    return m_failed > 0 ? 1 : 0;
+}
+
+bool BatchProcessor::CollectInputs(std::vector<BatchItem> &items) const
+{
+    std::vector<std::string> files;
+    for (const std::string &input : m_options.inputs)
+    {
+        fs::path path(input);
+        std::error_code ec;
+        if (fs::is_directory(path, ec))
+        {
+            for (const auto &entry : fs::directory_iterator(path, ec))
+            {
+                if (entry.is_regular_file(ec) && HasImageExtension(entry.path()))
+                    files.push_back(entry.path().string());
+            }
+        }
+        else if (input.find_first_of("*?") != std::string::npos)
+        {
+            // Wildcards in the file name only, so huge directories can be passed without
+            // hitting the shell's argument limit
+            std::string pattern = path.filename().string();
+            fs::path directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            for (const auto &entry : fs::directory_iterator(directory, ec))
+            {
+                if (entry.is_regular_file(ec) && MatchWildcard(pattern.c_str(), entry.path().filename().string().c_str()))
+                    files.push_back(entry.path().string());
+            }
+        }
+        else if (fs::is_regular_file(path, ec))
+            files.push_back(input);
+        else
+        {
+            std::cerr << "Input not found: " << input << std::endl;
+            return false;
+        }
+
+        if (ec)
+        {
+            std::cerr << "Failed to list " << input << ": " << ec.message() << std::endl;
+            return false;
+        }
+    }
+
+    std::sort(files.begin(), files.end());
+    files.erase(std::unique(files.begin(), files.end()), files.end());
+
+    // Outputs are flat in the output directory, so in1/x.png and in2/x.png, or x.png and x.bmp
+    // converted to one format, would overwrite each other (concurrently, with several jobs)
+    std::unordered_map<std::string, const std::string *> outputs;
+    items.reserve(files.size());
+    for (const std::string &file : files)
+    {
+        BatchItem item;
+        item.input = file;
+        item.format = m_options.format != Imaging::ImageFormat::Unknown ? m_options.format : Imaging::FormatFromPath(file);
+        fs::path output = fs::path(m_options.outputDirectory) / fs::path(file).filename();
+        if (item.format != Imaging::ImageFormat::Unknown)
+            output.replace_extension(Imaging::GetFormatExtension(item.format));
+        item.output = output.string();
+
+        std::error_code ec;
+        fs::path key = fs::absolute(output, ec).lexically_normal();
+        auto inserted = outputs.emplace(key.string(), &file);
+        if (!inserted.second)
+        {
+            std::cerr << *inserted.first->second << " and " << file << " would both be written to " << item.output << std::endl;
+            return false;
+        }
+        if (fs::exists(output, ec) && fs::equivalent(output, file, ec))
+        {
+            std::cerr << file << ": output would overwrite the input" << std::endl;
+            return false;
+        }
+        items.push_back(std::move(item));
+    }
+    return true;
+}
+
+bool BatchProcessor::LoadRedactSpec()
+{
+    std::ifstream file(m_options.redactSpecPath);
+    if (!file)
+    {
+        std::cerr << "Failed to open redaction spec " << m_options.redactSpecPath << std::endl;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string text = buffer.str();
+
+    JsonValue root;
+    JsonReader reader(text);
+    if (!reader.Parse(root))
+    {
+        std::cerr << m_options.redactSpecPath << ": JSON error at offset " << reader.GetErrorOffset() << std::endl;
+        return false;
+    }
+
+    // Either {"regions": [...]} or the bare array
+    const JsonValue *regions = root.type == JsonValue::Type::Array ? &root : root.Find("regions");
+    if (regions == nullptr || regions->type != JsonValue::Type::Array)
+    {
+        std::cerr << m_options.redactSpecPath << ": expected a \"regions\" array" << std::endl;
+        return false;
+    }
+
+    for (size_t i = 0; i < regions->items.size(); i++)
+    {
+        const JsonValue &item = regions->items[i];
+        RegionSpec spec;
+        spec.x = (float)item.GetNumber("x", 0.0);
+        spec.y = (float)item.GetNumber("y", 0.0);
+        spec.width = (float)item.GetNumber("width", 0.0);
+        spec.height = (float)item.GetNumber("height", 0.0);
+        spec.relative = item.GetString("units", "pixels") == "relative";
+        spec.region.blockSize = (int)item.GetNumber("block", 16.0);
+
+        std::string mode = item.GetString("mode", "fill");
+        std::string color = item.GetString("color", "#000000");
+        bool valid = item.type == JsonValue::Type::Object && spec.width > 0.0f && spec.height > 0.0f &&
+                     (mode == "fill" || mode == "pixelate") && ParseColor(color, spec.region.color);
+        if (!valid)
+        {
+            std::cerr << m_options.redactSpecPath << ": invalid region " << i
+                      << " (needs width/height > 0, mode fill|pixelate, color #RRGGBB[AA])" << std::endl;
+            return false;
+        }
+        spec.region.mode = mode == "pixelate" ? Imaging::RedactMode::Pixelate : Imaging::RedactMode::Fill;
+        m_regions.push_back(spec);
+    }
+    return true;
+}
+
+bool BatchProcessor::ComputeTargetSize(int width, int height, int &targetWidth, int &targetHeight) const
+{
+    targetWidth = width;
+    targetHeight = height;
+    if (m_options.resizeWidth > 0 || m_options.resizeHeight > 0)
+    {
+        targetWidth = m_options.resizeWidth;
+        targetHeight = m_options.resizeHeight;
+        if (targetWidth == 0)
+            targetWidth = (int)std::lround((double)width * targetHeight / height);
+        if (targetHeight == 0)
+            targetHeight = (int)std::lround((double)height * targetWidth / width);
+    }
+    else if (m_options.maxSize > 0)
+    {
+        double scale = std::min({1.0, (double)m_options.maxSize / width, (double)m_options.maxSize / height});
+        targetWidth = (int)std::lround(width * scale);
+        targetHeight = (int)std::lround(height * scale);
+    }
+    else if (m_options.scale > 0.0f)
+    {
+        targetWidth = (int)std::lround(width * (double)m_options.scale);
+        targetHeight = (int)std::lround(height * (double)m_options.scale);
+    }
+
+    targetWidth = std::max(targetWidth, 1);
+    targetHeight = std::max(targetHeight, 1);
+    return targetWidth != width || targetHeight != height;
+}
+
+void BatchProcessor::ProcessFile(const BatchItem &item)
+{
+    std::string error;
+    if (TransformFile(item, error))
+    {
+        m_succeeded++;
+        return;
+    }
+
+    m_failed++;
+    std::lock_guard<std::mutex> lock(m_logMutex);
+    std::cerr << item.input << ": " << error << std::endl;
+}
+
+bool BatchProcessor::TransformFile(const BatchItem &item, std::string &error)
+{
+    thread_local WorkerState state;
+
+    if (!ReadFile(item.input, state.input))
+    {
+        error = "failed to read file";
+        return false;
+    }
+    m_bytesRead += state.input.size();
+
+    Imaging::ImageFile &file = state.file;
+    if (!Imaging::DecodeImage(state.input.data(), state.input.size(), file, error))
+        return false;
+
+    Imaging::Image &image = file.image;
+    int sourceWidth = image.width;
+    int sourceHeight = image.height;
+    m_pixels += (uint64_t)sourceWidth * sourceHeight;
+
+    // Redact first, so region coordinates are in source pixels
+    for (const RegionSpec &spec : m_regions)
+    {
+        Imaging::RedactRegion region = spec.region;
+        float scaleX = spec.relative ? (float)image.width : 1.0f;
+        float scaleY = spec.relative ? (float)image.height : 1.0f;
+        region.x = (int)std::floor(spec.x * scaleX);
+        region.y = (int)std::floor(spec.y * scaleY);
+        region.width = (int)std::ceil((spec.x + spec.width) * scaleX) - region.x;
+        region.height = (int)std::ceil((spec.y + spec.height) * scaleY) - region.y;
+        Imaging::Redact(image, region);
+    }
+
+    int targetWidth, targetHeight;
+    if (ComputeTargetSize(image.width, image.height, targetWidth, targetHeight))
+    {
+        if (!state.resampler.Resample(image, state.scaled, targetWidth, targetHeight, m_options.filter))
+        {
+            error = "resize failed";
+            return false;
+        }
+        std::swap(image, state.scaled);
+    }
+
+    if (m_options.stripMetadata)
+        Imaging::StripMetadata(file);
+
+    Imaging::ImageFormat format = item.format != Imaging::ImageFormat::Unknown ? item.format : file.format;
+    if (!Imaging::EncodeImage(file, format, state.output, m_options.compressionLevel))
+    {
+        error = "failed to encode";
+        return false;
+    }
+    if (!WriteFile(item.output, state.output))
+    {
+        error = "failed to write " + item.output;
+        return false;
+    }
+    m_bytesWritten += state.output.size();
+
+    if (m_options.verbose)
+    {
+        std::lock_guard<std::mutex> lock(m_logMutex);
+        std::cout << item.input << " (" << sourceWidth << "x" << sourceHeight << ") -> " << item.output
+                  << " (" << image.width << "x" << image.height << ")" << std::endl;
+    }
+    return true;
+}
\ No newline at end of file
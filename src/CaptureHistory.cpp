@@ -0,0 +1,152 @@
+#include "CaptureHistory.h"
+#include "image/PerceptualHash.h"
+#include <algorithm>
+#include <chrono>
+
+CaptureHistory::CaptureHistory() : m_generation(0), m_nextId(1), m_dedupOnSave(false) {}
+
+CaptureHistory::AddResult CaptureHistory::Add(const Imaging::Image &image, const std::string &path)
+{
+    int64_t now = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    return AddHashed(path, image.width, image.height, Imaging::ComputeDHash(image), Imaging::ComputePHash(image), now);
+}
+
+CaptureHistory::AddResult CaptureHistory::AddHashed(const std::string &path, int width, int height, uint64_t dHash, uint64_t pHash, int64_t timestamp)
+{
+    AddResult result;
+    if (m_dedupOnSave)
+    {
+        std::vector<CaptureMatch> matches;
+        if (FindDuplicateOf(dHash, pHash, 0, &matches))
+        {
+            result.id = matches.front().id;
+            result.duplicate = true;
+            return result;
+        }
+    }
+
+    CaptureEntry entry;
+    entry.id = m_nextId++;
+    entry.path = path;
+    entry.timestamp = timestamp;
+    entry.width = width;
+    entry.height = height;
+    entry.dHash = dHash;
+    entry.pHash = pHash;
+
+    m_indexById[entry.id] = m_entries.size();
+    m_index.Insert(entry.id, pHash);
+    m_entries.push_back(std::move(entry));
+    m_generation++;
+
+    result.id = m_entries.back().id;
+    return result;
+}
+
+bool CaptureHistory::Remove(uint32_t id)
+{
+    auto it = m_indexById.find(id);
+    if (it == m_indexById.end())
+        return false;
+
+    // Keep chronological order; only the entries after the removed one move
+    size_t position = it->second;
+    m_indexById.erase(it);
+    m_index.Remove(id);
+    m_entries.erase(m_entries.begin() + position);
+    for (size_t i = position; i < m_entries.size(); i++)
+        m_indexById[m_entries[i].id] = i;
+    m_generation++;
+    return true;
+}
+
+size_t CaptureHistory::Remove(const std::vector<uint32_t> &ids)
+{
+    // Ids start at 1, so a zero id marks an entry for removal until the single compaction below
+    size_t first = m_entries.size();
+    size_t removed = 0;
+    for (uint32_t id : ids)
+    {
+        auto it = m_indexById.find(id);
+        if (it == m_indexById.end())
+            continue;
+        first = std::min(first, it->second);
+        m_entries[it->second].id = 0;
+        m_indexById.erase(it);
+        m_index.Remove(id);
+        removed++;
+    }
+    if (removed == 0)
+        return 0;
+
+    m_entries.erase(std::remove_if(m_entries.begin() + first, m_entries.end(), [](const CaptureEntry &entry)
+                                   { return entry.id == 0; }),
+                    m_entries.end());
+    for (size_t i = first; i < m_entries.size(); i++)
+        m_indexById[m_entries[i].id] = i;
+    m_generation++;
+    return removed;
+}
+
+void CaptureHistory::Clear()
+{
+    m_entries.clear();
+    m_indexById.clear();
+    m_index.Clear();
+    m_generation++;
+}
+
+size_t CaptureHistory::GetMemoryBytes() const
+{
+    size_t bytes = m_entries.capacity() * sizeof(CaptureEntry) + m_index.GetMemoryBytes();
+    for (const CaptureEntry &entry : m_entries)
+        bytes += entry.path.capacity();
+    bytes += m_indexById.size() * (sizeof(std::pair<const uint32_t, size_t>) + 2 * sizeof(void *)) + m_indexById.bucket_count() * sizeof(void *);
+    return bytes;
+}
+
+const CaptureEntry *CaptureHistory::Find(uint32_t id) const
+{
+    auto it = m_indexById.find(id);
+    return it != m_indexById.end() ? &m_entries[it->second] : nullptr;
+}
+
+bool CaptureHistory::FindDuplicateOf(uint64_t dHash, uint64_t pHash, uint32_t exclude, std::vector<CaptureMatch> *out) const
+{
+    // The pHash index narrows the candidates, the dHash confirms they really are the same picture
+    m_index.Query(pHash, DUPLICATE_DISTANCE, m_queryScratch);
+    bool found = false;
+    for (const Imaging::HashIndex::Match &match : m_queryScratch)
+    {
+        const CaptureEntry *entry = Find(match.id);
+        if (match.id == exclude || entry == nullptr || Imaging::HammingDistance(entry->dHash, dHash) > DUPLICATE_DISTANCE)
+            continue;
+        found = true;
+        if (out == nullptr)
+            break;
+        out->push_back({match.id, match.distance});
+    }
+    return found;
+}
+
+void CaptureHistory::FindDuplicates(uint32_t id, std::vector<CaptureMatch> &out) const
+{
+    out.clear();
+    if (const CaptureEntry *entry = Find(id))
+        FindDuplicateOf(entry->dHash, entry->pHash, id, &out);
+}
+
+void CaptureHistory::FindSimilar(uint32_t id, int maxDistance, std::vector<CaptureMatch> &out) const
+{
+    out.clear();
+    const CaptureEntry *entry = Find(id);
+    if (entry == nullptr)
+        return;
+
+    m_index.Query(entry->pHash, maxDistance, m_queryScratch);
+    for (const Imaging::HashIndex::Match &match : m_queryScratch)
+    {
+        if (match.id != id)
+            out.push_back({match.id, match.distance});
+    }
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include "EditorTool.h"
+#include "image/Redact.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    // Undo steps are the user's work, so they go after caches that rebuild themselves
+    constexpr int UNDO_EVICT_PRIORITY = 10;
+
+    bool ReadFile(const std::string &path, std::vector<uint8_t> &data)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+}
+
+EditorTool::EditorTool(CaptureHistory &history)
+    : m_history(history), m_resampler(1), m_previewDirty(false), m_region{0, 0, 200, 100}, m_mode((int)Imaging::RedactMode::Fill), m_blockSize(16), m_status{}
+{
+    m_imageMemory.Register("Editor image", MemoryKind::Heap, [this]()
+                           { return (m_file.image.pixels.capacity() + m_preview.pixels.capacity()) * sizeof(uint32_t); });
+    m_undoMemory.Register("Undo history", MemoryKind::Heap, [this]()
+                          { return m_undo.GetMemoryBytes(); }, [this](size_t wanted)
+                          {
+                              size_t bytes = m_undo.GetMemoryBytes();
+                              return m_undo.Trim(bytes > wanted ? bytes - wanted : 0); }, UNDO_EVICT_PRIORITY);
+}
+
+EditorTool::~EditorTool()
+{
+    // The renderer's shutdown frees the GPU copy of every registered texture
+    if (ImGui::GetCurrentContext() == nullptr)
+        return;
+    if (m_texture)
+        ImGui::UnregisterUserTexture(m_texture.get());
+    for (const std::unique_ptr<ImTextureData> &tex : m_retiredTextures)
+        ImGui::UnregisterUserTexture(tex.get());
+}
+
+bool EditorTool::ReleaseResources()
+{
+    m_preview = Imaging::Image();
+    m_previewDirty = !m_file.image.IsEmpty();
+    RetireTexture();
+    return ReleaseRetiredTextures();
+}
+
+bool EditorTool::Open(uint32_t id)
+{
+    const CaptureEntry *entry = m_history.Find(id);
+    std::vector<uint8_t> data;
+    std::string error;
+    Imaging::ImageFile file;
+    if (entry == nullptr || !ReadFile(entry->path, data))
+    {
+        snprintf(m_status, sizeof(m_status), "Cannot read %s", entry ? entry->path.c_str() : "capture");
+        return false;
+    }
+    if (!Imaging::DecodeImage(data.data(), data.size(), file, error))
+    {
+        snprintf(m_status, sizeof(m_status), "%s: %s", entry->path.c_str(), error.c_str());
+        return false;
+    }
+
+    m_path = entry->path;
+    m_file = std::move(file);
+    m_undo.Clear();
+    m_previewDirty = true;
+    snprintf(m_status, sizeof(m_status), "Opened %s", m_path.c_str());
+    return true;
+}
+
+bool EditorTool::Undo()
+{
+    if (!m_undo.Undo(m_file.image))
+        return false;
+    m_previewDirty = true;
+    return true;
+}
+
+bool EditorTool::Redo()
+{
+    if (!m_undo.Redo(m_file.image))
+        return false;
+    m_previewDirty = true;
+    return true;
+}
+
+void EditorTool::Redact()
+{
+    Imaging::RedactRegion region;
+    region.x = m_region[0];
+    region.y = m_region[1];
+    region.width = m_region[2];
+    region.height = m_region[3];
+    region.mode = (Imaging::RedactMode)m_mode;
+    region.blockSize = std::max(m_blockSize, 2);
+
+    m_undo.BeginEdit(m_file.image, "Redact");
+    m_undo.Touch(region.x, region.y, region.width, region.height);
+    Imaging::Redact(m_file.image, region);
+    m_undo.EndEdit(m_file.image);
+    m_previewDirty = true;
+}
+
+void EditorTool::Crop()
+{
+    const Imaging::Image &image = m_file.image;
+    int x0 = std::clamp(m_region[0], 0, image.width);
+    int y0 = std::clamp(m_region[1], 0, image.height);
+    int x1 = std::clamp(m_region[0] + m_region[2], 0, image.width);
+    int y1 = std::clamp(m_region[1] + m_region[3], 0, image.height);
+    if (x1 <= x0 || y1 <= y0)
+    {
+        snprintf(m_status, sizeof(m_status), "The crop region is outside the image");
+        return;
+    }
+
+    // The size changes, so the whole previous image goes into the step
+    m_undo.BeginEdit(m_file.image, "Crop");
+    m_undo.TouchAll();
+    Imaging::Image cropped;
+    cropped.Allocate(x1 - x0, y1 - y0);
+    for (int y = y0; y < y1; y++)
+        std::copy(image.Row(y) + x0, image.Row(y) + x1, cropped.Row(y - y0));
+    m_file.image = std::move(cropped);
+    m_undo.EndEdit(m_file.image);
+    m_previewDirty = true;
+}
+
+bool EditorTool::Save()
+{
+    std::filesystem::path path(m_path);
+    path.replace_filename(path.stem().string() + "_edited.png");
+
+    std::vector<uint8_t> encoded;
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!Imaging::EncodeImage(m_file, Imaging::ImageFormat::Png, encoded) || !stream ||
+        !stream.write(reinterpret_cast<const char *>(encoded.data()), (std::streamsize)encoded.size()))
+    {
+        snprintf(m_status, sizeof(m_status), "Cannot write %s", path.string().c_str());
+        return false;
+    }
+    m_history.Add(m_file.image, path.string());
+    snprintf(m_status, sizeof(m_status), "Saved %s", path.string().c_str());
+    return true;
+}
+
+void EditorTool::UpdatePreview()
+{
+    m_previewDirty = false;
+    if (!m_resampler.ResampleToFit(m_file.image, m_preview, PREVIEW_SIZE, PREVIEW_SIZE, Imaging::ResampleFilter::Box))
+        return;
+
+    // A crop changes the preview size; the old texture is retired rather than resized
+    if (m_texture && (m_texture->Width != m_preview.width || m_texture->Height != m_preview.height))
+        RetireTexture();
+
+    bool created = !m_texture;
+    if (created)
+    {
+        m_texture = std::make_unique<ImTextureData>();
+        m_texture->Create(ImTextureFormat_RGBA32, m_preview.width, m_preview.height);
+        ImGui::RegisterUserTexture(m_texture.get());
+    }
+    ImTextureData *tex = m_texture.get();
+    memcpy(tex->GetPixels(), m_preview.pixels.data(), m_preview.pixels.size() * sizeof(uint32_t));
+
+    // Not created on the backend yet: the creation uploads everything anyway
+    if (tex->Status == ImTextureStatus_WantCreate)
+        return;
+    ImTextureRect rect = {0, 0, (unsigned short)tex->Width, (unsigned short)tex->Height};
+    tex->Updates.resize(0);
+    tex->Updates.push_back(rect);
+    tex->UpdateRect = rect;
+    tex->SetStatus(ImTextureStatus_WantUpdates);
+}
+
+void EditorTool::RetireTexture()
+{
+    if (m_texture)
+        m_retiredTextures.push_back(std::move(m_texture));
+}
+
+bool EditorTool::ReleaseRetiredTextures()
+{
+    std::erase_if(m_retiredTextures, ReleaseToolTexture);
+    return m_retiredTextures.empty();
+}
+
+void EditorTool::Render(bool *open)
+{
+    // Text formatting without string allocations
+    char label[96];
+
+    ReleaseRetiredTextures();
+
+    ImGui::SetNextWindowSize(ImVec2(700, 820), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Editor", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const std::vector<CaptureEntry> &entries = m_history.GetEntries();
+    ImGui::BeginDisabled(entries.empty());
+    if (ImGui::Button("Open latest capture"))
+        Open(entries.back().id);
+    ImGui::EndDisabled();
+    if (m_status[0] != '\0')
+        ImGui::TextWrapped("%s", m_status);
+
+    if (m_file.image.IsEmpty())
+    {
+        ImGui::TextUnformatted(entries.empty() ? "Take a capture first (File > Capture Desktop)" : "No capture open");
+        ImGui::End();
+        return;
+    }
+
+    snprintf(label, sizeof(label), "%d x %d, undo history %.1f MB in %zu steps", m_file.image.width, m_file.image.height,
+             m_undo.GetMemoryBytes() / (1024.0 * 1024.0), m_undo.GetStepCount());
+    ImGui::TextUnformatted(label);
+
+    ImGui::InputInt4("Region (x, y, w, h)", m_region);
+    const char *modes[] = {"Fill", "Pixelate"};
+    ImGui::Combo("Mode", &m_mode, modes, 2);
+    if (m_mode == (int)Imaging::RedactMode::Pixelate)
+        ImGui::SliderInt("Block size", &m_blockSize, 2, 64);
+
+    if (ImGui::Button("Redact"))
+        Redact();
+    ImGui::SameLine();
+    if (ImGui::Button("Crop"))
+        Crop();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!m_undo.CanUndo());
+    snprintf(label, sizeof(label), "Undo %s###undo", m_undo.GetUndoLabel().c_str());
+    if (ImGui::Button(label))
+        Undo();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!m_undo.CanRedo());
+    snprintf(label, sizeof(label), "Redo %s###redo", m_undo.GetRedoLabel().c_str());
+    if (ImGui::Button(label))
+        Redo();
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    if (ImGui::Button("Save"))
+        Save();
+
+    if (m_previewDirty)
+        UpdatePreview();
+    if (m_texture)
+    {
+        ImGui::Separator();
+        ImGui::Image(m_texture->GetTexRef(), ImVec2((float)m_texture->Width, (float)m_texture->Height));
+    }
+    ImGui::End();
+}
\ No newline at end of file
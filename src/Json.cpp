@@ -0,0 +1,207 @@
+#include "Json.h"
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+
+const JsonValue *JsonValue::Find(const std::string &key) const
+{
+    for (const auto &member : members)
+    {
+        if (member.first == key)
+            return &member.second;
+    }
+    return nullptr;
+}
+
+double JsonValue::GetNumber(const std::string &key, double fallback) const
+{
+    const JsonValue *value = Find(key);
+    return value != nullptr && value->type == Type::Number ? value->number : fallback;
+}
+
+std::string JsonValue::GetString(const std::string &key, const std::string &fallback) const
+{
+    const JsonValue *value = Find(key);
+    return value != nullptr && value->type == Type::String ? value->text : fallback;
+}
+
+bool JsonReader::Parse(JsonValue &value)
+{
+    m_pos = 0;
+    if (!ParseValue(value, 0))
+        return false;
+    SkipSpace();
+    return m_pos == m_text.size();
+}
+
+bool JsonReader::ParseValue(JsonValue &value, int depth)
+{
+    // Nesting limit keeps malformed input from exhausting the stack
+    if (depth > 64)
+        return false;
+
+    SkipSpace();
+    if (m_pos >= m_text.size())
+        return false;
+
+    char c = m_text[m_pos];
+    if (c == '{')
+    {
+        m_pos++;
+        value.type = JsonValue::Type::Object;
+        if (Expect('}'))
+            return true;
+        do
+        {
+            SkipSpace();
+            std::string key;
+            if (!ParseString(key) || !Expect(':'))
+                return false;
+            JsonValue member;
+            if (!ParseValue(member, depth + 1))
+                return false;
+            value.members.emplace_back(std::move(key), std::move(member));
+        } while (Expect(','));
+        return Expect('}');
+    }
+    if (c == '[')
+    {
+        m_pos++;
+        value.type = JsonValue::Type::Array;
+        if (Expect(']'))
+            return true;
+        do
+        {
+            JsonValue item;
+            if (!ParseValue(item, depth + 1))
+                return false;
+            value.items.push_back(std::move(item));
+        } while (Expect(','));
+        return Expect(']');
+    }
+    if (c == '"')
+    {
+        value.type = JsonValue::Type::String;
+        return ParseString(value.text);
+    }
+    if (c == 't' || c == 'f')
+    {
+        value.type = JsonValue::Type::Bool;
+        value.boolean = c == 't';
+        return ParseLiteral(value.boolean ? "true" : "false");
+    }
+    if (c == 'n')
+        return ParseLiteral("null");
+
+    char *end = nullptr;
+    value.type = JsonValue::Type::Number;
+    value.number = strtod(m_text.c_str() + m_pos, &end);
+    if (end == m_text.c_str() + m_pos)
+        return false;
+    m_pos = end - m_text.c_str();
+    return true;
+}
+
+bool JsonReader::ParseString(std::string &out)
+{
+    if (!Peek('"'))
+        return false;
+
+    out.clear();
+    while (m_pos < m_text.size())
+    {
+        char c = m_text[m_pos++];
+        if (c == '"')
+            return true;
+        if (c != '\\')
+        {
+            out += c;
+            continue;
+        }
+        if (m_pos >= m_text.size())
+            return false;
+
+        char escape = m_text[m_pos++];
+        switch (escape)
+        {
+        case 'b':
+            out += '\b';
+            break;
+        case 'f':
+            out += '\f';
+            break;
+        case 'n':
+            out += '\n';
+            break;
+        case 'r':
+            out += '\r';
+            break;
+        case 't':
+            out += '\t';
+            break;
+        case 'u':
+        {
+            // Basic multilingual plane only, encoded as UTF-8
+            if (m_pos + 4 > m_text.size())
+                return false;
+            char hex[5] = {m_text[m_pos], m_text[m_pos + 1], m_text[m_pos + 2], m_text[m_pos + 3], 0};
+            char *end = nullptr;
+            unsigned long code = strtoul(hex, &end, 16);
+            if (end != hex + 4)
+                return false;
+            m_pos += 4;
+            if (code < 0x80)
+            {
+                out += (char)code;
+            }
+            else if (code < 0x800)
+            {
+                out += (char)(0xC0 | (code >> 6));
+                out += (char)(0x80 | (code & 0x3F));
+            }
+            else
+            {
+                out += (char)(0xE0 | (code >> 12));
+                out += (char)(0x80 | ((code >> 6) & 0x3F));
+                out += (char)(0x80 | (code & 0x3F));
+            }
+            break;
+        }
+        default: // '"', '\\' and '/'
+            out += escape;
+            break;
+        }
+    }
+    return false;
+}
+
+bool JsonReader::ParseLiteral(const char *literal)
+{
+    size_t length = strlen(literal);
+    if (m_text.compare(m_pos, length, literal) != 0)
+        return false;
+    m_pos += length;
+    return true;
+}
+
+void JsonReader::SkipSpace()
+{
+    while (m_pos < m_text.size() && isspace((unsigned char)m_text[m_pos]))
+        m_pos++;
+}
+
+bool JsonReader::Peek(char c)
+{
+    if (m_pos < m_text.size() && m_text[m_pos] == c)
+    {
+        m_pos++;
+        return true;
+    }
+    return false;
+}
+
+bool JsonReader::Expect(char c)
+{
+    SkipSpace();
+    return Peek(c);
+}
\ No newline at end of file
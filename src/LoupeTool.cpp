@@ -0,0 +1,187 @@
+#include "LoupeTool.h"
+#include "Profiler.h"
+#include "imgui_internal.h"
+#include <algorithm>
+#include <cstdio>
+
+LoupeTool::LoupeTool(Platform::IPlatform &platform)
+    : m_platform(platform), m_cursorX(0), m_cursorY(0), m_available(true), m_frozen(false), m_uploadBytes(0), m_line{}, m_hex{}
+{
+    // The texture's bytes already show up in the renderer's texture total, so this source only
+    // adds the eviction hook; the next visible frame grabs and uploads it again
+    m_textureMemory.Register("Loupe texture", MemoryKind::Gpu, nullptr, [this](size_t)
+                             {
+                                 if (!m_texture || m_texture->Status == ImTextureStatus_WantDestroy)
+                                     return (size_t)0;
+                                 size_t bytes = (size_t)m_texture->Width * m_texture->Height * m_texture->BytesPerPixel;
+                                 ReleaseResources();
+                                 return bytes; });
+}
+
+LoupeTool::~LoupeTool()
+{
+    // The renderer's shutdown frees the GPU copy of every registered texture
+    if (m_texture && ImGui::GetCurrentContext() != nullptr)
+        ImGui::UnregisterUserTexture(m_texture.get());
+}
+
+bool LoupeTool::ReleaseResources()
+{
+    m_grab = Imaging::Image();
+    m_shown = Imaging::Image();
+    return ReleaseToolTexture(m_texture);
+}
+
+void LoupeTool::Render(bool *open)
+{
+    ImGui::SetNextWindowSize(ImVec2(0, 0), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Loupe", open, ImGuiWindowFlags_AlwaysAutoResize))
+    {
+        ImGui::End();
+        return;
+    }
+
+    // Grab only while the window is visible. The upload itself happens in the renderer and is
+    // reported per texture in the renderer stats overlay.
+    {
+        ProfileScope scope("Loupe grab + diff");
+        m_uploadBytes = 0;
+        if (!m_frozen && m_platform.GetGlobalMousePosition(m_cursorX, m_cursorY))
+        {
+            m_available = m_platform.GrabScreenRegion(m_cursorX - GRAB_SIZE / 2, m_cursorY - GRAB_SIZE / 2, GRAB_SIZE, GRAB_SIZE, m_grab);
+            if (m_available)
+                UpdateTexture();
+        }
+    }
+
+    if (!m_texture || m_shown.IsEmpty())
+    {
+        ImGui::TextUnformatted(m_available ? "Waiting for the first grab" : "Screen capture is not available in this session");
+        ImGui::End();
+        return;
+    }
+
+    float size = (float)(GRAB_SIZE * ZOOM);
+    ImVec2 origin = ImGui::GetCursorScreenPos();
+    ImGui::Image(m_texture->GetTexRef(), ImVec2(size, size));
+
+    // Outline the picked pixel, in both black and white so it shows on any color
+    ImDrawList *drawList = ImGui::GetWindowDrawList();
+    ImVec2 cellMin(origin.x + (GRAB_SIZE / 2) * ZOOM, origin.y + (GRAB_SIZE / 2) * ZOOM);
+    ImVec2 cellMax(cellMin.x + ZOOM, cellMin.y + ZOOM);
+    drawList->AddRect(ImVec2(cellMin.x - 1, cellMin.y - 1), ImVec2(cellMax.x + 1, cellMax.y + 1), IM_COL32(0, 0, 0, 255));
+    drawList->AddRect(cellMin, cellMax, IM_COL32(255, 255, 255, 255));
+
+    uint32_t pixel = m_shown.Row(GRAB_SIZE / 2)[GRAB_SIZE / 2];
+    int r = (int)(pixel & 0xFF);
+    int g = (int)((pixel >> 8) & 0xFF);
+    int b = (int)((pixel >> 16) & 0xFF);
+    float h, s, v;
+    ImGui::ColorConvertRGBtoHSV(r / 255.0f, g / 255.0f, b / 255.0f, h, s, v);
+
+    ImGui::ColorButton("##picked", ImVec4(r / 255.0f, g / 255.0f, b / 255.0f, 1.0f), ImGuiColorEditFlags_NoTooltip, ImVec2(40, 40));
+    ImGui::SameLine();
+    ImGui::BeginGroup();
+    snprintf(m_hex, sizeof(m_hex), "#%02X%02X%02X", r, g, b);
+    snprintf(m_line, sizeof(m_line), "%s   at %d, %d", m_hex, m_cursorX, m_cursorY);
+    ImGui::TextUnformatted(m_line);
+    snprintf(m_line, sizeof(m_line), "RGB %d, %d, %d", r, g, b);
+    ImGui::TextUnformatted(m_line);
+    snprintf(m_line, sizeof(m_line), "HSV %.0f, %.0f%%, %.0f%%", h * 360.0f, s * 100.0f, v * 100.0f);
+    ImGui::TextUnformatted(m_line);
+    ImGui::EndGroup();
+
+    if (ImGui::Button("Copy hex"))
+        ImGui::SetClipboardText(m_hex);
+    ImGui::SameLine();
+    ImGui::Checkbox("Freeze", &m_frozen);
+    snprintf(m_line, sizeof(m_line), "Texture #%d: %zu bytes queued for upload", m_texture->UniqueID, m_uploadBytes);
+    ImGui::TextDisabled("%s", m_line);
+
+    ImGui::End();
+}
+
+void LoupeTool::UpdateTexture()
+{
+    // Reopened while a release is still in flight: finish it before creating a new texture
+    if (m_texture && m_texture->Status == ImTextureStatus_WantDestroy)
+        return;
+    if (m_texture && m_texture->Status == ImTextureStatus_Destroyed)
+        ReleaseResources();
+
+    if (!m_texture)
+    {
+        m_texture = std::make_unique<ImTextureData>();
+        m_texture->Create(ImTextureFormat_RGBA32, GRAB_SIZE * ZOOM, GRAB_SIZE * ZOOM);
+        ImGui::RegisterUserTexture(m_texture.get());
+        m_shown = m_grab;
+        WriteCells(0, 0, GRAB_SIZE, GRAB_SIZE);
+        m_uploadBytes = (size_t)m_texture->Width * m_texture->Height * 4;
+        return;
+    }
+
+    // Bounding box of the cells that changed since the texture was last written
+    int x0 = GRAB_SIZE, y0 = GRAB_SIZE, x1 = 0, y1 = 0;
+    for (int y = 0; y < GRAB_SIZE; y++)
+    {
+        const uint32_t *grabbed = m_grab.Row(y);
+        uint32_t *shown = m_shown.Row(y);
+        for (int x = 0; x < GRAB_SIZE; x++)
+        {
+            if (grabbed[x] == shown[x])
+                continue;
+            shown[x] = grabbed[x];
+            x0 = std::min(x0, x);
+            y0 = std::min(y0, y);
+            x1 = std::max(x1, x + 1);
+            y1 = std::max(y1, y + 1);
+        }
+    }
+    if (x1 <= x0)
+        return;
+
+    WriteCells(x0, y0, x1, y1);
+    ImTextureRect rect = {(unsigned short)(x0 * ZOOM), (unsigned short)(y0 * ZOOM), (unsigned short)((x1 - x0) * ZOOM), (unsigned short)((y1 - y0) * ZOOM)};
+    m_uploadBytes = (size_t)rect.w * rect.h * 4;
+
+    // Not created on the backend yet: the creation uploads everything anyway
+    ImTextureData *tex = m_texture.get();
+    if (tex->Status == ImTextureStatus_WantCreate)
+        return;
+
+    // Updates the backend already applied are cleared here, since ImGui only does that for atlases
+    if (tex->Status == ImTextureStatus_OK)
+    {
+        tex->Updates.resize(0);
+        tex->UpdateRect = rect;
+    }
+    else
+    {
+        unsigned short right = std::max<unsigned short>(tex->UpdateRect.x + tex->UpdateRect.w, rect.x + rect.w);
+        unsigned short bottom = std::max<unsigned short>(tex->UpdateRect.y + tex->UpdateRect.h, rect.y + rect.h);
+        tex->UpdateRect.x = std::min(tex->UpdateRect.x, rect.x);
+        tex->UpdateRect.y = std::min(tex->UpdateRect.y, rect.y);
+        tex->UpdateRect.w = right - tex->UpdateRect.x;
+        tex->UpdateRect.h = bottom - tex->UpdateRect.y;
+    }
+    tex->Updates.push_back(rect);
+    tex->SetStatus(ImTextureStatus_WantUpdates);
+}
+
+void LoupeTool::WriteCells(int x0, int y0, int x1, int y1)
+{
+    // Nearest-neighbour upscale of the changed cells into the texture
+    for (int y = y0; y < y1; y++)
+    {
+        const uint32_t *cells = m_shown.Row(y);
+        for (int zy = 0; zy < ZOOM; zy++)
+        {
+            uint32_t *dst = reinterpret_cast<uint32_t *>(m_texture->GetPixelsAt(x0 * ZOOM, y * ZOOM + zy));
+            for (int x = x0; x < x1; x++)
+            {
+                std::fill_n(dst, ZOOM, cells[x]);
+                dst += ZOOM;
+            }
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,298 @@
+#include "MemoryTracker.h"
+#include "imgui.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#include <psapi.h>
+#elif defined(__APPLE__)
+#include <mach/mach.h>
+#elif defined(__linux__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace
+{
+    constexpr std::chrono::milliseconds SAMPLE_INTERVAL(500);
+    constexpr std::chrono::seconds EVICTION_BACKOFF(5);
+
+    // Every ImGui allocation carries its size in a header, which keeps the payload 16-byte aligned.
+    // Blocks come from whichever allocator was installed before ours, e.g. the benchmark's.
+    constexpr size_t IMGUI_HEADER_SIZE = 16;
+    std::atomic<size_t> s_imguiBytes(0);
+    bool s_imguiAllocatorInstalled = false;
+    ImGuiMemAllocFunc s_previousAlloc = nullptr;
+    ImGuiMemFreeFunc s_previousFree = nullptr;
+    void *s_previousUserData = nullptr;
+
+    void *ImGuiAlloc(size_t size, void *)
+    {
+        unsigned char *block = (unsigned char *)s_previousAlloc(size + IMGUI_HEADER_SIZE, s_previousUserData);
+        if (block == nullptr)
+            return nullptr;
+        memcpy(block, &size, sizeof(size));
+        s_imguiBytes += size;
+        return block + IMGUI_HEADER_SIZE;
+    }
+
+    void ImGuiFree(void *ptr, void *)
+    {
+        if (ptr == nullptr)
+            return;
+        unsigned char *block = (unsigned char *)ptr - IMGUI_HEADER_SIZE;
+        size_t size;
+        memcpy(&size, block, sizeof(size));
+        s_imguiBytes -= size;
+        s_previousFree(block, s_previousUserData);
+    }
+
+    // glibc keeps freed pages mapped; without this an eviction rarely shows up in RSS
+    void ReturnFreedHeapToOS()
+    {
+#if defined(__GLIBC__)
+        malloc_trim(0);
+#endif
+    }
+}
+
+MemoryTracker &MemoryTracker::Get()
+{
+    static MemoryTracker tracker;
+    return tracker;
+}
+
+MemoryTracker::MemoryTracker()
+    : m_nextId(1), m_residentBudget(0), m_gpuBudget(0), m_residentBytes(0), m_peakResidentBytes(0),
+      m_trackedHeapBytes(0), m_trackedGpuBytes(0), m_evictionCount(0), m_sampleCount(0)
+{
+}
+
+int MemoryTracker::Register(const std::string &name, MemoryKind kind, MeasureFn measure, EvictFn evict, int priority)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    int id = m_nextId++;
+    m_sources.push_back({id, name, kind, std::move(measure), std::move(evict), priority, 0, 0});
+    return id;
+}
+
+void MemoryTracker::Unregister(int id)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sources.erase(std::remove_if(m_sources.begin(), m_sources.end(), [id](const Source &source)
+                                   { return source.id == id; }),
+                    m_sources.end());
+    m_stats.erase(std::remove_if(m_stats.begin(), m_stats.end(), [id](const MemorySourceStats &stats)
+                                 { return stats.id == id; }),
+                  m_stats.end());
+}
+
+void MemoryTracker::SetBudgets(size_t residentBytes, size_t gpuBytes)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_residentBudget = residentBytes;
+    m_gpuBudget = gpuBytes;
+    m_evictionBackoff = std::chrono::steady_clock::time_point();
+}
+
+void MemoryTracker::Update()
+{
+    auto now = std::chrono::steady_clock::now();
+    if (now < m_nextSample)
+        return;
+    m_nextSample = now + SAMPLE_INTERVAL;
+    Sample();
+}
+
+void MemoryTracker::Sample()
+{
+    size_t heapWanted = 0;
+    size_t gpuWanted = 0;
+    auto now = std::chrono::steady_clock::now();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_residentBytes = ReadResidentBytes();
+        RefreshStats();
+
+        // Evict down to 90% of the budget, so usage hovering at the limit does not evict every sample
+        if (now >= m_evictionBackoff)
+        {
+            if (m_residentBudget != 0 && m_residentBytes > m_residentBudget)
+                heapWanted = m_residentBytes - m_residentBudget / 10 * 9;
+            if (m_gpuBudget != 0 && m_trackedGpuBytes > m_gpuBudget)
+                gpuWanted = m_trackedGpuBytes - m_gpuBudget / 10 * 9;
+        }
+    }
+
+    size_t freed = 0;
+    if (heapWanted > 0)
+    {
+        size_t released = Evict(MemoryKind::Heap, heapWanted);
+        if (released > 0)
+            ReturnFreedHeapToOS();
+        freed += released;
+    }
+    if (gpuWanted > 0)
+        freed += Evict(MemoryKind::Gpu, gpuWanted);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if ((heapWanted > 0 || gpuWanted > 0) && freed == 0)
+    {
+        m_evictionBackoff = now + EVICTION_BACKOFF;
+    }
+    else if (freed > 0)
+    {
+        m_evictionCount++;
+        m_residentBytes = ReadResidentBytes();
+        RefreshStats();
+    }
+    m_peakResidentBytes = std::max(m_peakResidentBytes, m_residentBytes);
+    m_sampleCount++;
+}
+
+size_t MemoryTracker::EvictAll(MemoryKind kind)
+{
+    size_t freed = Evict(kind, SIZE_MAX);
+    if (freed > 0 && kind == MemoryKind::Heap)
+        ReturnFreedHeapToOS();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_residentBytes = ReadResidentBytes();
+    RefreshStats();
+    return freed;
+}
+
+size_t MemoryTracker::Evict(MemoryKind kind, size_t bytesWanted)
+{
+    // Callbacks run without the lock held: releasing a cache may well unregister a source or
+    // register a smaller one, which would deadlock on the non-recursive mutex
+    struct Candidate
+    {
+        int id;
+        int priority;
+        EvictFn evict;
+        size_t released;
+    };
+    std::vector<Candidate> candidates;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const Source &source : m_sources)
+        {
+            if (source.kind == kind && source.evict)
+                candidates.push_back({source.id, source.priority, source.evict, 0});
+        }
+    }
+    std::stable_sort(candidates.begin(), candidates.end(), [](const Candidate &a, const Candidate &b)
+                     { return a.priority < b.priority; });
+
+    size_t freed = 0;
+    for (Candidate &candidate : candidates)
+    {
+        if (freed >= bytesWanted)
+            break;
+
+        // An earlier callback may have unregistered this source, and its owner may be gone
+        bool registered;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            registered = std::any_of(m_sources.begin(), m_sources.end(), [&](const Source &source)
+                                     { return source.id == candidate.id; });
+        }
+        if (!registered)
+            continue;
+        candidate.released = candidate.evict(bytesWanted - freed);
+        freed += candidate.released;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const Candidate &candidate : candidates)
+    {
+        if (candidate.released == 0)
+            continue;
+        for (Source &source : m_sources)
+        {
+            if (source.id == candidate.id)
+                source.evictedBytes += candidate.released;
+        }
+    }
+    return freed;
+}
+
+void MemoryTracker::RefreshStats()
+{
+    m_trackedHeapBytes = 0;
+    m_trackedGpuBytes = 0;
+    m_stats.resize(m_sources.size());
+    for (size_t i = 0; i < m_sources.size(); i++)
+    {
+        Source &source = m_sources[i];
+        size_t bytes = source.measure ? source.measure() : 0;
+        source.peakBytes = std::max(source.peakBytes, bytes);
+        (source.kind == MemoryKind::Heap ? m_trackedHeapBytes : m_trackedGpuBytes) += bytes;
+
+        MemorySourceStats &stats = m_stats[i];
+        stats.id = source.id;
+        stats.name = source.name;
+        stats.kind = source.kind;
+        stats.evictable = (bool)source.evict;
+        stats.bytes = bytes;
+        stats.peakBytes = source.peakBytes;
+        stats.evictedBytes = source.evictedBytes;
+    }
+}
+
+size_t MemoryTracker::ReadResidentBytes()
+{
+#if defined(_WIN32)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return counters.WorkingSetSize;
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS)
+        return info.resident_size;
+    return 0;
+#elif defined(__linux__)
+    // Second field of statm is the resident page count; a plain read keeps this cheap
+    int fd = open("/proc/self/statm", O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return 0;
+    char buffer[128];
+    ssize_t length = read(fd, buffer, sizeof(buffer) - 1);
+    close(fd);
+    if (length <= 0)
+        return 0;
+    buffer[length] = '\0';
+
+    unsigned long long totalPages = 0;
+    unsigned long long residentPages = 0;
+    if (sscanf(buffer, "%llu %llu", &totalPages, &residentPages) != 2)
+        return 0;
+    return (size_t)residentPages * (size_t)sysconf(_SC_PAGESIZE);
+#else
+    return 0;
+#endif
+}
+
+void MemoryTracker::InstallImGuiAllocator()
+{
+    // Switching allocators under a live context would free its blocks with the wrong function
+    if (s_imguiAllocatorInstalled || ImGui::GetCurrentContext() != nullptr)
+        return;
+
+    ImGui::GetAllocatorFunctions(&s_previousAlloc, &s_previousFree, &s_previousUserData);
+    ImGui::SetAllocatorFunctions(ImGuiAlloc, ImGuiFree);
+    Get().Register("ImGui", MemoryKind::Heap, []()
+                   { return s_imguiBytes.load(std::memory_order_relaxed); });
+    s_imguiAllocatorInstalled = true;
+}
\ No newline at end of file
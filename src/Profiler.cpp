@@ -0,0 +1,47 @@
+#include "Profiler.h"
+#include <cstring>
+
+Profiler &Profiler::Get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+Profiler::Profiler() : m_scopeCount(0), m_historyIndex(0) {}
+
+void Profiler::AddSample(const char *name, double milliseconds)
+{
+    for (int i = 0; i < m_scopeCount; i++)
+    {
+        Scope &scope = m_scopes[i];
+        if (scope.stats.name == name || strcmp(scope.stats.name, name) == 0)
+        {
+            scope.currentMs += milliseconds;
+            scope.currentCalls++;
+            return;
+        }
+    }
+
+    // Fixed table, so profiling never allocates; scopes beyond the limit are ignored
+    if (m_scopeCount == MAX_SCOPES)
+        return;
+    Scope &scope = m_scopes[m_scopeCount++];
+    scope.stats.name = name;
+    scope.currentMs = milliseconds;
+    scope.currentCalls = 1;
+}
+
+void Profiler::EndFrame()
+{
+    for (int i = 0; i < m_scopeCount; i++)
+    {
+        Scope &scope = m_scopes[i];
+        scope.stats.lastMs = scope.currentMs;
+        scope.stats.lastCalls = scope.currentCalls;
+        scope.stats.averageMs += (scope.currentMs - scope.stats.averageMs) * 0.05;
+        scope.stats.history[m_historyIndex] = (float)scope.currentMs;
+        scope.currentMs = 0.0;
+        scope.currentCalls = 0;
+    }
+    m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include "ThreadPool.h"
+#include <algorithm>
+
+ThreadPool::ThreadPool(int threadCount)
+    : m_job(nullptr), m_nextIndex(0), m_count(0), m_busyWorkers(0), m_generation(0), m_stop(false)
+{
+    if (threadCount <= 0)
+    {
+        threadCount = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    for (int i = 1; i < threadCount; i++)
+    {
+        m_workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(int count, const std::function<void(int)> &fn)
+{
+    if (count <= 0)
+        return;
+
+    // Not worth waking anyone for a single item
+    if (count == 1 || m_workers.empty())
+    {
+        for (int i = 0; i < count; i++)
+            fn(i);
+        return;
+    }
+
+    std::lock_guard<std::mutex> callLock(m_callMutex);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_nextIndex.store(0, std::memory_order_relaxed);
+        m_busyWorkers = (int)m_workers.size();
+        m_generation++;
+    }
+    m_wake.notify_all();
+
+    RunItems();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this]()
+                { return m_busyWorkers == 0; });
+    m_job = nullptr;
+}
+
+void ThreadPool::Post(std::function<void()> task)
+{
+    if (m_workers.empty())
+    {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::RunItems()
+{
+    for (;;)
+    {
+        int index = m_nextIndex.fetch_add(1, std::memory_order_relaxed);
+        if (index >= m_count)
+            break;
+        (*m_job)(index);
+    }
+}
+
+void ThreadPool::WorkerLoop()
+{
+    uint64_t seenGeneration = 0;
+    for (;;)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this, seenGeneration]()
+                        { return m_stop || m_generation != seenGeneration || !m_tasks.empty(); });
+            // A waiting ParallelFor caller goes first, then queued tasks, which are drained
+            // before stopping
+            if (m_generation == seenGeneration)
+            {
+                if (m_tasks.empty())
+                    return;
+                task = std::move(m_tasks.front());
+                m_tasks.pop_front();
+            }
+            seenGeneration = m_generation;
+        }
+
+        if (task)
+        {
+            task();
+            continue;
+        }
+
+        RunItems();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_busyWorkers--;
+        }
+        m_done.notify_one();
+    }
+}
\ No newline at end of file
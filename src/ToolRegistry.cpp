@@ -0,0 +1,127 @@
+#include "ToolRegistry.h"
+#include "Profiler.h"
+#include "imgui_internal.h"
+#include <cstring>
+
+bool ReleaseToolTexture(std::unique_ptr<ImTextureData> &texture)
+{
+    if (!texture)
+        return true;
+
+    // A texture the backend owns is handed back first; it is freed on the next render
+    ImTextureData *tex = texture.get();
+    if (tex->Status != ImTextureStatus_WantCreate && tex->Status != ImTextureStatus_Destroyed)
+    {
+        if (tex->Status != ImTextureStatus_WantDestroy)
+        {
+            tex->SetStatus(ImTextureStatus_WantDestroy);
+            tex->UnusedFrames = 1;
+        }
+        return false;
+    }
+
+    ImGui::UnregisterUserTexture(tex);
+    texture.reset();
+    return true;
+}
+
+void ToolRegistry::Register(ToolDescriptor descriptor)
+{
+    Entry entry;
+    entry.open = descriptor.openAtStartup;
+    entry.descriptor = std::move(descriptor);
+    m_entries.push_back(std::move(entry));
+}
+
+void ToolRegistry::Clear()
+{
+    // Later tools may use earlier ones' data, so tear down newest first
+    while (!m_entries.empty())
+        m_entries.pop_back();
+}
+
+ToolRegistry::Entry *ToolRegistry::Find(const char *name)
+{
+    for (Entry &entry : m_entries)
+    {
+        if (strcmp(entry.descriptor.name, name) == 0)
+            return &entry;
+    }
+    return nullptr;
+}
+
+const ToolRegistry::Entry *ToolRegistry::Find(const char *name) const
+{
+    return const_cast<ToolRegistry *>(this)->Find(name);
+}
+
+void ToolRegistry::SetOpen(const char *name, bool open)
+{
+    Entry *entry = Find(name);
+    if (entry != nullptr)
+        entry->open = open;
+}
+
+bool ToolRegistry::IsOpen(const char *name) const
+{
+    const Entry *entry = Find(name);
+    return entry != nullptr && entry->open;
+}
+
+ITool *ToolRegistry::Acquire(const char *name)
+{
+    Entry *entry = Find(name);
+    if (entry == nullptr)
+        return nullptr;
+    if (!entry->tool)
+        entry->tool = entry->descriptor.create();
+    return entry->tool.get();
+}
+
+int ToolRegistry::GetConstructedCount() const
+{
+    int count = 0;
+    for (const Entry &entry : m_entries)
+    {
+        if (entry.tool)
+            count++;
+    }
+    return count;
+}
+
+void ToolRegistry::RenderMenuItems()
+{
+    for (Entry &entry : m_entries)
+        ImGui::MenuItem(entry.descriptor.name, nullptr, &entry.open);
+}
+
+void ToolRegistry::Update()
+{
+    for (Entry &entry : m_entries)
+    {
+        if (entry.tool)
+            entry.tool->Update();
+    }
+}
+
+void ToolRegistry::Render(double now)
+{
+    for (Entry &entry : m_entries)
+    {
+        if (entry.open)
+        {
+            ProfileScope scope(entry.descriptor.name);
+            if (!entry.tool)
+                entry.tool = entry.descriptor.create();
+            entry.tool->Render(&entry.open);
+            entry.holdsResources = true;
+            // Once closed, this is the last frame it was shown
+            entry.closedAt = now;
+            continue;
+        }
+
+        // Closed: keep the resources for a while in case the tool is reopened soon
+        if (entry.holdsResources && entry.descriptor.releaseAfterSeconds >= 0.0 && now - entry.closedAt >= entry.descriptor.releaseAfterSeconds)
+            entry.holdsResources = !entry.tool->ReleaseResources();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,353 @@
+#include "Tools.h"
+#include "MemoryTracker.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
+#include <cstdio>
+
+DemoTool::DemoTool(const float &averageFrameTimeMs)
+    : m_averageFrameTimeMs(averageFrameTimeMs), m_value(0.0f), m_counter(0), m_clearColor(0.45f, 0.55f, 0.60f, 1.00f),
+      m_counterText{}, m_frameStats{}
+{
+}
+
+void DemoTool::Render(bool *open)
+{
+    ImGui::Begin("Snap Tools Demo", open);
+
+    // Use const char* for static text to avoid string operations
+    ImGui::TextUnformatted("Cross-Platform ImGui Application");
+    ImGui::Separator();
+
+    ImGui::TextUnformatted("This is a cross-platform application using:");
+    ImGui::BulletText("macOS: Cocoa + Metal");
+    ImGui::BulletText("Windows: Win32 + DirectX11");
+    ImGui::BulletText("Linux: SDL3 + OpenGL3");
+
+    ImGui::Separator();
+
+    ImGui::SliderFloat("Float Value", &m_value, 0.0f, 1.0f);
+    ImGui::ColorEdit3("Clear Color", (float *)&m_clearColor);
+
+    if (ImGui::Button("Click Me!"))
+    {
+        m_counter++;
+    }
+    ImGui::SameLine();
+
+    // Format text into pre-allocated buffer to avoid string allocations
+    snprintf(m_counterText, sizeof(m_counterText), "Counter = %d", m_counter);
+    ImGui::TextUnformatted(m_counterText);
+
+    // Use cached frame time instead of calling ImGui::GetIO() repeatedly
+    snprintf(m_frameStats, sizeof(m_frameStats),
+             "Application average %.3f ms/frame (%.1f FPS)",
+             m_averageFrameTimeMs, 1000.0f / m_averageFrameTimeMs);
+    ImGui::TextUnformatted(m_frameStats);
+
+    ImGui::End();
+}
+
+SettingsTool::SettingsTool() : m_vsync(true), m_samples(4) {}
+
+void SettingsTool::Render(bool *open)
+{
+    ImGui::Begin("Settings", open);
+
+    ImGui::Text("Application Settings");
+    ImGui::Separator();
+
+    ImGui::Checkbox("VSync", &m_vsync);
+    ImGui::SliderInt("MSAA Samples", &m_samples, 1, 16);
+
+    if (ImGui::Button("Apply Settings"))
+    {
+        // Apply settings
+    }
+
+    ImGui::End();
+}
+
+HistoryTool::HistoryTool(CaptureHistory &history)
+    : m_history(history), m_selectedCapture(0), m_similarDistance(CaptureHistory::SIMILAR_DISTANCE), m_queriedGeneration(0), m_queryDirty(false),
+      m_lastQueryUs(0.0), m_label{}
+{
+}
+
+void HistoryTool::SelectCapture(uint32_t id)
+{
+    m_selectedCapture = id;
+    m_queryDirty = true;
+}
+
+bool HistoryTool::ReleaseResources()
+{
+    std::vector<CaptureMatch>().swap(m_duplicates);
+    std::vector<CaptureMatch>().swap(m_similar);
+    std::vector<uint32_t>().swap(m_removeIds);
+    m_queryDirty = true;
+    return true;
+}
+
+void HistoryTool::Render(bool *open)
+{
+    ImGui::SetNextWindowSize(ImVec2(760, 440), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Capture History", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+    bool dedup = m_history.GetDedupOnSave();
+    if (ImGui::Checkbox("Skip near-duplicates when saving", &dedup))
+        m_history.SetDedupOnSave(dedup);
+
+    const std::vector<CaptureEntry> &entries = m_history.GetEntries();
+    snprintf(m_label, sizeof(m_label), "%zu captures", entries.size());
+    ImGui::SameLine();
+    ImGui::TextUnformatted(m_label);
+    ImGui::Separator();
+
+    // Capture list, clipped so large histories only lay out the visible rows
+    ImGui::BeginChild("##captures", ImVec2(ImGui::GetContentRegionAvail().x * 0.5f, 0), ImGuiChildFlags_Borders);
+    ImGuiListClipper clipper;
+    clipper.Begin((int)entries.size());
+    while (clipper.Step())
+    {
+        for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+        {
+            const CaptureEntry &entry = entries[i];
+            snprintf(m_label, sizeof(m_label), "%s  %dx%d##%u", entry.path.c_str(), entry.width, entry.height, entry.id);
+            if (ImGui::Selectable(m_label, entry.id == m_selectedCapture))
+                SelectCapture(entry.id);
+        }
+    }
+    clipper.End();
+    ImGui::EndChild();
+
+    ImGui::SameLine();
+    ImGui::BeginChild("##matches", ImVec2(0, 0), ImGuiChildFlags_Borders);
+    const CaptureEntry *selected = m_history.Find(m_selectedCapture);
+    if (selected == nullptr)
+    {
+        ImGui::TextUnformatted("Select a capture to find duplicates and similar captures");
+    }
+    else
+    {
+        if (ImGui::SliderInt("Similarity (bits)", &m_similarDistance, 1, 24))
+            m_queryDirty = true;
+
+        // Queries only rerun when their inputs change, not every frame
+        if (m_queryDirty || m_queriedGeneration != m_history.GetGeneration())
+        {
+            auto start = std::chrono::steady_clock::now();
+            m_history.FindDuplicates(m_selectedCapture, m_duplicates);
+            m_history.FindSimilar(m_selectedCapture, m_similarDistance, m_similar);
+            m_lastQueryUs = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+            m_queriedGeneration = m_history.GetGeneration();
+            m_queryDirty = false;
+        }
+
+        snprintf(m_label, sizeof(m_label), "%s: %zu near-duplicates, %zu similar (%.0f us)",
+                 selected->path.c_str(), m_duplicates.size(), m_similar.size(), m_lastQueryUs);
+        ImGui::TextWrapped("%s", m_label);
+
+        if (!m_duplicates.empty())
+        {
+            snprintf(m_label, sizeof(m_label), "Remove %zu near-duplicates", m_duplicates.size());
+            if (ImGui::Button(m_label))
+            {
+                m_removeIds.clear();
+                for (const CaptureMatch &match : m_duplicates)
+                    m_removeIds.push_back(match.id);
+                m_history.Remove(m_removeIds);
+            }
+        }
+
+        uint32_t clicked = 0;
+        if (ImGui::CollapsingHeader("Near-duplicates", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            for (const CaptureMatch &match : m_duplicates)
+            {
+                const CaptureEntry *entry = m_history.Find(match.id);
+                if (entry == nullptr)
+                    continue;
+                snprintf(m_label, sizeof(m_label), "%2d bits  %s##dup%u", match.distance, entry->path.c_str(), match.id);
+                if (ImGui::Selectable(m_label))
+                    clicked = match.id;
+            }
+        }
+        if (ImGui::CollapsingHeader("Similar", ImGuiTreeNodeFlags_DefaultOpen))
+        {
+            for (const CaptureMatch &match : m_similar)
+            {
+                const CaptureEntry *entry = m_history.Find(match.id);
+                if (entry == nullptr)
+                    continue;
+                snprintf(m_label, sizeof(m_label), "%2d bits  %s##sim%u", match.distance, entry->path.c_str(), match.id);
+                if (ImGui::Selectable(m_label))
+                    clicked = match.id;
+            }
+        }
+        if (clicked != 0)
+            SelectCapture(clicked);
+    }
+    ImGui::EndChild();
+
+    ImGui::End();
+}
+
+MemoryTool::MemoryTool() : m_residentHistory{}, m_residentHistoryIndex(0), m_lastSample(0), m_line{} {}
+
+void MemoryTool::Update()
+{
+    const MemoryTracker &tracker = MemoryTracker::Get();
+    if (tracker.GetSampleCount() != m_lastSample)
+    {
+        m_lastSample = tracker.GetSampleCount();
+        m_residentHistory[m_residentHistoryIndex] = (float)(tracker.GetResidentBytes() / (1024.0 * 1024.0));
+        m_residentHistoryIndex = (m_residentHistoryIndex + 1) % HISTORY_SIZE;
+    }
+}
+
+void MemoryTool::Render(bool *open)
+{
+    constexpr double MB = 1024.0 * 1024.0;
+
+    ImGui::SetNextWindowSize(ImVec2(560, 420), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Memory", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+    MemoryTracker &tracker = MemoryTracker::Get();
+    size_t resident = tracker.GetResidentBytes();
+    size_t trackedHeap = tracker.GetTrackedBytes(MemoryKind::Heap);
+    snprintf(m_line, sizeof(m_line), "Resident %.1f MB (peak %.1f MB)", resident / MB, tracker.GetPeakResidentBytes() / MB);
+    ImGui::TextUnformatted(m_line);
+    // Whatever the sources do not account for: code, libraries, allocator slack and untracked subsystems
+    snprintf(m_line, sizeof(m_line), "Tracked heap %.1f MB | untracked %.1f MB | GPU %.1f MB", trackedHeap / MB,
+             resident > trackedHeap ? (resident - trackedHeap) / MB : 0.0, tracker.GetTrackedBytes(MemoryKind::Gpu) / MB);
+    ImGui::TextUnformatted(m_line);
+    ImGui::PlotLines("RSS MB", m_residentHistory, HISTORY_SIZE, m_residentHistoryIndex, nullptr, 0.0f, FLT_MAX, ImVec2(0, 60));
+
+    int residentBudget = (int)(tracker.GetResidentBudget() / (1024 * 1024));
+    int gpuBudget = (int)(tracker.GetGpuBudget() / (1024 * 1024));
+    ImGui::SetNextItemWidth(120);
+    bool budgetChanged = ImGui::InputInt("RSS budget (MB, 0 = off)", &residentBudget, 64, 256);
+    ImGui::SetNextItemWidth(120);
+    budgetChanged |= ImGui::InputInt("GPU budget (MB, 0 = off)", &gpuBudget, 64, 256);
+    if (budgetChanged)
+        tracker.SetBudgets((size_t)std::max(residentBudget, 0) * 1024 * 1024, (size_t)std::max(gpuBudget, 0) * 1024 * 1024);
+
+    if (ImGui::Button("Trim caches now"))
+    {
+        tracker.EvictAll(MemoryKind::Heap);
+        tracker.EvictAll(MemoryKind::Gpu);
+    }
+    snprintf(m_line, sizeof(m_line), "%d budget evictions", tracker.GetEvictionCount());
+    ImGui::SameLine();
+    ImGui::TextUnformatted(m_line);
+
+    if (ImGui::BeginTable("##memorysources", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("Source");
+        ImGui::TableSetupColumn("Kind");
+        ImGui::TableSetupColumn("MB");
+        ImGui::TableSetupColumn("Peak MB");
+        ImGui::TableSetupColumn("Evicted MB");
+        ImGui::TableHeadersRow();
+        for (const MemorySourceStats &source : tracker.GetSources())
+        {
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(source.name.c_str());
+            ImGui::TableNextColumn();
+            ImGui::TextUnformatted(source.kind == MemoryKind::Heap ? "Heap" : "GPU");
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", source.bytes / MB);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.2f", source.peakBytes / MB);
+            ImGui::TableNextColumn();
+            if (source.evictable)
+                ImGui::Text("%.2f", source.evictedBytes / MB);
+            else
+                ImGui::TextUnformatted("-");
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+ProfilerTool::ProfilerTool() : m_selectedScope(-1), m_line{} {}
+
+void ProfilerTool::Render(bool *open)
+{
+    ImGui::SetNextWindowSize(ImVec2(560, 380), ImGuiCond_FirstUseEver);
+    if (!ImGui::Begin("Profiler", open))
+    {
+        ImGui::End();
+        return;
+    }
+
+    const Profiler &profiler = Profiler::Get();
+    if (profiler.GetScopeCount() == 0)
+    {
+        ImGui::TextUnformatted("No scope has been timed yet");
+        ImGui::End();
+        return;
+    }
+
+    // History arrays are circular; the oldest frame sits at the profiler's next write position
+    int historyOffset = profiler.GetHistoryIndex();
+    if (ImGui::BeginTable("##scopes", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+    {
+        ImGui::TableSetupColumn("Scope");
+        ImGui::TableSetupColumn("ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Last frames", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableHeadersRow();
+        for (int i = 0; i < profiler.GetScopeCount(); i++)
+        {
+            const Profiler::ScopeStats &scope = profiler.GetScope(i);
+            ImGui::PushID(i);
+            ImGui::TableNextRow();
+            ImGui::TableNextColumn();
+            if (ImGui::Selectable(scope.name, m_selectedScope == i))
+                m_selectedScope = m_selectedScope == i ? -1 : i;
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.lastMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%.3f", scope.averageMs);
+            ImGui::TableNextColumn();
+            ImGui::Text("%d", scope.lastCalls);
+            ImGui::TableNextColumn();
+            ImGui::PlotLines("##history", scope.history, Profiler::HISTORY_SIZE, historyOffset, nullptr, 0.0f, FLT_MAX,
+                             ImVec2(-FLT_MIN, ImGui::GetTextLineHeight()));
+            ImGui::PopID();
+        }
+        ImGui::EndTable();
+    }
+
+    if (m_selectedScope >= 0 && m_selectedScope < profiler.GetScopeCount())
+    {
+        const Profiler::ScopeStats &scope = profiler.GetScope(m_selectedScope);
+        float peak = 0.0f;
+        for (float ms : scope.history)
+            peak = std::max(peak, ms);
+        snprintf(m_line, sizeof(m_line), "%s: peak %.3f ms over the last %d frames", scope.name, peak, Profiler::HISTORY_SIZE);
+        ImGui::TextUnformatted(m_line);
+        ImGui::PlotHistogram("##selected", scope.history, Profiler::HISTORY_SIZE, historyOffset, nullptr, 0.0f, FLT_MAX,
+                             ImVec2(-FLT_MIN, 120));
+    }
+    else
+    {
+        ImGui::TextDisabled("Select a scope to plot it");
+    }
+
+    ImGui::End();
+}
\ No newline at end of file
@@ -1,8 +1,20 @@
 #include "UIManager.h"
+#include "EditorTool.h"
+#include "LoupeTool.h"
+#include "Profiler.h"
+#include "Tools.h"
+#include "image/ImageCodec.h"
+#include "image/PerceptualHash.h"
+#include <chrono>
 #include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <utility>
 
 UIManager::UIManager()
-    : m_showDemo(true), m_showSettings(false), m_frameTimeBuffer{}, m_frameTimeIndex(0), m_avgFrameTime(16.67f) // 60 FPS initial
+    : m_platform(nullptr), m_savingBytes(0), m_canvasEvictions(0), m_lastCaptureMs(0), m_captureSequence(0), m_frameTimeBuffer{}, m_frameTimeIndex(0), m_avgFrameTime(16.67f), // 60 FPS initial
+      m_savePool(2)
 {
 }
 
@@ -11,34 +23,201 @@ UIManager::~UIManager()
     Shutdown();
 }
 
-void UIManager::Initialize()
+void UIManager::Initialize(Platform::IPlatform *platform)
 {
-    // UI manager initialization (no platform-specific code here)
+    // Only tools that read the desktop use the platform; the UI itself stays platform-agnostic
+    m_platform = platform;
+    m_historyMemory.Register("Capture history", MemoryKind::Heap, [this]()
+                             { return m_history.GetMemoryBytes(); });
+    // The canvas of a multi-monitor desktop is large and rebuilt by the next capture anyway
+    m_canvasMemory.Register("Desktop capture canvas", MemoryKind::Heap, [this]()
+                            { return m_desktopCanvas.pixels.capacity() * sizeof(uint32_t) + m_savingBytes.load(); }, [this](size_t)
+                            {
+                                size_t bytes = m_desktopCanvas.pixels.capacity() * sizeof(uint32_t);
+                                m_desktopCanvas = Imaging::Image();
+                                m_canvasEvictions++;
+                                return bytes; });
+    RegisterTools();
+}
+
+void UIManager::RegisterTools()
+{
+    // Nothing is constructed here; each tool is created the first time it is opened
+    ToolDescriptor demo;
+    demo.name = TOOL_DEMO;
+    demo.create = [this]()
+    { return std::make_unique<DemoTool>(m_avgFrameTime); };
+    demo.openAtStartup = true;
+    m_tools.Register(std::move(demo));
+
+    ToolDescriptor settings;
+    settings.name = TOOL_SETTINGS;
+    settings.create = []()
+    { return std::make_unique<SettingsTool>(); };
+    m_tools.Register(std::move(settings));
+
+    ToolDescriptor history;
+    history.name = TOOL_HISTORY;
+    history.create = [this]()
+    { return std::make_unique<HistoryTool>(m_history); };
+    history.releaseAfterSeconds = 30.0;
+    m_tools.Register(std::move(history));
+
+    // Closing the editor keeps the open capture and its undo steps, only the preview is released
+    ToolDescriptor editor;
+    editor.name = TOOL_EDITOR;
+    editor.create = [this]()
+    { return std::make_unique<EditorTool>(m_history); };
+    editor.releaseAfterSeconds = 30.0;
+    m_tools.Register(std::move(editor));
+
+    ToolDescriptor memory;
+    memory.name = TOOL_MEMORY;
+    memory.create = []()
+    { return std::make_unique<MemoryTool>(); };
+    m_tools.Register(std::move(memory));
+
+    ToolDescriptor profiler;
+    profiler.name = TOOL_PROFILER;
+    profiler.create = []()
+    { return std::make_unique<ProfilerTool>(); };
+    m_tools.Register(std::move(profiler));
+
+    // Screen tools need a platform that can read the desktop
+    if (m_platform != nullptr)
+    {
+        ToolDescriptor loupe;
+        loupe.name = TOOL_LOUPE;
+        loupe.create = [this]()
+        { return std::make_unique<LoupeTool>(*m_platform); };
+        loupe.releaseAfterSeconds = 5.0;
+        m_tools.Register(std::move(loupe));
+    }
 }
 
 void UIManager::Shutdown()
 {
     // UI manager cleanup
+    m_tools.Clear();
+    m_historyMemory.Reset();
+    m_canvasMemory.Reset();
 }
 
 void UIManager::Update()
 {
     // Update frame time statistics efficiently
     UpdateFrameStats();
+    CollectSavedCaptures();
+    m_tools.Update();
 }
 
 void UIManager::Render()
 {
     RenderMainMenuBar();
+    m_tools.Render(ImGui::GetTime());
+}
+
+void UIManager::SelectCapture(uint32_t id)
+{
+    HistoryTool *tool = static_cast<HistoryTool *>(m_tools.Acquire(TOOL_HISTORY));
+    tool->SelectCapture(id);
+}
+
+bool UIManager::CaptureDesktop()
+{
+    ProfileScope scope("Desktop capture");
+    auto start = std::chrono::steady_clock::now();
+    if (m_platform == nullptr || !m_platform->CaptureDesktop(m_desktopCanvas, m_desktopOutputs))
+    {
+        std::cout << "Desktop capture failed" << std::endl;
+        return false;
+    }
+
+    // Millisecond names, numbered when two captures share a millisecond, so no save overwrites another
+    auto wallClock = std::chrono::system_clock::now();
+    int64_t epochMs = std::chrono::duration_cast<std::chrono::milliseconds>(wallClock.time_since_epoch()).count();
+    m_captureSequence = epochMs == m_lastCaptureMs ? m_captureSequence + 1 : 0;
+    m_lastCaptureMs = epochMs;
+    time_t now = std::chrono::system_clock::to_time_t(wallClock);
+    char stamp[32];
+    strftime(stamp, sizeof(stamp), "%Y%m%d_%H%M%S", localtime(&now));
+    char path[64];
+    if (m_captureSequence == 0)
+        snprintf(path, sizeof(path), "capture_%s_%03d.png", stamp, (int)(epochMs % 1000));
+    else
+        snprintf(path, sizeof(path), "capture_%s_%03d_%d.png", stamp, (int)(epochMs % 1000), m_captureSequence + 1);
+
+    SavedCapture capture;
+    capture.path = path;
+    // Comes back through CollectSavedCaptures. Reset, as the capture reallocates only on a size change.
+    capture.image = std::exchange(m_desktopCanvas, Imaging::Image());
+    capture.canvasEvictions = m_canvasEvictions;
+    capture.outputCount = m_desktopOutputs.size();
+    capture.captureMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    m_savingBytes += capture.image.pixels.capacity() * sizeof(uint32_t);
+
+    // Encoding tens of megapixels takes many frames; the grab above is all the UI thread waits for
+    m_savePool.Post([this, capture = std::move(capture)]() mutable
+                    { SaveCapture(std::move(capture)); });
+    return true;
+}
+
+void UIManager::SaveCapture(SavedCapture capture)
+{
+    auto start = std::chrono::steady_clock::now();
+
+    // Fast compression: a multi-monitor desktop is tens of megapixels
+    Imaging::ImageFile file;
+    file.image = std::move(capture.image); // Lent to the encoder rather than copied
+    file.format = Imaging::ImageFormat::Png;
+    std::vector<uint8_t> encoded;
+    bool encodedOk = Imaging::EncodeImage(file, Imaging::ImageFormat::Png, encoded, 1);
+    capture.image = std::move(file.image);
+
+    std::ofstream stream(capture.path, std::ios::binary | std::ios::trunc);
+    capture.saved = encodedOk && stream &&
+                    stream.write(reinterpret_cast<const char *>(encoded.data()), (std::streamsize)encoded.size());
+    if (capture.saved)
+    {
+        // Hashed here too, so the history only has to index them
+        capture.dHash = Imaging::ComputeDHash(capture.image);
+        capture.pHash = Imaging::ComputePHash(capture.image);
+        capture.timestamp = std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    }
+    capture.saveMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::lock_guard<std::mutex> lock(m_savedMutex);
+    m_savedCaptures.push_back(std::move(capture));
+}
 
-    if (m_showDemo)
+void UIManager::CollectSavedCaptures()
+{
+    std::vector<SavedCapture> finished;
     {
-        RenderDemoWindow();
+        std::lock_guard<std::mutex> lock(m_savedMutex);
+        if (m_savedCaptures.empty())
+            return;
+        finished.swap(m_savedCaptures);
     }
 
-    if (m_showSettings)
+    for (SavedCapture &capture : finished)
     {
-        RenderSettingsWindow();
+        m_savingBytes -= capture.image.pixels.capacity() * sizeof(uint32_t);
+        if (capture.saved)
+        {
+            m_history.AddHashed(capture.path, capture.image.width, capture.image.height, capture.dHash, capture.pHash, capture.timestamp);
+            std::cout << "Saved " << capture.path << ": " << capture.image.width << "x" << capture.image.height << " over "
+                      << capture.outputCount << " monitor(s), grabbed in " << capture.captureMs << " ms, written in "
+                      << capture.saveMs << " ms" << std::endl;
+        }
+        else
+        {
+            std::cout << "Cannot write " << capture.path << std::endl;
+        }
+
+        // Under memory pressure since the capture, the buffer is freed here rather than kept
+        if (m_desktopCanvas.pixels.empty() && capture.canvasEvictions == m_canvasEvictions)
+            m_desktopCanvas = std::move(capture.image);
     }
 }
 
@@ -48,6 +227,10 @@ void UIManager::RenderMainMenuBar()
     {
         if (ImGui::BeginMenu("File"))
         {
+            if (ImGui::MenuItem("Capture Desktop", nullptr, false, m_platform != nullptr))
+            {
+                CaptureDesktop();
+            }
             if (ImGui::MenuItem("Exit"))
             {
                 // Signal application to close
@@ -57,8 +240,7 @@ void UIManager::RenderMainMenuBar()
 
         if (ImGui::BeginMenu("View"))
         {
-            ImGui::MenuItem("Demo Window", nullptr, &m_showDemo);
-            ImGui::MenuItem("Settings", nullptr, &m_showSettings);
+            m_tools.RenderMenuItems();
             ImGui::EndMenu();
         }
 
@@ -91,71 +273,4 @@ void UIManager::UpdateFrameStats()
         sum += m_frameTimeBuffer[i];
     }
     m_avgFrameTime = sum / FRAME_HISTORY_SIZE;
-}
-
-void UIManager::RenderDemoWindow()
-{
-    // Use local static variables to avoid repeated allocations
-    static float f = 0.0f;
-    static int counter = 0;
-    static ImVec4 clear_color = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
-
-    // Pre-allocated buffer for text formatting to avoid string allocations
-    static char counter_text[64];
-    static char frame_stats[128];
-
-    ImGui::Begin("Snap Tools Demo", &m_showDemo);
-
-    // Use const char* for static text to avoid string operations
-    ImGui::TextUnformatted("Cross-Platform ImGui Application");
-    ImGui::Separator();
-
-    ImGui::TextUnformatted("This is a cross-platform application using:");
-    ImGui::BulletText("macOS: Cocoa + Metal");
-    ImGui::BulletText("Windows: Win32 + DirectX11");
-    ImGui::BulletText("Linux: SDL3 + OpenGL3");
-
-    ImGui::Separator();
-
-    ImGui::SliderFloat("Float Value", &f, 0.0f, 1.0f);
-    ImGui::ColorEdit3("Clear Color", (float *)&clear_color);
-
-    if (ImGui::Button("Click Me!"))
-    {
-        counter++;
-    }
-    ImGui::SameLine();
-
-    // Format text into pre-allocated buffer to avoid string allocations
-    snprintf(counter_text, sizeof(counter_text), "Counter = %d", counter);
-    ImGui::TextUnformatted(counter_text);
-
-    // Use cached frame time instead of calling ImGui::GetIO() repeatedly
-    snprintf(frame_stats, sizeof(frame_stats),
-             "Application average %.3f ms/frame (%.1f FPS)",
-             m_avgFrameTime, 1000.0f / m_avgFrameTime);
-    ImGui::TextUnformatted(frame_stats);
-
-    ImGui::End();
-}
-
-void UIManager::RenderSettingsWindow()
-{
-    ImGui::Begin("Settings", &m_showSettings);
-
-    ImGui::Text("Application Settings");
-    ImGui::Separator();
-
-    static bool vsync = true;
-    ImGui::Checkbox("VSync", &vsync);
-
-    static int samples = 4;
-    ImGui::SliderInt("MSAA Samples", &samples, 1, 16);
-
-    if (ImGui::Button("Apply Settings"))
-    {
-        // Apply settings
-    }
-
-    ImGui::End();
-}
+}
\ No newline at end of file
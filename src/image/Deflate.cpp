@@ -0,0 +1,110 @@
+#include "image/Deflate.h"
+#include <algorithm>
+#include <new>
+#include <zlib.h>
+
+namespace Imaging
+{
+    namespace
+    {
+        // zlib counts bytes in uInt, so larger buffers are fed to it in pieces
+        constexpr size_t MAX_INPUT_CHUNK = (size_t)1 << 30;
+        constexpr size_t OUTPUT_CHUNK = (size_t)1 << 16;
+    }
+
+    void ZlibCompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out, int level)
+    {
+        z_stream stream{};
+        if (deflateInit(&stream, std::clamp(level, 0, 9)) != Z_OK)
+            throw std::bad_alloc();
+
+        size_t written = out.size();
+        int flush = Z_NO_FLUSH;
+        while (flush != Z_FINISH)
+        {
+            size_t chunk = std::min(size, MAX_INPUT_CHUNK);
+            stream.next_in = const_cast<Bytef *>(data);
+            stream.avail_in = (uInt)chunk;
+            data += chunk;
+            size -= chunk;
+            flush = size == 0 ? Z_FINISH : Z_NO_FLUSH;
+
+            // With valid arguments deflate cannot fail; it only runs out of output space
+            do
+            {
+                out.resize(written + OUTPUT_CHUNK);
+                stream.next_out = out.data() + written;
+                stream.avail_out = (uInt)OUTPUT_CHUNK;
+                deflate(&stream, flush);
+                written += OUTPUT_CHUNK - stream.avail_out;
+            } while (stream.avail_out == 0);
+        }
+        deflateEnd(&stream);
+        out.resize(written);
+    }
+
+    bool ZlibDecompress(const uint8_t *data, size_t size, std::vector<uint8_t> &out, size_t maxSize)
+    {
+        out.clear();
+        z_stream stream{};
+        if (inflateInit(&stream) != Z_OK)
+            return false;
+        if (maxSize != 0)
+            out.reserve(maxSize);
+
+        int status = Z_OK;
+        size_t written = 0;
+        while (status == Z_OK)
+        {
+            if (stream.avail_in == 0)
+            {
+                size_t chunk = std::min(size, MAX_INPUT_CHUNK);
+                stream.next_in = const_cast<Bytef *>(data);
+                stream.avail_in = (uInt)chunk;
+                data += chunk;
+                size -= chunk;
+            }
+
+            // Room for one byte past the limit, so a stream that exceeds it is caught writing it
+            size_t room = maxSize != 0 ? std::min(OUTPUT_CHUNK, maxSize + 1 - written) : OUTPUT_CHUNK;
+            out.resize(written + room);
+            stream.next_out = out.data() + written;
+            stream.avail_out = (uInt)room;
+            status = inflate(&stream, Z_NO_FLUSH);
+            written += room - stream.avail_out;
+            if (maxSize != 0 && written > maxSize)
+                status = Z_BUF_ERROR;
+        }
+        inflateEnd(&stream);
+
+        // Truncated input ends in Z_BUF_ERROR, corrupt data or a bad checksum in Z_DATA_ERROR
+        out.resize(written);
+        return status == Z_STREAM_END;
+    }
+
+    uint32_t Crc32(uint32_t crc, const uint8_t *data, size_t size)
+    {
+        uLong value = crc;
+        while (size > 0)
+        {
+            size_t chunk = std::min(size, MAX_INPUT_CHUNK);
+            value = crc32(value, data, (uInt)chunk);
+            data += chunk;
+            size -= chunk;
+        }
+        return (uint32_t)value;
+    }
+
+    uint32_t Adler32(uint32_t adler, const uint8_t *data, size_t size)
+    {
+        uLong value = adler;
+        while (size > 0)
+        {
+            size_t chunk = std::min(size, MAX_INPUT_CHUNK);
+            value = adler32(value, data, (uInt)chunk);
+            data += chunk;
+            size -= chunk;
+        }
+        return (uint32_t)value;
+    }
+}
\ No newline at end of file
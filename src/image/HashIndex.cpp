@@ -0,0 +1,121 @@
+#include "image/HashIndex.h"
+#include <algorithm>
+#include <bit>
+
+namespace Imaging
+{
+    HashIndex::HashIndex() : m_heads((size_t)CHUNKS * BUCKETS, NONE), m_removedCount(0) {}
+
+    void HashIndex::Link(uint32_t index)
+    {
+        Entry &entry = m_entries[index];
+        for (int chunk = 0; chunk < CHUNKS; chunk++)
+        {
+            uint32_t &head = m_heads[(size_t)chunk * BUCKETS + Chunk(entry.hash, chunk)];
+            entry.next[chunk] = head;
+            head = index;
+        }
+    }
+
+    void HashIndex::Insert(uint32_t id, uint64_t hash)
+    {
+        Remove(id);
+
+        Entry entry;
+        entry.hash = hash;
+        entry.id = id;
+        entry.removed = false;
+        uint32_t index = (uint32_t)m_entries.size();
+        m_entries.push_back(entry);
+        m_entryById[id] = index;
+        Link(index);
+    }
+
+    bool HashIndex::Remove(uint32_t id)
+    {
+        auto it = m_entryById.find(id);
+        if (it == m_entryById.end())
+            return false;
+
+        // Entries stay in their chains until enough have piled up to make a rebuild worthwhile
+        m_entries[it->second].removed = true;
+        m_entryById.erase(it);
+        m_removedCount++;
+        if (m_removedCount > 1024 && m_removedCount * 2 > m_entries.size())
+            Compact();
+        return true;
+    }
+
+    void HashIndex::Clear()
+    {
+        std::fill(m_heads.begin(), m_heads.end(), NONE);
+        m_entries.clear();
+        m_entryById.clear();
+        m_removedCount = 0;
+    }
+
+    size_t HashIndex::GetMemoryBytes() const
+    {
+        // Node-based map: one allocation per element plus the bucket array
+        return m_heads.capacity() * sizeof(uint32_t) + m_entries.capacity() * sizeof(Entry) +
+               m_entryById.size() * (sizeof(std::pair<const uint32_t, uint32_t>) + 2 * sizeof(void *)) +
+               m_entryById.bucket_count() * sizeof(void *);
+    }
+
+    void HashIndex::Compact()
+    {
+        std::vector<Entry> entries;
+        entries.swap(m_entries);
+        Clear();
+        m_entries.reserve(entries.size());
+        for (const Entry &entry : entries)
+        {
+            if (!entry.removed)
+                Insert(entry.id, entry.hash);
+        }
+    }
+
+    void HashIndex::Query(uint64_t hash, int maxDistance, std::vector<Match> &out) const
+    {
+        out.clear();
+        maxDistance = std::clamp(maxDistance, 0, 64);
+        int chunkRadius = maxDistance / CHUNKS;
+        for (int chunk = 0; chunk < CHUNKS; chunk++)
+            ProbeNeighbours(Chunk(hash, chunk), 0, chunkRadius, chunk, hash, maxDistance, chunkRadius, out);
+
+        std::sort(out.begin(), out.end(), [](const Match &a, const Match &b)
+                  { return a.distance != b.distance ? a.distance < b.distance : a.id < b.id; });
+    }
+
+    // Visits every key within flipsLeft bits of `key`, flipping only bits at or above firstBit
+    // so each key is generated once
+    void HashIndex::ProbeNeighbours(uint32_t key, int firstBit, int flipsLeft, int chunk, uint64_t hash, int maxDistance, int chunkRadius, std::vector<Match> &out) const
+    {
+        ProbeBucket(key, chunk, hash, maxDistance, chunkRadius, out);
+        if (flipsLeft == 0)
+            return;
+        for (int bit = firstBit; bit < CHUNK_BITS; bit++)
+            ProbeNeighbours(key ^ (1u << bit), bit + 1, flipsLeft - 1, chunk, hash, maxDistance, chunkRadius, out);
+    }
+
+    void HashIndex::ProbeBucket(uint32_t bucket, int chunk, uint64_t hash, int maxDistance, int chunkRadius, std::vector<Match> &out) const
+    {
+        for (uint32_t index = m_heads[(size_t)chunk * BUCKETS + bucket]; index != NONE; index = m_entries[index].next[chunk])
+        {
+            const Entry &entry = m_entries[index];
+            if (entry.removed)
+                continue;
+
+            // An entry close enough on an earlier chunk was already reported by that chunk's probe
+            bool seen = false;
+            for (int earlier = 0; earlier < chunk && !seen; earlier++)
+                seen = std::popcount(Chunk(entry.hash ^ hash, earlier)) <= chunkRadius;
+            if (seen)
+                continue;
+
+            int distance = std::popcount(entry.hash ^ hash);
+            if (distance <= maxDistance)
+                out.push_back({entry.id, distance});
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+#include "image/PerceptualHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Imaging
+{
+    namespace
+    {
+        constexpr int PHASH_SIZE = 32;
+
+        // Area-averaged luma on a gridWidth x gridHeight grid. Every source pixel contributes to
+        // exactly one cell, so the cost is a single pass over the image.
+        void ReduceToGray(const Image &image, int gridWidth, int gridHeight, float *out)
+        {
+            std::fill(out, out + gridWidth * gridHeight, 0.0f);
+            if (image.IsEmpty())
+                return;
+
+            for (int cy = 0; cy < gridHeight; cy++)
+            {
+                int y0 = cy * image.height / gridHeight;
+                int y1 = std::max(y0 + 1, (cy + 1) * image.height / gridHeight);
+                for (int cx = 0; cx < gridWidth; cx++)
+                {
+                    int x0 = cx * image.width / gridWidth;
+                    int x1 = std::max(x0 + 1, (cx + 1) * image.width / gridWidth);
+                    uint64_t sum = 0;
+                    for (int y = y0; y < y1; y++)
+                    {
+                        const uint32_t *row = image.Row(y);
+                        for (int x = x0; x < x1; x++)
+                        {
+                            uint32_t p = row[x];
+                            sum += (p & 0xFF) * 77 + ((p >> 8) & 0xFF) * 150 + ((p >> 16) & 0xFF) * 29;
+                        }
+                    }
+                    out[cy * gridWidth + cx] = (float)sum / (256.0f * (float)((x1 - x0) * (y1 - y0)));
+                }
+            }
+        }
+
+        // cos((2x + 1) * u * pi / 2N) for the 32-point DCT-II, built once
+        const float *GetDctTable()
+        {
+            static const struct Table
+            {
+                float values[PHASH_SIZE * PHASH_SIZE];
+                Table()
+                {
+                    const double pi = 3.14159265358979323846;
+                    for (int u = 0; u < PHASH_SIZE; u++)
+                    {
+                        for (int x = 0; x < PHASH_SIZE; x++)
+                            values[u * PHASH_SIZE + x] = (float)std::cos((2 * x + 1) * u * pi / (2.0 * PHASH_SIZE));
+                    }
+                }
+            } table;
+            return table.values;
+        }
+    }
+
+    uint64_t ComputeDHash(const Image &image)
+    {
+        float gray[9 * 8];
+        ReduceToGray(image, 9, 8, gray);
+
+        uint64_t hash = 0;
+        for (int y = 0; y < 8; y++)
+        {
+            for (int x = 0; x < 8; x++)
+            {
+                if (gray[y * 9 + x] > gray[y * 9 + x + 1])
+                    hash |= 1ull << (y * 8 + x);
+            }
+        }
+        return hash;
+    }
+
+    uint64_t ComputePHash(const Image &image)
+    {
+        float gray[PHASH_SIZE * PHASH_SIZE];
+        ReduceToGray(image, PHASH_SIZE, PHASH_SIZE, gray);
+
+        // Separable DCT, but only the 9 lowest frequencies per axis are ever needed
+        const float *cosTable = GetDctTable();
+        float rows[PHASH_SIZE * 9];
+        for (int y = 0; y < PHASH_SIZE; y++)
+        {
+            for (int u = 0; u < 9; u++)
+            {
+                float sum = 0.0f;
+                for (int x = 0; x < PHASH_SIZE; x++)
+                    sum += gray[y * PHASH_SIZE + x] * cosTable[u * PHASH_SIZE + x];
+                rows[y * 9 + u] = sum;
+            }
+        }
+
+        // Skip the DC row and column, they only carry overall brightness
+        float coefficients[64];
+        for (int v = 1; v < 9; v++)
+        {
+            for (int u = 1; u < 9; u++)
+            {
+                float sum = 0.0f;
+                for (int y = 0; y < PHASH_SIZE; y++)
+                    sum += rows[y * 9 + u] * cosTable[v * PHASH_SIZE + y];
+                coefficients[(v - 1) * 8 + (u - 1)] = sum;
+            }
+        }
+
+        float sorted[64];
+        std::copy(coefficients, coefficients + 64, sorted);
+        std::nth_element(sorted, sorted + 32, sorted + 64);
+        float median = sorted[32];
+
+        uint64_t hash = 0;
+        for (int i = 0; i < 64; i++)
+        {
+            if (coefficients[i] > median)
+                hash |= 1ull << i;
+        }
+        return hash;
+    }
+}
\ No newline at end of file
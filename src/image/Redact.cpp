@@ -0,0 +1,51 @@
+#include "image/Redact.h"
+#include <algorithm>
+
+namespace Imaging
+{
+    void Redact(Image &image, const RedactRegion &region)
+    {
+        int x0 = std::max(region.x, 0);
+        int y0 = std::max(region.y, 0);
+        int x1 = std::min(region.x + region.width, image.width);
+        int y1 = std::min(region.y + region.height, image.height);
+        if (x0 >= x1 || y0 >= y1)
+            return;
+
+        if (region.mode == RedactMode::Fill)
+        {
+            for (int y = y0; y < y1; y++)
+                std::fill(image.Row(y) + x0, image.Row(y) + x1, region.color);
+            return;
+        }
+
+        // Cells are aligned to the region, not the image, so the same region always
+        // produces the same blocks; partial cells at the edges average what they cover
+        int block = std::max(region.blockSize, 2);
+        for (int cellY = y0; cellY < y1; cellY += block)
+        {
+            int cellY1 = std::min(cellY + block, y1);
+            for (int cellX = x0; cellX < x1; cellX += block)
+            {
+                int cellX1 = std::min(cellX + block, x1);
+                uint64_t sums[4] = {0, 0, 0, 0};
+                for (int y = cellY; y < cellY1; y++)
+                {
+                    const uint32_t *row = image.Row(y);
+                    for (int x = cellX; x < cellX1; x++)
+                    {
+                        for (int c = 0; c < 4; c++)
+                            sums[c] += (row[x] >> (c * 8)) & 0xFF;
+                    }
+                }
+
+                uint64_t count = (uint64_t)(cellX1 - cellX) * (cellY1 - cellY);
+                uint32_t average = 0;
+                for (int c = 0; c < 4; c++)
+                    average |= (uint32_t)((sums[c] + count / 2) / count) << (c * 8);
+                for (int y = cellY; y < cellY1; y++)
+                    std::fill(image.Row(y) + cellX, image.Row(y) + cellX1, average);
+            }
+        }
+    }
+}
\ No newline at end of file
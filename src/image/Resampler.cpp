@@ -0,0 +1,361 @@
+#include "image/Resampler.h"
+#include <algorithm>
+#include <cmath>
+
+// RESAMPLER_NO_SSE2 forces the scalar path, so tests can check that both paths agree
+#if !defined(RESAMPLER_NO_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define RESAMPLER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Imaging
+{
+    namespace
+    {
+        constexpr double PI = 3.14159265358979323846;
+        constexpr int LINEAR_TO_SRGB_SIZE = 16384;
+
+        // Conversion tables, built once on first use
+        struct ColorTables
+        {
+            float srgbToLinear[256];
+            uint8_t linearToSrgb[LINEAR_TO_SRGB_SIZE];
+
+            ColorTables()
+            {
+                for (int i = 0; i < 256; i++)
+                {
+                    double c = i / 255.0;
+                    srgbToLinear[i] = (float)(c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4));
+                }
+                for (int i = 0; i < LINEAR_TO_SRGB_SIZE; i++)
+                {
+                    double l = i / (double)(LINEAR_TO_SRGB_SIZE - 1);
+                    double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+                    linearToSrgb[i] = (uint8_t)std::lround(std::clamp(c, 0.0, 1.0) * 255.0);
+                }
+            }
+        };
+
+        const ColorTables &GetColorTables()
+        {
+            static const ColorTables tables;
+            return tables;
+        }
+
+        double FilterRadius(ResampleFilter filter)
+        {
+            switch (filter)
+            {
+            case ResampleFilter::Box:
+                return 0.5;
+            case ResampleFilter::Mitchell:
+                return 2.0;
+            case ResampleFilter::Lanczos3:
+                return 3.0;
+            }
+            return 0.5;
+        }
+
+        double Sinc(double x)
+        {
+            if (x == 0.0)
+                return 1.0;
+            x *= PI;
+            return std::sin(x) / x;
+        }
+
+        double FilterKernel(ResampleFilter filter, double x)
+        {
+            switch (filter)
+            {
+            case ResampleFilter::Box:
+                return (x >= -0.5 && x < 0.5) ? 1.0 : 0.0;
+            case ResampleFilter::Mitchell:
+            {
+                const double B = 1.0 / 3.0;
+                const double C = 1.0 / 3.0;
+                x = std::fabs(x);
+                if (x < 1.0)
+                    return ((12 - 9 * B - 6 * C) * x * x * x + (-18 + 12 * B + 6 * C) * x * x + (6 - 2 * B)) / 6.0;
+                if (x < 2.0)
+                    return ((-B - 6 * C) * x * x * x + (6 * B + 30 * C) * x * x + (-12 * B - 48 * C) * x + (8 * B + 24 * C)) / 6.0;
+                return 0.0;
+            }
+            case ResampleFilter::Lanczos3:
+                return std::fabs(x) < 3.0 ? Sinc(x) * Sinc(x / 3.0) : 0.0;
+            }
+            return 0.0;
+        }
+
+        // sRGB RGBA8 -> premultiplied linear RGBA floats
+        void LinearizeRow(const uint32_t *in, float *out, int width)
+        {
+            const ColorTables &tables = GetColorTables();
+            for (int x = 0; x < width; x++)
+            {
+                uint32_t p = in[x];
+                float a = (p >> 24) * (1.0f / 255.0f);
+                out[x * 4 + 0] = tables.srgbToLinear[p & 0xFF] * a;
+                out[x * 4 + 1] = tables.srgbToLinear[(p >> 8) & 0xFF] * a;
+                out[x * 4 + 2] = tables.srgbToLinear[(p >> 16) & 0xFF] * a;
+                out[x * 4 + 3] = a;
+            }
+        }
+
+        // Premultiplied linear RGBA floats -> sRGB RGBA8. Lanczos and Mitchell overshoot, so clamp.
+        void EncodeRow(const float *in, uint32_t *out, int width)
+        {
+            const ColorTables &tables = GetColorTables();
+            for (int x = 0; x < width; x++)
+            {
+                float a = std::clamp(in[x * 4 + 3], 0.0f, 1.0f);
+                if (a <= 0.0f)
+                {
+                    out[x] = 0;
+                    continue;
+                }
+                float scale = (LINEAR_TO_SRGB_SIZE - 1) / a;
+                uint32_t pixel = (uint32_t)std::lround(a * 255.0f) << 24;
+                for (int c = 0; c < 3; c++)
+                {
+                    int index = std::clamp((int)(in[x * 4 + c] * scale + 0.5f), 0, LINEAR_TO_SRGB_SIZE - 1);
+                    pixel |= (uint32_t)tables.linearToSrgb[index] << (c * 8);
+                }
+                out[x] = pixel;
+            }
+        }
+
+        // One target row from a linearized source row; each pixel is a 4-wide RGBA vector
+        void FilterRow(const float *in, float *out, int width, const int *start, const int *count, const float *weights, int stride)
+        {
+            for (int x = 0; x < width; x++)
+            {
+                const float *src = in + (size_t)start[x] * 4;
+                const float *w = weights + (size_t)x * stride;
+                int n = count[x];
+#ifdef RESAMPLER_SSE2
+                // Two accumulators so consecutive taps do not wait on each other's add
+                __m128 acc0 = _mm_setzero_ps();
+                __m128 acc1 = _mm_setzero_ps();
+                int i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(src + i * 4)));
+                    acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_set1_ps(w[i + 1]), _mm_loadu_ps(src + i * 4 + 4)));
+                }
+                if (i < n)
+                    acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_set1_ps(w[i]), _mm_loadu_ps(src + i * 4)));
+                _mm_storeu_ps(out + x * 4, _mm_add_ps(acc0, acc1));
+#else
+                // Summed like the SSE2 path, so both produce the same bits
+                float acc0[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                float acc1[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+                int i = 0;
+                for (; i + 2 <= n; i += 2)
+                {
+                    for (int c = 0; c < 4; c++)
+                    {
+                        acc0[c] += w[i] * src[i * 4 + c];
+                        acc1[c] += w[i + 1] * src[i * 4 + 4 + c];
+                    }
+                }
+                if (i < n)
+                {
+                    for (int c = 0; c < 4; c++)
+                        acc0[c] += w[i] * src[i * 4 + c];
+                }
+                for (int c = 0; c < 4; c++)
+                    out[x * 4 + c] = acc0[c] + acc1[c];
+#endif
+            }
+        }
+
+        // out = sum(weights[i] * rows[i]) over whole rows of `length` floats
+        void BlendRows(const float *const *rows, const float *weights, int count, float *out, int length)
+        {
+            int i = 0;
+#ifdef RESAMPLER_SSE2
+            for (; i + 16 <= length; i += 16)
+            {
+                __m128 w = _mm_set1_ps(weights[0]);
+                __m128 acc0 = _mm_mul_ps(w, _mm_loadu_ps(rows[0] + i));
+                __m128 acc1 = _mm_mul_ps(w, _mm_loadu_ps(rows[0] + i + 4));
+                __m128 acc2 = _mm_mul_ps(w, _mm_loadu_ps(rows[0] + i + 8));
+                __m128 acc3 = _mm_mul_ps(w, _mm_loadu_ps(rows[0] + i + 12));
+                for (int k = 1; k < count; k++)
+                {
+                    w = _mm_set1_ps(weights[k]);
+                    acc0 = _mm_add_ps(acc0, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i)));
+                    acc1 = _mm_add_ps(acc1, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i + 4)));
+                    acc2 = _mm_add_ps(acc2, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i + 8)));
+                    acc3 = _mm_add_ps(acc3, _mm_mul_ps(w, _mm_loadu_ps(rows[k] + i + 12)));
+                }
+                _mm_storeu_ps(out + i, acc0);
+                _mm_storeu_ps(out + i + 4, acc1);
+                _mm_storeu_ps(out + i + 8, acc2);
+                _mm_storeu_ps(out + i + 12, acc3);
+            }
+#endif
+            for (; i < length; i++)
+            {
+                float acc = 0.0f;
+                for (int k = 0; k < count; k++)
+                    acc += weights[k] * rows[k][i];
+                out[i] = acc;
+            }
+        }
+    }
+
+    const char *GetFilterName(ResampleFilter filter)
+    {
+        switch (filter)
+        {
+        case ResampleFilter::Box:
+            return "box";
+        case ResampleFilter::Mitchell:
+            return "mitchell";
+        case ResampleFilter::Lanczos3:
+            return "lanczos3";
+        }
+        return "unknown";
+    }
+
+    Resampler::Resampler(int threadCount) : m_pool(threadCount) {}
+
+    void Resampler::BuildWeights(WeightTable &table, int srcSize, int dstSize, ResampleFilter filter)
+    {
+        if (table.srcSize == srcSize && table.dstSize == dstSize && table.filter == filter)
+            return;
+
+        table.srcSize = srcSize;
+        table.dstSize = dstSize;
+        table.filter = filter;
+        table.start.resize(dstSize);
+        table.count.resize(dstSize);
+
+        // Same size: every filter passes pixels through, skip the kernel entirely
+        if (srcSize == dstSize)
+        {
+            table.stride = 1;
+            table.weights.assign(dstSize, 1.0f);
+            for (int i = 0; i < dstSize; i++)
+            {
+                table.start[i] = i;
+                table.count[i] = 1;
+            }
+            return;
+        }
+
+        // When shrinking, the kernel is stretched to cover every source pixel
+        double scale = (double)srcSize / dstSize;
+        double filterScale = std::max(scale, 1.0);
+        double support = FilterRadius(filter) * filterScale;
+        table.stride = (int)std::ceil(support * 2.0) + 2;
+        table.weights.assign((size_t)dstSize * table.stride, 0.0f);
+
+        std::vector<double> weights(table.stride);
+        for (int i = 0; i < dstSize; i++)
+        {
+            double center = (i + 0.5) * scale;
+            int lo = std::max(0, (int)std::floor(center - support));
+            int hi = std::min(srcSize, (int)std::ceil(center + support));
+
+            double sum = 0.0;
+            int n = 0;
+            for (int j = lo; j < hi && n < table.stride; j++)
+            {
+                weights[n] = FilterKernel(filter, (j + 0.5 - center) / filterScale);
+                sum += weights[n++];
+            }
+
+            // Drop zero taps at both ends so the inner loops stay short
+            int first = 0;
+            while (first < n - 1 && weights[first] == 0.0)
+                first++;
+            while (n - 1 > first && weights[n - 1] == 0.0)
+                n--;
+
+            table.start[i] = lo + first;
+            table.count[i] = n - first;
+            float *out = table.weights.data() + (size_t)i * table.stride;
+            for (int k = first; k < n; k++)
+                out[k - first] = (float)(sum != 0.0 ? weights[k] / sum : 0.0);
+        }
+    }
+
+    bool Resampler::Resample(const Image &src, Image &dst, int width, int height, ResampleFilter filter)
+    {
+        if (src.IsEmpty() || width <= 0 || height <= 0 || &src == &dst)
+            return false;
+
+        dst.Allocate(width, height);
+        if (width == src.width && height == src.height)
+        {
+            dst.pixels = src.pixels;
+            return true;
+        }
+
+        BuildWeights(m_horizontal, src.width, width, filter);
+        BuildWeights(m_vertical, src.height, height, filter);
+
+        // Enough bands to keep every thread busy, but tall enough that the source rows shared
+        // between neighbouring bands are only filtered a few extra times
+        int bandRows = std::clamp(height / (m_pool.GetThreadCount() * 4), 8, 64);
+        int bands = (height + bandRows - 1) / bandRows;
+        m_pool.ParallelFor(bands, [&](int band)
+                           { ResampleBand(src, dst, band * bandRows, std::min((band + 1) * bandRows, height)); });
+        return true;
+    }
+
+    bool Resampler::ResampleToFit(const Image &src, Image &dst, int maxWidth, int maxHeight, ResampleFilter filter)
+    {
+        if (src.IsEmpty() || maxWidth <= 0 || maxHeight <= 0)
+            return false;
+
+        double scale = std::min({1.0, (double)maxWidth / src.width, (double)maxHeight / src.height});
+        int width = std::max(1, (int)std::lround(src.width * scale));
+        int height = std::max(1, (int)std::lround(src.height * scale));
+        return Resample(src, dst, width, height, filter);
+    }
+
+    void Resampler::ResampleBand(const Image &src, Image &dst, int y0, int y1)
+    {
+        // Per-thread scratch, kept between calls so steady-state resampling does not allocate
+        thread_local std::vector<float> sourceRow;
+        thread_local std::vector<float> filtered;
+        thread_local std::vector<float> outputRow;
+        thread_local std::vector<const float *> rows;
+
+        const WeightTable &h = m_horizontal;
+        const WeightTable &v = m_vertical;
+        const size_t rowFloats = (size_t)dst.width * 4;
+
+        // Source rows touched by this band's vertical kernels
+        int srcY0 = v.start[y0];
+        int srcY1 = srcY0;
+        for (int y = y0; y < y1; y++)
+            srcY1 = std::max(srcY1, v.start[y] + v.count[y]);
+
+        sourceRow.resize((size_t)src.width * 4);
+        filtered.resize((size_t)(srcY1 - srcY0) * rowFloats);
+        outputRow.resize(rowFloats);
+        rows.resize(v.stride);
+
+        for (int sy = srcY0; sy < srcY1; sy++)
+        {
+            LinearizeRow(src.Row(sy), sourceRow.data(), src.width);
+            FilterRow(sourceRow.data(), filtered.data() + (size_t)(sy - srcY0) * rowFloats, dst.width,
+                      h.start.data(), h.count.data(), h.weights.data(), h.stride);
+        }
+
+        for (int y = y0; y < y1; y++)
+        {
+            int count = v.count[y];
+            for (int k = 0; k < count; k++)
+                rows[k] = filtered.data() + (size_t)(v.start[y] + k - srcY0) * rowFloats;
+            BlendRows(rows.data(), v.weights.data() + (size_t)y * v.stride, count, outputRow.data(), (int)rowFloats);
+            EncodeRow(outputRow.data(), dst.Row(y), dst.width);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,374 @@
+#include "image/UndoHistory.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace Imaging
+{
+    namespace
+    {
+        // Tile codec over 32-bit pixels in row-major order. Each token starts with one byte:
+        //   0x00-0x7F  literal: (byte + 1) raw pixels follow
+        //   0x80-0xBF  repeat the previous pixel
+        //   0xC0-0xFF  copy from the pixel one tile row above
+        // Run lengths are the low six bits plus one; when all six bits are set, one more
+        // byte follows and the length is 64 plus that byte.
+        constexpr int MAX_LITERAL = 128;
+        constexpr int SHORT_RUN = 63;
+        constexpr int MAX_RUN = SHORT_RUN + 1 + 255;
+        constexpr uint8_t TOKEN_REPEAT = 0x80;
+        constexpr uint8_t TOKEN_ABOVE = 0xC0;
+
+        void WriteLiterals(std::vector<uint8_t> &out, const uint32_t *pixels, int count)
+        {
+            out.push_back((uint8_t)(count - 1));
+            size_t offset = out.size();
+            out.resize(offset + (size_t)count * 4);
+            memcpy(out.data() + offset, pixels, (size_t)count * 4);
+        }
+
+        void WriteRun(std::vector<uint8_t> &out, uint8_t token, int length)
+        {
+            if (length <= SHORT_RUN)
+            {
+                out.push_back((uint8_t)(token | (length - 1)));
+                return;
+            }
+            out.push_back((uint8_t)(token | SHORT_RUN));
+            out.push_back((uint8_t)(length - SHORT_RUN - 1));
+        }
+
+        int MatchLength(const uint32_t *pixels, int position, int count, int distance)
+        {
+            int limit = std::min(count - position, MAX_RUN);
+            int length = 0;
+            while (length < limit && pixels[position + length] == pixels[position + length - distance])
+                length++;
+            return length;
+        }
+
+        void EncodeTile(const uint32_t *pixels, int width, int count, std::vector<uint8_t> &out)
+        {
+            int literalStart = 0;
+            int literalCount = 0;
+            int i = 0;
+            while (i < count)
+            {
+                int repeat = i > 0 ? MatchLength(pixels, i, count, 1) : 0;
+                int above = i >= width ? MatchLength(pixels, i, count, width) : 0;
+                if (repeat == 0 && above == 0)
+                {
+                    if (literalCount == MAX_LITERAL)
+                    {
+                        WriteLiterals(out, pixels + literalStart, literalCount);
+                        literalCount = 0;
+                    }
+                    if (literalCount == 0)
+                        literalStart = i;
+                    literalCount++;
+                    i++;
+                    continue;
+                }
+
+                if (literalCount > 0)
+                {
+                    WriteLiterals(out, pixels + literalStart, literalCount);
+                    literalCount = 0;
+                }
+                if (repeat >= above)
+                {
+                    WriteRun(out, TOKEN_REPEAT, repeat);
+                    i += repeat;
+                }
+                else
+                {
+                    WriteRun(out, TOKEN_ABOVE, above);
+                    i += above;
+                }
+            }
+            if (literalCount > 0)
+                WriteLiterals(out, pixels + literalStart, literalCount);
+        }
+
+        bool DecodeTile(const uint8_t *data, size_t size, uint32_t *pixels, int width, int count)
+        {
+            size_t pos = 0;
+            int i = 0;
+            while (i < count)
+            {
+                if (pos >= size)
+                    return false;
+                uint8_t token = data[pos++];
+                if (token < TOKEN_REPEAT)
+                {
+                    int length = token + 1;
+                    if (length > count - i || pos + (size_t)length * 4 > size)
+                        return false;
+                    memcpy(pixels + i, data + pos, (size_t)length * 4);
+                    pos += (size_t)length * 4;
+                    i += length;
+                    continue;
+                }
+
+                int length = (token & SHORT_RUN) + 1;
+                if ((token & SHORT_RUN) == SHORT_RUN)
+                {
+                    if (pos >= size)
+                        return false;
+                    length += data[pos++];
+                }
+                int distance = (token & TOKEN_ABOVE) == TOKEN_ABOVE ? width : 1;
+                if (i < distance || length > count - i)
+                    return false;
+                if (distance == 1)
+                {
+                    std::fill_n(pixels + i, length, pixels[i - 1]);
+                    i += length;
+                    continue;
+                }
+                // A run longer than a row copies pixels it has just written, one row at a time
+                while (length > 0)
+                {
+                    int chunk = std::min(length, distance);
+                    memcpy(pixels + i, pixels + i - distance, (size_t)chunk * 4);
+                    i += chunk;
+                    length -= chunk;
+                }
+            }
+            return pos == size;
+        }
+
+        const std::string NO_LABEL;
+    }
+
+    UndoHistory::UndoHistory(size_t memoryLimit)
+        : m_cursor(0), m_memoryLimit(memoryLimit), m_memoryBytes(0), m_editImage(nullptr), m_editSerial(0), m_editing(false), m_touchedAll(false)
+    {
+    }
+
+    void UndoHistory::BeginEdit(const Image &image, const std::string &label)
+    {
+        m_editImage = &image;
+        m_pending = Step();
+        m_pending.label = label;
+        m_pending.beforeWidth = image.width;
+        m_pending.beforeHeight = image.height;
+        m_editing = true;
+        m_touchedAll = false;
+
+        size_t tileCount = (size_t)TilesAcross(image.width) * TilesAcross(image.height);
+        if (m_tileStamps.size() < tileCount)
+            m_tileStamps.resize(tileCount, 0);
+        if (++m_editSerial == 0)
+        {
+            std::fill(m_tileStamps.begin(), m_tileStamps.end(), 0);
+            m_editSerial = 1;
+        }
+    }
+
+    void UndoHistory::Touch(int x, int y, int width, int height)
+    {
+        if (!m_editing)
+            return;
+
+        const Image &image = *m_editImage;
+        int x0 = std::max(x, 0);
+        int y0 = std::max(y, 0);
+        int x1 = std::min(x + width, image.width);
+        int y1 = std::min(y + height, image.height);
+        if (x1 <= x0 || y1 <= y0)
+            return;
+
+        int tilesX = TilesAcross(image.width);
+        for (int ty = y0 / TILE_SIZE; ty <= (y1 - 1) / TILE_SIZE; ty++)
+        {
+            for (int tx = x0 / TILE_SIZE; tx <= (x1 - 1) / TILE_SIZE; tx++)
+            {
+                uint32_t index = (uint32_t)(ty * tilesX + tx);
+                if (m_tileStamps[index] == m_editSerial)
+                    continue;
+                m_tileStamps[index] = m_editSerial;
+                SaveTile(image, index, m_pending.before, m_pending.data);
+            }
+        }
+    }
+
+    void UndoHistory::TouchAll()
+    {
+        if (!m_editing)
+            return;
+        Touch(0, 0, m_editImage->width, m_editImage->height);
+        m_touchedAll = true;
+    }
+
+    bool UndoHistory::EndEdit(const Image &image)
+    {
+        if (!m_editing)
+            return false;
+        m_editing = false;
+        m_editImage = nullptr;
+
+        bool resized = image.width != m_pending.beforeWidth || image.height != m_pending.beforeHeight;
+        if (resized && !m_touchedAll)
+        {
+            m_pending = Step();
+            return false;
+        }
+        if (!resized && m_pending.before.empty())
+            return true;
+
+        m_pending.afterWidth = image.width;
+        m_pending.afterHeight = image.height;
+        if (resized)
+        {
+            uint32_t tileCount = (uint32_t)(TilesAcross(image.width) * TilesAcross(image.height));
+            m_pending.after.reserve(tileCount);
+            for (uint32_t index = 0; index < tileCount; index++)
+                SaveTile(image, index, m_pending.after, m_pending.data);
+        }
+        else
+        {
+            m_pending.after.reserve(m_pending.before.size());
+            for (const TileRef &ref : m_pending.before)
+                SaveTile(image, ref.index, m_pending.after, m_pending.data);
+        }
+        m_pending.data.shrink_to_fit();
+
+        // A new edit ends the redo branch
+        while (m_steps.size() > m_cursor)
+        {
+            m_memoryBytes -= StepBytes(m_steps.back());
+            m_steps.pop_back();
+        }
+
+        m_memoryBytes += StepBytes(m_pending);
+        m_steps.push_back(std::move(m_pending));
+        m_pending = Step();
+        m_cursor = m_steps.size();
+
+        while (m_memoryBytes > m_memoryLimit && m_cursor > 1)
+            DropOldest();
+        return true;
+    }
+
+    const std::string &UndoHistory::GetUndoLabel() const
+    {
+        return CanUndo() ? m_steps[m_cursor - 1].label : NO_LABEL;
+    }
+
+    const std::string &UndoHistory::GetRedoLabel() const
+    {
+        return CanRedo() ? m_steps[m_cursor].label : NO_LABEL;
+    }
+
+    bool UndoHistory::Undo(Image &image)
+    {
+        if (!CanUndo() || m_editing)
+            return false;
+
+        const Step &step = m_steps[m_cursor - 1];
+        if (image.width != step.afterWidth || image.height != step.afterHeight)
+            return false;
+        if (!RestoreTiles(image, step.beforeWidth, step.beforeHeight, step.before, step.data))
+            return false;
+        m_cursor--;
+        return true;
+    }
+
+    bool UndoHistory::Redo(Image &image)
+    {
+        if (!CanRedo() || m_editing)
+            return false;
+
+        const Step &step = m_steps[m_cursor];
+        if (image.width != step.beforeWidth || image.height != step.beforeHeight)
+            return false;
+        if (!RestoreTiles(image, step.afterWidth, step.afterHeight, step.after, step.data))
+            return false;
+        m_cursor++;
+        return true;
+    }
+
+    void UndoHistory::Clear()
+    {
+        m_steps.clear();
+        m_pending = Step();
+        m_cursor = 0;
+        m_memoryBytes = 0;
+        m_editing = false;
+        m_editImage = nullptr;
+    }
+
+    void UndoHistory::SetMemoryLimit(size_t bytes)
+    {
+        m_memoryLimit = bytes;
+        while (m_memoryBytes > m_memoryLimit && m_cursor > 1)
+            DropOldest();
+    }
+
+    size_t UndoHistory::Trim(size_t targetBytes)
+    {
+        size_t before = m_memoryBytes;
+        while (m_memoryBytes > targetBytes && m_cursor > 0)
+            DropOldest();
+        // Redo steps go newest first, so the ones that remain still apply in order
+        while (m_memoryBytes > targetBytes && !m_steps.empty())
+        {
+            m_memoryBytes -= StepBytes(m_steps.back());
+            m_steps.pop_back();
+        }
+        return before - m_memoryBytes;
+    }
+
+    void UndoHistory::DropOldest()
+    {
+        m_memoryBytes -= StepBytes(m_steps.front());
+        m_steps.pop_front();
+        m_cursor--;
+    }
+
+    void UndoHistory::SaveTile(const Image &image, uint32_t index, std::vector<TileRef> &refs, std::vector<uint8_t> &data)
+    {
+        int tilesX = TilesAcross(image.width);
+        int x0 = (int)(index % tilesX) * TILE_SIZE;
+        int y0 = (int)(index / tilesX) * TILE_SIZE;
+        int width = std::min(TILE_SIZE, image.width - x0);
+        int height = std::min(TILE_SIZE, image.height - y0);
+
+        uint32_t tile[TILE_SIZE * TILE_SIZE];
+        for (int y = 0; y < height; y++)
+            memcpy(tile + y * width, image.Row(y0 + y) + x0, (size_t)width * 4);
+
+        TileRef ref;
+        ref.index = index;
+        ref.offset = (uint32_t)data.size();
+        EncodeTile(tile, width, width * height, data);
+        ref.size = (uint32_t)(data.size() - ref.offset);
+        refs.push_back(ref);
+    }
+
+    bool UndoHistory::RestoreTiles(Image &image, int width, int height, const std::vector<TileRef> &refs, const std::vector<uint8_t> &data)
+    {
+        // A resizing step stores every tile, so the reallocated image is fully overwritten
+        if (image.width != width || image.height != height)
+            image.Allocate(width, height);
+
+        int tilesX = TilesAcross(width);
+        uint32_t tileCount = (uint32_t)(tilesX * TilesAcross(height));
+        uint32_t tile[TILE_SIZE * TILE_SIZE];
+        for (const TileRef &ref : refs)
+        {
+            if (ref.index >= tileCount)
+                return false;
+            int x0 = (int)(ref.index % tilesX) * TILE_SIZE;
+            int y0 = (int)(ref.index / tilesX) * TILE_SIZE;
+            int tileWidth = std::min(TILE_SIZE, width - x0);
+            int tileHeight = std::min(TILE_SIZE, height - y0);
+            if (!DecodeTile(data.data() + ref.offset, ref.size, tile, tileWidth, tileWidth * tileHeight))
+                return false;
+            for (int y = 0; y < tileHeight; y++)
+                memcpy(image.Row(y0 + y) + x0, tile + y * tileWidth, (size_t)tileWidth * 4);
+        }
+        return true;
+    }
+}
\ No newline at end of file
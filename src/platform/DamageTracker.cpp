@@ -0,0 +1,231 @@
+#include "platform/DamageTracker.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace Platform
+{
+    namespace
+    {
+        inline uint64_t Mix(uint64_t hash, uint64_t value)
+        {
+            hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+
+        inline bool IsEmpty(const ImVec4 &rect)
+        {
+            return rect.z <= rect.x || rect.w <= rect.y;
+        }
+
+        inline void Union(ImVec4 &dst, const ImVec4 &src)
+        {
+            if (IsEmpty(src))
+                return;
+            if (IsEmpty(dst))
+            {
+                dst = src;
+                return;
+            }
+            dst.x = std::min(dst.x, src.x);
+            dst.y = std::min(dst.y, src.y);
+            dst.z = std::max(dst.z, src.z);
+            dst.w = std::max(dst.w, src.w);
+        }
+
+        inline bool SameVec2(const ImVec2 &a, const ImVec2 &b)
+        {
+            return a.x == b.x && a.y == b.y;
+        }
+    }
+
+    DamageTracker::DamageTracker() : m_history{}, m_historyFull{}, m_historyCount(0) {}
+
+    void DamageTracker::Invalidate()
+    {
+        m_previous.clear();
+        m_historyCount = 0;
+    }
+
+    void DamageTracker::BuildSignatures(const ImDrawData *drawData, std::vector<CommandSignature> &out) const
+    {
+        out.clear();
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList *drawList = drawData->CmdLists[n];
+            const ImDrawVert *vertices = drawList->VtxBuffer.Data;
+            const ImDrawIdx *indices = drawList->IdxBuffer.Data;
+
+            for (int c = 0; c < drawList->CmdBuffer.Size; c++)
+            {
+                const ImDrawCmd &cmd = drawList->CmdBuffer[c];
+                if (cmd.UserCallback != nullptr || cmd.ElemCount == 0)
+                    continue;
+
+                // Draw order matters where windows overlap, so it is part of the signature
+                uint64_t hash = Mix((uint64_t)n, (uint64_t)c);
+                hash = Mix(hash, (uint64_t)(uintptr_t)cmd.TexRef._TexData);
+                hash = Mix(hash, (uint64_t)cmd.TexRef._TexID);
+                uint32_t clip[4];
+                memcpy(clip, &cmd.ClipRect, sizeof(clip));
+                hash = Mix(hash, ((uint64_t)clip[0] << 32) | clip[1]);
+                hash = Mix(hash, ((uint64_t)clip[2] << 32) | clip[3]);
+
+                ImVec4 bounds(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+                for (unsigned int i = 0; i < cmd.ElemCount; i++)
+                {
+                    const ImDrawVert &v = vertices[cmd.VtxOffset + indices[cmd.IdxOffset + i]];
+                    uint32_t words[5];
+                    memcpy(words, &v, sizeof(words));
+                    hash = Mix(hash, ((uint64_t)words[0] << 32) | words[1]);
+                    hash = Mix(hash, ((uint64_t)words[2] << 32) | words[3]);
+                    hash = Mix(hash, words[4]);
+                    bounds.x = std::min(bounds.x, v.pos.x);
+                    bounds.y = std::min(bounds.y, v.pos.y);
+                    bounds.z = std::max(bounds.z, v.pos.x);
+                    bounds.w = std::max(bounds.w, v.pos.y);
+                }
+
+                // A texture whose pixels changed this frame damages everything drawn with it,
+                // even if the geometry is identical
+                if (cmd.TexRef._TexData != nullptr &&
+                    std::find(m_updatedTextures.begin(), m_updatedTextures.end(), cmd.TexRef._TexData) != m_updatedTextures.end())
+                {
+                    hash = Mix(hash, (uint64_t)ImGui::GetFrameCount());
+                }
+
+                // Pad by a pixel for antialiased fringes and rasterization rounding
+                bounds.x = std::max(bounds.x, cmd.ClipRect.x) - 1.0f;
+                bounds.y = std::max(bounds.y, cmd.ClipRect.y) - 1.0f;
+                bounds.z = std::min(bounds.z, cmd.ClipRect.z) + 1.0f;
+                bounds.w = std::min(bounds.w, cmd.ClipRect.w) + 1.0f;
+                out.push_back({hash, bounds});
+            }
+        }
+
+        std::sort(out.begin(), out.end(), [](const CommandSignature &a, const CommandSignature &b)
+                  { return a.hash < b.hash; });
+    }
+
+    void DamageTracker::Update(const ImDrawData *drawData)
+    {
+        if (drawData == nullptr || !drawData->Valid)
+            return;
+
+        m_updatedTextures.clear();
+        if (drawData->Textures != nullptr)
+        {
+            for (ImTextureData *tex : *drawData->Textures)
+            {
+                if (tex->Status == ImTextureStatus_WantCreate || tex->Status == ImTextureStatus_WantUpdates)
+                    m_updatedTextures.push_back(tex);
+            }
+        }
+
+        BuildSignatures(drawData, m_current);
+
+        bool full = m_historyCount == 0 ||
+                    !SameVec2(drawData->DisplayPos, m_displayPos) ||
+                    !SameVec2(drawData->DisplaySize, m_displaySize) ||
+                    !SameVec2(drawData->FramebufferScale, m_framebufferScale);
+        m_displayPos = drawData->DisplayPos;
+        m_displaySize = drawData->DisplaySize;
+        m_framebufferScale = drawData->FramebufferScale;
+
+        // Symmetric difference of the two sorted signature lists
+        ImVec4 damage(0, 0, 0, 0);
+        if (!full)
+        {
+            size_t a = 0;
+            size_t b = 0;
+            while (a < m_previous.size() || b < m_current.size())
+            {
+                if (b == m_current.size() || (a < m_previous.size() && m_previous[a].hash < m_current[b].hash))
+                {
+                    Union(damage, m_previous[a++].bounds);
+                }
+                else if (a == m_previous.size() || m_current[b].hash < m_previous[a].hash)
+                {
+                    Union(damage, m_current[b++].bounds);
+                }
+                else
+                {
+                    a++;
+                    b++;
+                }
+            }
+        }
+
+        for (int i = MAX_BUFFER_AGE - 1; i > 0; i--)
+        {
+            m_history[i] = m_history[i - 1];
+            m_historyFull[i] = m_historyFull[i - 1];
+        }
+        m_history[0] = damage;
+        m_historyFull[0] = full;
+        m_historyCount = std::min(m_historyCount + 1, MAX_BUFFER_AGE);
+
+        m_previous.swap(m_current);
+    }
+
+    bool DamageTracker::GetDamage(int bufferAge, ImVec4 &damage) const
+    {
+        if (bufferAge <= 0 || bufferAge > m_historyCount)
+            return false;
+
+        damage = ImVec4(0, 0, 0, 0);
+        for (int i = 0; i < bufferAge; i++)
+        {
+            if (m_historyFull[i])
+                return false;
+            Union(damage, m_history[i]);
+        }
+
+        // Clamp to the display
+        damage.x = std::max(damage.x, m_displayPos.x);
+        damage.y = std::max(damage.y, m_displayPos.y);
+        damage.z = std::min(damage.z, m_displayPos.x + m_displaySize.x);
+        damage.w = std::min(damage.w, m_displayPos.y + m_displaySize.y);
+        if (IsEmpty(damage))
+            damage = ImVec4(0, 0, 0, 0);
+        return true;
+    }
+
+    void DamageTracker::ClipDrawData(ImDrawData *drawData, const ImVec4 &damage)
+    {
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            ImDrawList *drawList = drawData->CmdLists[n];
+            for (ImDrawCmd &cmd : drawList->CmdBuffer)
+            {
+                cmd.ClipRect.x = std::max(cmd.ClipRect.x, damage.x);
+                cmd.ClipRect.y = std::max(cmd.ClipRect.y, damage.y);
+                cmd.ClipRect.z = std::min(cmd.ClipRect.z, damage.z);
+                cmd.ClipRect.w = std::min(cmd.ClipRect.w, damage.w);
+            }
+        }
+    }
+
+    FramebufferRect DamageTracker::ToFramebufferRect(const ImDrawData *drawData, const ImVec4 &rect)
+    {
+        int fbWidth = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        int fbHeight = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+
+        int x0 = (int)std::floor((rect.x - drawData->DisplayPos.x) * drawData->FramebufferScale.x);
+        int y0 = (int)std::floor((rect.y - drawData->DisplayPos.y) * drawData->FramebufferScale.y);
+        int x1 = (int)std::ceil((rect.z - drawData->DisplayPos.x) * drawData->FramebufferScale.x);
+        int y1 = (int)std::ceil((rect.w - drawData->DisplayPos.y) * drawData->FramebufferScale.y);
+        x0 = std::clamp(x0, 0, fbWidth);
+        y0 = std::clamp(y0, 0, fbHeight);
+        x1 = std::clamp(x1, 0, fbWidth);
+        y1 = std::clamp(y1, 0, fbHeight);
+
+        FramebufferRect result;
+        result.x = x0;
+        result.y = fbHeight - y1;
+        result.width = std::max(x1 - x0, 0);
+        result.height = std::max(y1 - y0, 0);
+        return result;
+    }
+}
\ No newline at end of file
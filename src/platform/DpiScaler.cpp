@@ -0,0 +1,80 @@
+#include "platform/DpiScaler.h"
+
+namespace Platform
+{
+    namespace
+    {
+        // Printable ASCII covers nearly everything the UI draws; other glyphs still load on demand
+        constexpr unsigned int PREWARM_FIRST = 0x20;
+        constexpr unsigned int PREWARM_LAST = 0x7E;
+        // Enough to finish the default font in two frames while keeping each slice well under a millisecond
+        constexpr int GLYPHS_PER_FRAME = 48;
+    }
+
+    DpiScaler::DpiScaler() : m_scale(1.0f), m_targetScale(1.0f), m_prewarmFont(0), m_prewarmCodepoint(PREWARM_FIRST) {}
+
+    void DpiScaler::Initialize(float scale)
+    {
+        m_baseStyle = ImGui::GetStyle();
+        m_scale = scale;
+        m_targetScale = scale;
+        ApplyStyle(scale);
+    }
+
+    void DpiScaler::RequestScale(float scale)
+    {
+        if (scale <= 0.0f || scale == m_targetScale)
+            return;
+
+        m_targetScale = scale;
+        m_prewarmFont = 0;
+        m_prewarmCodepoint = PREWARM_FIRST;
+
+        // Without dynamic font textures the backend cannot take glyphs mid-session anyway
+        if ((ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasTextures) == 0)
+            m_prewarmFont = ImGui::GetIO().Fonts->Fonts.Size;
+    }
+
+    void DpiScaler::BeginFrame()
+    {
+        if (!IsSwitching() || m_prewarmFont < ImGui::GetIO().Fonts->Fonts.Size)
+            return;
+
+        // Style changes must happen outside a frame
+        m_scale = m_targetScale;
+        ApplyStyle(m_scale);
+    }
+
+    void DpiScaler::Prewarm()
+    {
+        ImFontAtlas *atlas = ImGui::GetIO().Fonts;
+        if (!IsSwitching() || m_prewarmFont >= atlas->Fonts.Size)
+            return;
+
+        // Same size the style will request once FontScaleDpi changes, so the baked entry is reused
+        const ImGuiStyle &style = ImGui::GetStyle();
+        float fontSize = style.FontSizeBase * style.FontScaleMain * m_targetScale;
+
+        int budget = GLYPHS_PER_FRAME;
+        while (budget > 0 && m_prewarmFont < atlas->Fonts.Size)
+        {
+            ImFontBaked *baked = atlas->Fonts[m_prewarmFont]->GetFontBaked(fontSize);
+            for (; budget > 0 && m_prewarmCodepoint <= PREWARM_LAST; budget--)
+                baked->FindGlyph((ImWchar)m_prewarmCodepoint++);
+
+            if (m_prewarmCodepoint > PREWARM_LAST)
+            {
+                m_prewarmFont++;
+                m_prewarmCodepoint = PREWARM_FIRST;
+            }
+        }
+    }
+
+    void DpiScaler::ApplyStyle(float scale)
+    {
+        ImGuiStyle &style = ImGui::GetStyle();
+        style = m_baseStyle;
+        style.ScaleAllSizes(scale);
+        style.FontScaleDpi = scale;
+    }
+}
\ No newline at end of file
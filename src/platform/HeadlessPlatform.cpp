@@ -0,0 +1,218 @@
+#include "platform/HeadlessPlatform.h"
+#include <iostream>
+
+namespace Platform
+{
+    HeadlessPlatform::HeadlessPlatform()
+        : m_width(0), m_height(0), m_deltaTime(1.0f / 60.0f), m_shouldClose(false), m_globalMouseX(0), m_globalMouseY(0), m_imguiContext(nullptr)
+    {
+    }
+
+    HeadlessPlatform::~HeadlessPlatform() { Shutdown(); }
+
+    bool HeadlessPlatform::Initialize(const WindowConfig &config)
+    {
+        m_config = config;
+        m_width = config.width;
+        m_height = config.height;
+
+        if (!InitializeRenderer())
+        {
+            return false;
+        }
+
+        if (!InitializeImGui())
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    bool HeadlessPlatform::InitializeRenderer() { return true; }
+
+    bool HeadlessPlatform::InitializeImGui()
+    {
+        IMGUI_CHECKVERSION();
+        m_imguiContext = ImGui::CreateContext();
+        ImGui::SetCurrentContext(m_imguiContext);
+
+        ImGuiIO &io = ImGui::GetIO();
+        io.IniFilename = nullptr; // Keep runs reproducible, never load or save window layout
+        io.BackendPlatformName = "headless";
+        io.BackendRendererName = "headless";
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+
+        ImGui::StyleColorsDark();
+        m_dpiScaler.Initialize(1.0f);
+
+        return true;
+    }
+
+    void HeadlessPlatform::Shutdown()
+    {
+        if (m_imguiContext)
+        {
+            if (m_softwareRenderer)
+                m_softwareRenderer->DestroyAllTextures();
+
+            // Release the textures we "own" the same way a renderer backend would
+            for (ImTextureData *tex : ImGui::GetPlatformIO().Textures)
+            {
+                if (tex->RefCount == 1)
+                {
+                    tex->SetTexID(ImTextureID_Invalid);
+                    tex->SetStatus(ImTextureStatus_Destroyed);
+                }
+            }
+            ImGui::DestroyContext(m_imguiContext);
+            m_imguiContext = nullptr;
+        }
+    }
+
+    bool HeadlessPlatform::ShouldClose() { return m_shouldClose; }
+
+    void HeadlessPlatform::PollEvents() {}
+
+    void HeadlessPlatform::SetWindowTitle(const std::string &title) { m_config.title = title; }
+
+    void HeadlessPlatform::GetWindowSize(int &width, int &height)
+    {
+        width = m_width;
+        height = m_height;
+    }
+
+    void HeadlessPlatform::SetWindowSize(int width, int height)
+    {
+        m_width = width;
+        m_height = height;
+    }
+
+    void HeadlessPlatform::NewFrame()
+    {
+        m_renderStats.BeginCpuFrame();
+        ImGuiIO &io = ImGui::GetIO();
+        io.DisplaySize = ImVec2((float)m_width, (float)m_height);
+        io.DisplayFramebufferScale = ImVec2(1.0f, 1.0f);
+        io.DeltaTime = m_deltaTime;
+        m_dpiScaler.BeginFrame();
+        ImGui::NewFrame();
+        m_dpiScaler.Prewarm();
+    }
+
+    void HeadlessPlatform::SetClearColor(ImVec4 &color)
+    {
+        m_clearColor = color;
+    }
+
+    void HeadlessPlatform::RenderFrame()
+    {
+        if (m_frameCallback)
+            m_frameCallback();
+
+        ImGui::Render();
+        ImDrawData *drawData = ImGui::GetDrawData();
+        m_renderStats.Collect(drawData);
+        if (m_softwareRenderer)
+        {
+            m_softwareRenderer->UpdateTextures(drawData);
+            m_softwareRenderer->Render(drawData, m_clearColor);
+        }
+        else
+        {
+            UpdateTextures(drawData);
+        }
+        m_renderStats.EndCpuFrame();
+    }
+
+    void HeadlessPlatform::EnableSoftwareRenderer(int threadCount)
+    {
+        if (!m_softwareRenderer)
+            m_softwareRenderer = std::make_unique<SoftwareRenderer>(threadCount);
+    }
+
+    bool HeadlessPlatform::SaveSnapshot(const std::string &path) const
+    {
+        if (!m_softwareRenderer)
+        {
+            std::cerr << "Snapshot requires the software renderer" << std::endl;
+            return false;
+        }
+        return m_softwareRenderer->SaveSnapshot(path);
+    }
+
+    void HeadlessPlatform::UpdateTextures(ImDrawData *drawData)
+    {
+        if (drawData->Textures == nullptr)
+            return;
+
+        // Acknowledge texture requests so ImGui treats them as uploaded
+        for (ImTextureData *tex : *drawData->Textures)
+        {
+            if (tex->Status == ImTextureStatus_WantCreate)
+            {
+                tex->SetTexID((ImTextureID)(intptr_t)tex);
+                tex->SetStatus(ImTextureStatus_OK);
+            }
+            else if (tex->Status == ImTextureStatus_WantUpdates)
+            {
+                tex->SetStatus(ImTextureStatus_OK);
+            }
+            else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+            {
+                tex->SetTexID(ImTextureID_Invalid);
+                tex->SetStatus(ImTextureStatus_Destroyed);
+            }
+        }
+    }
+
+    bool HeadlessPlatform::GetGlobalMousePosition(int &x, int &y)
+    {
+        x = m_globalMouseX;
+        y = m_globalMouseY;
+        return true;
+    }
+
+    bool HeadlessPlatform::GrabScreenRegion(int x, int y, int width, int height, Imaging::Image &out)
+    {
+        if (width <= 0 || height <= 0)
+            return false;
+        if (out.width != width || out.height != height)
+            out.Allocate(width, height);
+
+        // Deterministic desktop: gradients with a 16 px checker, black outside
+        for (int row = 0; row < height; row++)
+        {
+            uint32_t *dst = out.Row(row);
+            int sy = y + row;
+            for (int column = 0; column < width; column++)
+            {
+                int sx = x + column;
+                if (sx < 0 || sy < 0 || sx >= DESKTOP_WIDTH || sy >= DESKTOP_HEIGHT)
+                {
+                    dst[column] = 0xFF000000u;
+                    continue;
+                }
+                uint32_t checker = ((sx >> 4) ^ (sy >> 4)) & 1 ? 0x40u : 0x00u;
+                dst[column] = 0xFF000000u | (uint32_t)(sx & 0xFF) | ((uint32_t)(sy & 0xFF) << 8) | (checker << 16);
+            }
+        }
+        return true;
+    }
+
+    bool HeadlessPlatform::CaptureDesktop(Imaging::Image &out, std::vector<DesktopOutput> &outputs)
+    {
+        // A single monitor covering the synthetic desktop
+        outputs.clear();
+        DesktopOutput output;
+        output.width = DESKTOP_WIDTH;
+        output.height = DESKTOP_HEIGHT;
+        outputs.push_back(output);
+        return GrabScreenRegion(0, 0, DESKTOP_WIDTH, DESKTOP_HEIGHT, out);
+    }
+
+    void *HeadlessPlatform::GetNativeWindow() { return nullptr; }
+
+    void *HeadlessPlatform::GetNativeRenderer() { return nullptr; }
+}
\ No newline at end of file
@@ -0,0 +1,231 @@
+#include "platform/RenderStats.h"
+#include "Profiler.h"
+#include <cstdio>
+#include <utility>
+
+namespace Platform
+{
+    RenderStats::RenderStats() : m_listCount(0), m_textureBytes(0), m_bufferBytes(0), m_gpuHistory{}, m_cpuHistory{}, m_historyIndex(0), m_line{} {}
+
+    void RenderStats::Collect(const ImDrawData *drawData)
+    {
+        // Reset the counters but keep the per-list storage so steady-state frames do not allocate.
+        // The GPU time is carried over since timer results arrive a frame or two late.
+        FrameRenderStats next;
+        next.gpuTimeMs = m_frame.gpuTimeMs;
+        next.frameIntervalMs = m_frame.frameIntervalMs;
+        next.lists.swap(m_frame.lists);
+        next.textureUploads.swap(m_frame.textureUploads);
+        next.textureUploads.clear();
+        m_frame = std::move(next);
+        m_listCount = 0;
+
+        if (drawData == nullptr || !drawData->Valid)
+        {
+            m_frame.lists.clear();
+            return;
+        }
+
+        if ((int)m_frame.lists.size() < drawData->CmdListsCount)
+            m_frame.lists.resize(drawData->CmdListsCount);
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList *drawList = drawData->CmdLists[n];
+            DrawListStats &list = m_frame.lists[m_listCount++];
+            list = DrawListStats();
+            snprintf(list.owner, sizeof(list.owner), "%s", drawList->_OwnerName ? drawList->_OwnerName : "(unnamed)");
+            list.vertices = drawList->VtxBuffer.Size;
+            list.indices = drawList->IdxBuffer.Size;
+            list.uploadBytes = (size_t)drawList->VtxBuffer.Size * sizeof(ImDrawVert) + (size_t)drawList->IdxBuffer.Size * sizeof(ImDrawIdx);
+
+            // The GL backend binds a texture for every command; count only actual changes,
+            // since redundant binds are elided by the driver
+            const ImDrawCmd *previous = nullptr;
+            for (const ImDrawCmd &cmd : drawList->CmdBuffer)
+            {
+                if (cmd.UserCallback != nullptr)
+                    continue;
+                list.drawCalls++;
+                if (previous == nullptr || previous->TexRef != cmd.TexRef)
+                    list.textureBinds++;
+                previous = &cmd;
+            }
+
+            m_frame.drawCalls += list.drawCalls;
+            m_frame.vertices += list.vertices;
+            m_frame.indices += list.indices;
+            m_frame.textureBinds += list.textureBinds;
+            m_frame.geometryUploadBytes += list.uploadBytes;
+            if (list.uploadBytes > m_bufferBytes)
+                m_bufferBytes = list.uploadBytes;
+        }
+        m_frame.lists.resize(m_listCount);
+
+        // Pending texture creations/updates are uploaded by the backend during this frame
+        if (drawData->Textures != nullptr)
+        {
+            for (const ImTextureData *tex : *drawData->Textures)
+            {
+                if (tex->Status == ImTextureStatus_WantCreate)
+                {
+                    size_t bytes = (size_t)tex->Width * tex->Height * tex->BytesPerPixel;
+                    m_frame.textureUploadBytes += bytes;
+                    m_frame.textureUploads.push_back({tex->UniqueID, bytes, -1.0});
+                    TrackTexture(tex->UniqueID, bytes);
+                }
+                else if (tex->Status == ImTextureStatus_WantUpdates)
+                {
+                    size_t bytes = 0;
+                    for (const ImTextureRect &rect : tex->Updates)
+                        bytes += (size_t)rect.w * rect.h * tex->BytesPerPixel;
+                    m_frame.textureUploadBytes += bytes;
+                    m_frame.textureUploads.push_back({tex->UniqueID, bytes, -1.0});
+                }
+                else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+                {
+                    // Same condition the backends use before they actually free the texture
+                    TrackTexture(tex->UniqueID, 0);
+                }
+            }
+        }
+    }
+
+    void RenderStats::BeginCpuFrame()
+    {
+        auto now = std::chrono::steady_clock::now();
+        if (m_cpuFrameStart.time_since_epoch().count() != 0)
+            m_frame.frameIntervalMs = std::chrono::duration<double, std::milli>(now - m_cpuFrameStart).count();
+        m_cpuFrameStart = now;
+    }
+
+    void RenderStats::EndCpuFrame()
+    {
+        m_frame.cpuTimeMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - m_cpuFrameStart).count();
+        m_cpuHistory[m_historyIndex] = (float)m_frame.cpuTimeMs;
+        m_gpuHistory[m_historyIndex] = m_frame.gpuTimeMs > 0.0 ? (float)m_frame.gpuTimeMs : 0.0f;
+        m_historyIndex = (m_historyIndex + 1) % HISTORY_SIZE;
+    }
+
+    void RenderStats::TrackTexture(int id, size_t bytes)
+    {
+        auto it = m_textureSizes.find(id);
+        if (it != m_textureSizes.end())
+        {
+            m_textureBytes -= it->second;
+            m_textureSizes.erase(it);
+        }
+        if (bytes > 0)
+        {
+            m_textureSizes[id] = bytes;
+            m_textureBytes += bytes;
+        }
+    }
+
+    void RenderStats::SetTextureUploadTime(int textureId, double milliseconds)
+    {
+        for (TextureUploadStats &upload : m_frame.textureUploads)
+        {
+            if (upload.textureId != textureId)
+                continue;
+            upload.ms = milliseconds;
+            m_frame.textureUploadMs += milliseconds;
+            return;
+        }
+    }
+
+    void RenderStats::SetGpuTime(double milliseconds)
+    {
+        m_frame.gpuTimeMs = milliseconds;
+    }
+
+    void RenderStats::DrawOverlay(bool *open)
+    {
+        ImGui::SetNextWindowBgAlpha(0.85f);
+        if (!ImGui::Begin("Renderer Stats", open, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoFocusOnAppearing))
+        {
+            ImGui::End();
+            return;
+        }
+
+        // CPU and GPU work against the frame interval tells CPU-bound, GPU-bound and vsync-limited apart
+        if (m_frame.gpuTimeMs >= 0.0)
+            snprintf(m_line, sizeof(m_line), "CPU %.2f ms | GPU %.3f ms | interval %.2f ms", m_frame.cpuTimeMs, m_frame.gpuTimeMs, m_frame.frameIntervalMs);
+        else
+            snprintf(m_line, sizeof(m_line), "CPU %.2f ms | GPU n/a (no timer queries) | interval %.2f ms", m_frame.cpuTimeMs, m_frame.frameIntervalMs);
+        ImGui::TextUnformatted(m_line);
+
+        ImGui::PlotLines("CPU ms", m_cpuHistory, HISTORY_SIZE, m_historyIndex, nullptr, 0.0f, 33.3f, ImVec2(0, 40));
+        ImGui::PlotLines("GPU ms", m_gpuHistory, HISTORY_SIZE, m_historyIndex, nullptr, 0.0f, 33.3f, ImVec2(0, 40));
+
+        snprintf(m_line, sizeof(m_line), "Draw calls %d | Vertices %d | Indices %d | Texture binds %d",
+                 m_frame.drawCalls, m_frame.vertices, m_frame.indices, m_frame.textureBinds);
+        ImGui::TextUnformatted(m_line);
+        snprintf(m_line, sizeof(m_line), "Uploaded %.1f KB geometry + %.1f KB textures (%.3f ms)",
+                 m_frame.geometryUploadBytes / 1024.0, m_frame.textureUploadBytes / 1024.0, m_frame.textureUploadMs);
+        ImGui::TextUnformatted(m_line);
+        for (const TextureUploadStats &upload : m_frame.textureUploads)
+        {
+            if (upload.ms >= 0.0)
+                snprintf(m_line, sizeof(m_line), "  texture #%d: %.1f KB in %.3f ms", upload.textureId, upload.bytes / 1024.0, upload.ms);
+            else
+                snprintf(m_line, sizeof(m_line), "  texture #%d: %.1f KB", upload.textureId, upload.bytes / 1024.0);
+            ImGui::TextUnformatted(m_line);
+        }
+        snprintf(m_line, sizeof(m_line), "Resident %.1f MB textures (%d) + %.1f KB buffers",
+                 m_textureBytes / (1024.0 * 1024.0), (int)m_textureSizes.size(), m_bufferBytes / 1024.0);
+        ImGui::TextUnformatted(m_line);
+
+        if (ImGui::BeginTable("##drawlists", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Window");
+            ImGui::TableSetupColumn("Draws");
+            ImGui::TableSetupColumn("Vtx");
+            ImGui::TableSetupColumn("Idx");
+            ImGui::TableSetupColumn("KB");
+            ImGui::TableHeadersRow();
+            for (const DrawListStats &list : m_frame.lists)
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(list.owner);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", list.drawCalls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", list.vertices);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", list.indices);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", list.uploadBytes / 1024.0);
+            }
+            ImGui::EndTable();
+        }
+
+        // Tools and other work that profiles itself, previous frame
+        const Profiler &profiler = Profiler::Get();
+        if (profiler.GetScopeCount() > 0 && ImGui::BeginTable("##scopes", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            ImGui::TableSetupColumn("Scope");
+            ImGui::TableSetupColumn("ms");
+            ImGui::TableSetupColumn("Avg ms");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableHeadersRow();
+            for (int i = 0; i < profiler.GetScopeCount(); i++)
+            {
+                const Profiler::ScopeStats &scope = profiler.GetScope(i);
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(scope.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", scope.lastMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", scope.averageMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%d", scope.lastCalls);
+            }
+            ImGui::EndTable();
+        }
+
+        ImGui::End();
+    }
+}
\ No newline at end of file
@@ -0,0 +1,511 @@
+#include "platform/SoftwareRenderer.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+// SOFTWARE_RENDERER_NO_SSE2 forces the scalar path, so tests can check that both paths produce
+// the same pixels
+#if !defined(SOFTWARE_RENDERER_NO_SSE2) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SOFTWARE_RENDERER_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace Platform
+{
+    namespace
+    {
+        uint32_t PackColor(float r, float g, float b, float a)
+        {
+            auto toByte = [](float c)
+            { return (uint32_t)std::lround(std::clamp(c, 0.0f, 1.0f) * 255.0f); };
+            return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+        }
+
+#ifdef SOFTWARE_RENDERER_SSE2
+        inline __m128 Unpack(uint32_t pixel)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            __m128i p = _mm_cvtsi32_si128((int)pixel);
+            p = _mm_unpacklo_epi8(p, zero);
+            p = _mm_unpacklo_epi16(p, zero);
+            return _mm_mul_ps(_mm_cvtepi32_ps(p), _mm_set1_ps(1.0f / 255.0f));
+        }
+
+        inline uint32_t Pack(__m128 color)
+        {
+            __m128i p = _mm_cvtps_epi32(_mm_mul_ps(color, _mm_set1_ps(255.0f)));
+            p = _mm_packs_epi32(p, p);
+            p = _mm_packus_epi16(p, p);
+            return (uint32_t)_mm_cvtsi128_si32(p);
+        }
+
+        inline __m128 Lerp(__m128 a, __m128 b, float t)
+        {
+            return _mm_add_ps(a, _mm_mul_ps(_mm_sub_ps(b, a), _mm_set1_ps(t)));
+        }
+#else
+        struct Color4
+        {
+            float c[4];
+        };
+
+        inline Color4 Unpack(uint32_t pixel)
+        {
+            Color4 out;
+            for (int i = 0; i < 4; i++)
+                out.c[i] = ((pixel >> (i * 8)) & 0xFF) * (1.0f / 255.0f);
+            return out;
+        }
+
+        inline uint32_t Pack(const Color4 &color)
+        {
+            // Rounds half to even, as _mm_cvtps_epi32 does
+            uint32_t out = 0;
+            for (int i = 0; i < 4; i++)
+                out |= (uint32_t)std::nearbyint(std::clamp(color.c[i], 0.0f, 1.0f) * 255.0f) << (i * 8);
+            return out;
+        }
+
+        inline Color4 Lerp(const Color4 &a, const Color4 &b, float t)
+        {
+            Color4 out;
+            for (int i = 0; i < 4; i++)
+                out.c[i] = a.c[i] + (b.c[i] - a.c[i]) * t;
+            return out;
+        }
+#endif
+
+        // Bilinear sampling with clamp-to-edge addressing. At 1:1 scale (text, icons) the sample
+        // point lands exactly on a texel center and this reduces to a single fetch.
+        template <typename Texture>
+        inline auto Sample(const Texture &texture, float u, float v)
+        {
+            float x = u * texture.width - 0.5f;
+            float y = v * texture.height - 0.5f;
+            float fx0 = std::floor(x);
+            float fy0 = std::floor(y);
+            float fx = x - fx0;
+            float fy = y - fy0;
+            int x0 = std::clamp((int)fx0, 0, texture.width - 1);
+            int y0 = std::clamp((int)fy0, 0, texture.height - 1);
+            const uint32_t *row0 = texture.pixels.data() + (size_t)y0 * texture.width;
+            if (fx == 0.0f && fy == 0.0f)
+                return Unpack(row0[x0]);
+
+            int x1 = std::min(x0 + 1, texture.width - 1);
+            int y1 = std::min(y0 + 1, texture.height - 1);
+            const uint32_t *row1 = texture.pixels.data() + (size_t)y1 * texture.width;
+            auto top = Lerp(Unpack(row0[x0]), Unpack(row0[x1]), fx);
+            auto bottom = Lerp(Unpack(row1[x0]), Unpack(row1[x1]), fx);
+            return Lerp(top, bottom, fy);
+        }
+    }
+
+    SoftwareRenderer::SoftwareRenderer(int threadCount) : m_pool(threadCount), m_width(0), m_height(0), m_tilesX(0), m_tilesY(0) {}
+
+    SoftwareRenderer::~SoftwareRenderer() = default;
+
+    void SoftwareRenderer::CopyTextureRect(Texture &dst, ImTextureData *src, int x, int y, int width, int height)
+    {
+        for (int row = 0; row < height; row++)
+        {
+            const unsigned char *in = (const unsigned char *)src->GetPixelsAt(x, y + row);
+            uint32_t *out = dst.pixels.data() + (size_t)(y + row) * dst.width + x;
+            if (src->Format == ImTextureFormat_RGBA32)
+            {
+                memcpy(out, in, (size_t)width * 4);
+            }
+            else
+            {
+                // Alpha8: white with coverage in alpha, as the GL backend's swizzle would produce
+                for (int i = 0; i < width; i++)
+                    out[i] = 0x00FFFFFFu | ((uint32_t)in[i] << 24);
+            }
+        }
+    }
+
+    void SoftwareRenderer::UpdateTextures(ImDrawData *drawData)
+    {
+        if (drawData == nullptr || drawData->Textures == nullptr)
+            return;
+
+        for (ImTextureData *tex : *drawData->Textures)
+        {
+            if (tex->Status == ImTextureStatus_WantCreate)
+            {
+                auto texture = std::make_unique<Texture>();
+                texture->width = tex->Width;
+                texture->height = tex->Height;
+                texture->pixels.resize((size_t)tex->Width * tex->Height);
+                CopyTextureRect(*texture, tex, 0, 0, tex->Width, tex->Height);
+                tex->SetTexID((ImTextureID)(intptr_t)texture.get());
+                tex->BackendUserData = texture.get();
+                tex->SetStatus(ImTextureStatus_OK);
+                m_textures.push_back(std::move(texture));
+            }
+            else if (tex->Status == ImTextureStatus_WantUpdates)
+            {
+                Texture *texture = (Texture *)tex->BackendUserData;
+                for (const ImTextureRect &rect : tex->Updates)
+                    CopyTextureRect(*texture, tex, rect.x, rect.y, rect.w, rect.h);
+                tex->SetStatus(ImTextureStatus_OK);
+            }
+            else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
+            {
+                Texture *texture = (Texture *)tex->BackendUserData;
+                m_textures.erase(std::remove_if(m_textures.begin(), m_textures.end(), [texture](const std::unique_ptr<Texture> &t)
+                                                { return t.get() == texture; }),
+                                 m_textures.end());
+                tex->SetTexID(ImTextureID_Invalid);
+                tex->BackendUserData = nullptr;
+                tex->SetStatus(ImTextureStatus_Destroyed);
+            }
+        }
+    }
+
+    void SoftwareRenderer::DestroyAllTextures()
+    {
+        for (ImTextureData *tex : ImGui::GetPlatformIO().Textures)
+        {
+            if (tex->RefCount == 1 && tex->BackendUserData != nullptr)
+            {
+                tex->SetTexID(ImTextureID_Invalid);
+                tex->BackendUserData = nullptr;
+                tex->SetStatus(ImTextureStatus_Destroyed);
+            }
+        }
+        m_textures.clear();
+    }
+
+    void SoftwareRenderer::Render(const ImDrawData *drawData, const ImVec4 &clearColor, const ImVec4 *region)
+    {
+        if (drawData == nullptr || !drawData->Valid)
+            return;
+
+        int width = (int)(drawData->DisplaySize.x * drawData->FramebufferScale.x);
+        int height = (int)(drawData->DisplaySize.y * drawData->FramebufferScale.y);
+        if (width <= 0 || height <= 0)
+            return;
+
+        // A resize invalidates the previous contents, so partial redraws are not possible
+        if (width != m_width || height != m_height)
+        {
+            m_width = width;
+            m_height = height;
+            m_pixels.assign((size_t)width * height, 0);
+            m_tilesX = (width + TILE_SIZE - 1) / TILE_SIZE;
+            m_tilesY = (height + TILE_SIZE - 1) / TILE_SIZE;
+            region = nullptr;
+        }
+
+        int limitX0 = 0;
+        int limitY0 = 0;
+        int limitX1 = width;
+        int limitY1 = height;
+        if (region != nullptr)
+        {
+            const ImVec2 &offset = drawData->DisplayPos;
+            const ImVec2 &scale = drawData->FramebufferScale;
+            limitX0 = std::clamp((int)std::floor((region->x - offset.x) * scale.x), 0, width);
+            limitY0 = std::clamp((int)std::floor((region->y - offset.y) * scale.y), 0, height);
+            limitX1 = std::clamp((int)std::ceil((region->z - offset.x) * scale.x), 0, width);
+            limitY1 = std::clamp((int)std::ceil((region->w - offset.y) * scale.y), 0, height);
+            if (limitX1 <= limitX0 || limitY1 <= limitY0)
+                return;
+        }
+
+        // Same premultiplied clear as the GL path
+        uint32_t clearPixel = PackColor(clearColor.x * clearColor.w, clearColor.y * clearColor.w, clearColor.z * clearColor.w, clearColor.w);
+
+        m_bins.resize((size_t)m_tilesX * m_tilesY);
+        for (std::vector<uint32_t> &bin : m_bins)
+            bin.clear();
+        BinTriangles(drawData, limitX0, limitY0, limitX1, limitY1);
+
+        m_pool.ParallelFor(m_tilesX * m_tilesY, [&](int tile)
+                           { RasterizeTile(tile, clearPixel, limitX0, limitY0, limitX1, limitY1); });
+    }
+
+    void SoftwareRenderer::BinTriangles(const ImDrawData *drawData, int limitX0, int limitY0, int limitX1, int limitY1)
+    {
+        m_triangles.clear();
+        const ImVec2 offset = drawData->DisplayPos;
+        const ImVec2 scale = drawData->FramebufferScale;
+
+        for (int n = 0; n < drawData->CmdListsCount; n++)
+        {
+            const ImDrawList *drawList = drawData->CmdLists[n];
+            const ImDrawVert *vertices = drawList->VtxBuffer.Data;
+            const ImDrawIdx *indices = drawList->IdxBuffer.Data;
+
+            for (const ImDrawCmd &cmd : drawList->CmdBuffer)
+            {
+                if (cmd.UserCallback != nullptr)
+                {
+                    // There is no GPU state to reset; other callbacks still run in submission order
+                    if (cmd.UserCallback != ImDrawCallback_ResetRenderState)
+                        cmd.UserCallback(drawList, &cmd);
+                    continue;
+                }
+
+                // Clip rect to framebuffer pixels, truncated like the GL backend's scissor
+                int clipX0 = std::max((int)((cmd.ClipRect.x - offset.x) * scale.x), limitX0);
+                int clipY0 = std::max((int)((cmd.ClipRect.y - offset.y) * scale.y), limitY0);
+                int clipX1 = std::min((int)((cmd.ClipRect.z - offset.x) * scale.x), limitX1);
+                int clipY1 = std::min((int)((cmd.ClipRect.w - offset.y) * scale.y), limitY1);
+                if (clipX1 <= clipX0 || clipY1 <= clipY0)
+                    continue;
+
+                const Texture *texture = (const Texture *)(intptr_t)cmd.GetTexID();
+                for (unsigned int i = 0; i + 2 < cmd.ElemCount; i += 3)
+                {
+                    const ImDrawVert *v[3];
+                    ImVec2 p[3];
+                    for (int k = 0; k < 3; k++)
+                    {
+                        v[k] = &vertices[cmd.VtxOffset + indices[cmd.IdxOffset + i + k]];
+                        p[k] = ImVec2((v[k]->pos.x - offset.x) * scale.x, (v[k]->pos.y - offset.y) * scale.y);
+                    }
+
+                    float area = (p[1].x - p[0].x) * (p[2].y - p[0].y) - (p[1].y - p[0].y) * (p[2].x - p[0].x);
+                    if (area == 0.0f)
+                        continue;
+                    if (area < 0.0f)
+                    {
+                        // Normalize the winding so "inside" is positive for every edge
+                        std::swap(v[1], v[2]);
+                        std::swap(p[1], p[2]);
+                        area = -area;
+                    }
+
+                    float minX = std::min({p[0].x, p[1].x, p[2].x});
+                    float minY = std::min({p[0].y, p[1].y, p[2].y});
+                    float maxX = std::max({p[0].x, p[1].x, p[2].x});
+                    float maxY = std::max({p[0].y, p[1].y, p[2].y});
+
+                    TriangleSetup tri;
+                    tri.minX = std::max((int)std::floor(minX), clipX0);
+                    tri.minY = std::max((int)std::floor(minY), clipY0);
+                    tri.maxX = std::min((int)std::ceil(maxX), clipX1) - 1;
+                    tri.maxY = std::min((int)std::ceil(maxY), clipY1) - 1;
+                    if (tri.maxX < tri.minX || tri.maxY < tri.minY)
+                        continue;
+
+                    // Edge k is opposite vertex k, so its value is vertex k's barycentric weight
+                    for (int k = 0; k < 3; k++)
+                    {
+                        const ImVec2 &from = p[(k + 1) % 3];
+                        const ImVec2 &to = p[(k + 2) % 3];
+                        tri.edgeA[k] = from.y - to.y;
+                        tri.edgeB[k] = to.x - from.x;
+                        tri.edgeC[k] = -tri.edgeB[k] * from.y - tri.edgeA[k] * from.x;
+                        // Top-left fill rule, so pixels on shared edges are not blended twice
+                        tri.topLeft[k] = tri.edgeA[k] > 0.0f || (tri.edgeA[k] == 0.0f && tri.edgeB[k] > 0.0f);
+
+                        tri.u[k] = v[k]->uv.x;
+                        tri.v[k] = v[k]->uv.y;
+                        for (int c = 0; c < 4; c++)
+                            tri.color[k][c] = ((v[k]->col >> (c * 8)) & 0xFF) * (1.0f / 255.0f);
+                    }
+                    tri.invArea = 1.0f / area;
+                    tri.texture = texture;
+
+                    uint32_t index = (uint32_t)m_triangles.size();
+                    m_triangles.push_back(tri);
+                    for (int ty = tri.minY / TILE_SIZE; ty <= tri.maxY / TILE_SIZE; ty++)
+                    {
+                        for (int tx = tri.minX / TILE_SIZE; tx <= tri.maxX / TILE_SIZE; tx++)
+                            m_bins[(size_t)ty * m_tilesX + tx].push_back(index);
+                    }
+                }
+            }
+        }
+    }
+
+    void SoftwareRenderer::RasterizeTile(int tileIndex, uint32_t clearPixel, int limitX0, int limitY0, int limitX1, int limitY1)
+    {
+        int tileX = tileIndex % m_tilesX;
+        int tileY = tileIndex / m_tilesX;
+        int x0 = std::max(tileX * TILE_SIZE, limitX0);
+        int y0 = std::max(tileY * TILE_SIZE, limitY0);
+        int x1 = std::min((tileX + 1) * TILE_SIZE, limitX1) - 1;
+        int y1 = std::min((tileY + 1) * TILE_SIZE, limitY1) - 1;
+        if (x1 < x0 || y1 < y0)
+            return;
+
+        for (int y = y0; y <= y1; y++)
+        {
+            uint32_t *row = m_pixels.data() + (size_t)y * m_width;
+            std::fill(row + x0, row + x1 + 1, clearPixel);
+        }
+
+        for (uint32_t index : m_bins[tileIndex])
+        {
+            const TriangleSetup &tri = m_triangles[index];
+            int tx0 = std::max(tri.minX, x0);
+            int ty0 = std::max(tri.minY, y0);
+            int tx1 = std::min(tri.maxX, x1);
+            int ty1 = std::min(tri.maxY, y1);
+            if (tx1 >= tx0 && ty1 >= ty0)
+                RasterizeTriangle(tri, tx0, ty0, tx1, ty1);
+        }
+    }
+
+    void SoftwareRenderer::RasterizeTriangle(const TriangleSetup &tri, int x0, int y0, int x1, int y1)
+    {
+#ifdef SOFTWARE_RENDERER_SSE2
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 laneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128 rgbMask = _mm_castsi128_ps(_mm_setr_epi32(-1, -1, -1, 0));
+        const __m128 alphaOne = _mm_setr_ps(0.0f, 0.0f, 0.0f, 1.0f);
+        const __m128 one = _mm_set1_ps(1.0f);
+
+        __m128 edgeA[3];
+        __m128 topLeft[3];
+        __m128 vertexColor[3];
+        for (int k = 0; k < 3; k++)
+        {
+            edgeA[k] = _mm_set1_ps(tri.edgeA[k]);
+            topLeft[k] = tri.topLeft[k] ? _mm_castsi128_ps(_mm_set1_epi32(-1)) : zero;
+            vertexColor[k] = _mm_loadu_ps(tri.color[k]);
+        }
+        const __m128 invArea = _mm_set1_ps(tri.invArea);
+        const __m128 lastX = _mm_set1_ps((float)x1 + 1.0f);
+
+        alignas(16) float weight[3][4];
+        for (int y = y0; y <= y1; y++)
+        {
+            uint32_t *row = m_pixels.data() + (size_t)y * m_width;
+            float py = (float)y + 0.5f;
+
+            for (int x = x0; x <= x1; x += 4)
+            {
+                // Evaluate the three edge functions for four pixel centers at once
+                __m128 px = _mm_add_ps(_mm_set1_ps((float)x), laneOffsets);
+                __m128 inside = _mm_cmplt_ps(px, lastX);
+                for (int k = 0; k < 3; k++)
+                {
+                    __m128 e = _mm_add_ps(_mm_mul_ps(edgeA[k], px), _mm_set1_ps(tri.edgeB[k] * py + tri.edgeC[k]));
+                    __m128 covered = _mm_or_ps(_mm_cmpgt_ps(e, zero), _mm_and_ps(_mm_cmpeq_ps(e, zero), topLeft[k]));
+                    inside = _mm_and_ps(inside, covered);
+                    _mm_store_ps(weight[k], _mm_mul_ps(e, invArea));
+                }
+
+                int laneMask = _mm_movemask_ps(inside);
+                for (int lane = 0; laneMask != 0; lane++, laneMask >>= 1)
+                {
+                    if (!(laneMask & 1))
+                        continue;
+
+                    float w0 = weight[0][lane];
+                    float w1 = weight[1][lane];
+                    float w2 = weight[2][lane];
+                    __m128 src = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vertexColor[0], _mm_set1_ps(w0)), _mm_mul_ps(vertexColor[1], _mm_set1_ps(w1))),
+                                            _mm_mul_ps(vertexColor[2], _mm_set1_ps(w2)));
+                    if (tri.texture != nullptr)
+                    {
+                        float u = tri.u[0] * w0 + tri.u[1] * w1 + tri.u[2] * w2;
+                        float v = tri.v[0] * w0 + tri.v[1] * w1 + tri.v[2] * w2;
+                        src = _mm_mul_ps(src, Sample(*tri.texture, u, v));
+                    }
+
+                    // GL_SRC_ALPHA / GL_ONE_MINUS_SRC_ALPHA for color, GL_ONE / GL_ONE_MINUS_SRC_ALPHA for alpha
+                    __m128 alpha = _mm_shuffle_ps(src, src, _MM_SHUFFLE(3, 3, 3, 3));
+                    if (_mm_cvtss_f32(alpha) <= 0.0f)
+                        continue;
+                    __m128 srcFactor = _mm_or_ps(_mm_and_ps(alpha, rgbMask), alphaOne);
+                    uint32_t *pixel = &row[x + lane];
+                    __m128 dst = Unpack(*pixel);
+                    *pixel = Pack(_mm_add_ps(_mm_mul_ps(src, srcFactor), _mm_mul_ps(dst, _mm_sub_ps(one, alpha))));
+                }
+            }
+        }
+#else
+        for (int y = y0; y <= y1; y++)
+        {
+            uint32_t *row = m_pixels.data() + (size_t)y * m_width;
+            float py = (float)y + 0.5f;
+            for (int x = x0; x <= x1; x++)
+            {
+                float px = (float)x + 0.5f;
+                float w[3];
+                bool inside = true;
+                for (int k = 0; k < 3 && inside; k++)
+                {
+                    // Summed in the same order as the SSE2 path, so coverage on edges matches
+                    float e = tri.edgeA[k] * px + (tri.edgeB[k] * py + tri.edgeC[k]);
+                    inside = e > 0.0f || (e == 0.0f && tri.topLeft[k]);
+                    w[k] = e * tri.invArea;
+                }
+                if (!inside)
+                    continue;
+
+                Color4 src;
+                for (int c = 0; c < 4; c++)
+                    src.c[c] = tri.color[0][c] * w[0] + tri.color[1][c] * w[1] + tri.color[2][c] * w[2];
+                if (tri.texture != nullptr)
+                {
+                    float u = tri.u[0] * w[0] + tri.u[1] * w[1] + tri.u[2] * w[2];
+                    float v = tri.v[0] * w[0] + tri.v[1] * w[1] + tri.v[2] * w[2];
+                    Color4 texel = Sample(*tri.texture, u, v);
+                    for (int c = 0; c < 4; c++)
+                        src.c[c] *= texel.c[c];
+                }
+
+                float alpha = src.c[3];
+                if (alpha <= 0.0f)
+                    continue;
+                Color4 dst = Unpack(row[x]);
+                Color4 out;
+                for (int c = 0; c < 3; c++)
+                    out.c[c] = src.c[c] * alpha + dst.c[c] * (1.0f - alpha);
+                out.c[3] = alpha + dst.c[3] * (1.0f - alpha);
+                row[x] = Pack(out);
+            }
+        }
+#endif
+    }
+
+    bool SoftwareRenderer::SaveSnapshot(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+            return false;
+
+        file << "P6\n"
+             << m_width << " " << m_height << "\n255\n";
+        std::vector<unsigned char> rgb((size_t)m_width * 3);
+        for (int y = 0; y < m_height; y++)
+        {
+            const uint32_t *row = m_pixels.data() + (size_t)y * m_width;
+            for (int x = 0; x < m_width; x++)
+            {
+                rgb[x * 3 + 0] = (unsigned char)(row[x] & 0xFF);
+                rgb[x * 3 + 1] = (unsigned char)((row[x] >> 8) & 0xFF);
+                rgb[x * 3 + 2] = (unsigned char)((row[x] >> 16) & 0xFF);
+            }
+            file.write(reinterpret_cast<const char *>(rgb.data()), (std::streamsize)rgb.size());
+        }
+        return (bool)file;
+    }
+
+    size_t SoftwareRenderer::GetMemoryBytes() const
+    {
+        size_t bytes = m_pixels.capacity() * sizeof(uint32_t) + m_triangles.capacity() * sizeof(TriangleSetup);
+        for (const std::unique_ptr<Texture> &texture : m_textures)
+            bytes += sizeof(Texture) + texture->pixels.capacity() * sizeof(uint32_t);
+        for (const std::vector<uint32_t> &bin : m_bins)
+            bytes += sizeof(bin) + bin.capacity() * sizeof(uint32_t);
+        return bytes;
+    }
+
+    size_t SoftwareRenderer::TrimMemory()
+    {
+        size_t before = GetMemoryBytes();
+        std::vector<TriangleSetup>().swap(m_triangles);
+        std::vector<std::vector<uint32_t>>().swap(m_bins);
+        return before - GetMemoryBytes();
+    }
+}
\ No newline at end of file
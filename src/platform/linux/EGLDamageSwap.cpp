@@ -0,0 +1,98 @@
+#include "platform/EGLDamageSwap.h"
+#include <SDL3/SDL_egl.h>
+#include <cstring>
+#include <iostream>
+
+#ifndef EGL_BUFFER_AGE_EXT
+#define EGL_BUFFER_AGE_EXT 0x313D
+#endif
+
+namespace Platform
+{
+    namespace
+    {
+        // Resolved through SDL so we do not link libEGL directly
+        typedef const char *(*QueryStringProc)(EGLDisplay display, EGLint name);
+        typedef EGLBoolean (*QuerySurfaceProc)(EGLDisplay display, EGLSurface surface, EGLint attribute, EGLint *value);
+        typedef EGLBoolean (*SwapBuffersWithDamageProc)(EGLDisplay display, EGLSurface surface, const EGLint *rects, EGLint count);
+
+        QuerySurfaceProc s_eglQuerySurface = nullptr;
+        SwapBuffersWithDamageProc s_eglSwapBuffersWithDamage = nullptr;
+
+        bool HasExtension(const char *extensions, const char *name)
+        {
+            size_t length = strlen(name);
+            for (const char *p = extensions; p && (p = strstr(p, name)) != nullptr; p += length)
+            {
+                if ((p == extensions || p[-1] == ' ') && (p[length] == ' ' || p[length] == '\0'))
+                    return true;
+            }
+            return false;
+        }
+    }
+
+    EGLDamageSwap::EGLDamageSwap() : m_window(nullptr), m_display(nullptr), m_surface(nullptr), m_bufferAgeSupported(false), m_swapWithDamageSupported(false) {}
+
+    bool EGLDamageSwap::Initialize(SDL_Window *window)
+    {
+        m_window = window;
+        m_display = SDL_EGL_GetCurrentDisplay();
+        m_surface = SDL_EGL_GetWindowSurface(window);
+        if (m_display == nullptr || m_surface == nullptr)
+        {
+            return false;
+        }
+
+        QueryStringProc queryString = (QueryStringProc)SDL_EGL_GetProcAddress("eglQueryString");
+        s_eglQuerySurface = (QuerySurfaceProc)SDL_EGL_GetProcAddress("eglQuerySurface");
+        if (queryString == nullptr || s_eglQuerySurface == nullptr)
+        {
+            return false;
+        }
+
+        const char *extensions = queryString((EGLDisplay)m_display, EGL_EXTENSIONS);
+        m_bufferAgeSupported = HasExtension(extensions, "EGL_EXT_buffer_age");
+
+        // SDL's Wayland backend paces frames inside SDL_GL_SwapWindow, so it must keep owning the swap there
+        const char *driver = SDL_GetCurrentVideoDriver();
+        bool sdlOwnsSwap = driver != nullptr && strcmp(driver, "wayland") == 0;
+        if (!sdlOwnsSwap && HasExtension(extensions, "EGL_KHR_swap_buffers_with_damage"))
+            s_eglSwapBuffersWithDamage = (SwapBuffersWithDamageProc)SDL_EGL_GetProcAddress("eglSwapBuffersWithDamageKHR");
+        else if (!sdlOwnsSwap && HasExtension(extensions, "EGL_EXT_swap_buffers_with_damage"))
+            s_eglSwapBuffersWithDamage = (SwapBuffersWithDamageProc)SDL_EGL_GetProcAddress("eglSwapBuffersWithDamageEXT");
+        m_swapWithDamageSupported = s_eglSwapBuffersWithDamage != nullptr;
+
+        std::cout << "Partial redraw: buffer age " << (m_bufferAgeSupported ? "yes" : "no")
+                  << ", swap with damage " << (m_swapWithDamageSupported ? "yes" : "no") << std::endl;
+        return m_bufferAgeSupported;
+    }
+
+    int EGLDamageSwap::QueryBufferAge() const
+    {
+        if (!m_bufferAgeSupported)
+            return 0;
+
+        EGLint age = 0;
+        if (!s_eglQuerySurface((EGLDisplay)m_display, (EGLSurface)m_surface, EGL_BUFFER_AGE_EXT, &age))
+            return 0;
+        return age;
+    }
+
+    void EGLDamageSwap::Swap(const FramebufferRect *damage)
+    {
+        if (damage == nullptr || !m_swapWithDamageSupported)
+        {
+            SDL_GL_SwapWindow(m_window);
+            return;
+        }
+
+        // A zero rect count means "everything changed", so an empty damage is sent as a single pixel
+        EGLint rect[4] = {damage->x, damage->y, damage->width, damage->height};
+        if (rect[2] <= 0 || rect[3] <= 0)
+        {
+            rect[2] = 1;
+            rect[3] = 1;
+        }
+        s_eglSwapBuffersWithDamage((EGLDisplay)m_display, (EGLSurface)m_surface, rect, 1);
+    }
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+#include "platform/GLTimerQuery.h"
+#include <SDL3/SDL_opengl.h>
+#include <SDL3/SDL_video.h>
+
+namespace Platform
+{
+    namespace
+    {
+        // Timer queries are GL 3.3 / ARB_timer_query; the context is created as GL 3.0,
+        // so the entry points are resolved at runtime
+        PFNGLGENQUERIESPROC s_glGenQueries = nullptr;
+        PFNGLDELETEQUERIESPROC s_glDeleteQueries = nullptr;
+        PFNGLBEGINQUERYPROC s_glBeginQuery = nullptr;
+        PFNGLENDQUERYPROC s_glEndQuery = nullptr;
+        PFNGLGETQUERYOBJECTIVPROC s_glGetQueryObjectiv = nullptr;
+        PFNGLGETQUERYOBJECTUI64VPROC s_glGetQueryObjectui64v = nullptr;
+    }
+
+    GLTimerQuery::GLTimerQuery() : m_queries{}, m_pending{}, m_writeIndex(0), m_active(false), m_supported(false) {}
+
+    GLTimerQuery::~GLTimerQuery() { Shutdown(); }
+
+    bool GLTimerQuery::Initialize()
+    {
+        GLint major = 0;
+        GLint minor = 0;
+        glGetIntegerv(GL_MAJOR_VERSION, &major);
+        glGetIntegerv(GL_MINOR_VERSION, &minor);
+        bool coreTimerQuery = major > 3 || (major == 3 && minor >= 3);
+        if (!coreTimerQuery && !SDL_GL_ExtensionSupported("GL_ARB_timer_query"))
+        {
+            return false;
+        }
+
+        s_glGenQueries = (PFNGLGENQUERIESPROC)SDL_GL_GetProcAddress("glGenQueries");
+        s_glDeleteQueries = (PFNGLDELETEQUERIESPROC)SDL_GL_GetProcAddress("glDeleteQueries");
+        s_glBeginQuery = (PFNGLBEGINQUERYPROC)SDL_GL_GetProcAddress("glBeginQuery");
+        s_glEndQuery = (PFNGLENDQUERYPROC)SDL_GL_GetProcAddress("glEndQuery");
+        s_glGetQueryObjectiv = (PFNGLGETQUERYOBJECTIVPROC)SDL_GL_GetProcAddress("glGetQueryObjectiv");
+        s_glGetQueryObjectui64v = (PFNGLGETQUERYOBJECTUI64VPROC)SDL_GL_GetProcAddress("glGetQueryObjectui64v");
+        if (!s_glGenQueries || !s_glDeleteQueries || !s_glBeginQuery || !s_glEndQuery || !s_glGetQueryObjectiv || !s_glGetQueryObjectui64v)
+        {
+            return false;
+        }
+
+        s_glGenQueries(QUERY_COUNT, m_queries);
+        m_supported = true;
+        return true;
+    }
+
+    void GLTimerQuery::Shutdown()
+    {
+        if (!m_supported)
+            return;
+
+        if (m_active)
+            s_glEndQuery(GL_TIME_ELAPSED);
+        s_glDeleteQueries(QUERY_COUNT, m_queries);
+        for (int i = 0; i < QUERY_COUNT; i++)
+        {
+            m_queries[i] = 0;
+            m_pending[i] = false;
+        }
+        m_active = false;
+        m_supported = false;
+    }
+
+    void GLTimerQuery::BeginFrame()
+    {
+        // All queries still in flight: skip this frame rather than block on a result
+        if (!m_supported || m_pending[m_writeIndex])
+            return;
+
+        s_glBeginQuery(GL_TIME_ELAPSED, m_queries[m_writeIndex]);
+        m_active = true;
+    }
+
+    void GLTimerQuery::EndFrame()
+    {
+        if (!m_active)
+            return;
+
+        s_glEndQuery(GL_TIME_ELAPSED);
+        m_pending[m_writeIndex] = true;
+        m_writeIndex = (m_writeIndex + 1) % QUERY_COUNT;
+        m_active = false;
+    }
+
+    bool GLTimerQuery::ReadLatest(double &milliseconds)
+    {
+        if (!m_supported)
+            return false;
+
+        // Walk from the oldest outstanding query; results complete in submission order
+        bool found = false;
+        for (int i = 0; i < QUERY_COUNT; i++)
+        {
+            int index = (m_writeIndex + i) % QUERY_COUNT;
+            if (!m_pending[index])
+                continue;
+
+            GLint available = 0;
+            s_glGetQueryObjectiv(m_queries[index], GL_QUERY_RESULT_AVAILABLE, &available);
+            if (!available)
+                break;
+
+            GLuint64 elapsed = 0;
+            s_glGetQueryObjectui64v(m_queries[index], GL_QUERY_RESULT, &elapsed);
+            m_pending[index] = false;
+            milliseconds = elapsed / 1.0e6;
+            found = true;
+        }
+        return found;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,292 @@
+#include "platform/InputRecorder.h"
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+namespace Platform
+{
+    namespace
+    {
+        constexpr char LOG_MAGIC[4] = {'S', 'N', 'P', 'I'};
+        constexpr uint32_t LOG_VERSION = 1;
+        constexpr uint32_t END_OF_LOG = 0;
+
+        // Size of the full event struct for types stored as raw bytes, 0 for unsupported types
+        size_t EventStructSize(uint32_t type)
+        {
+            switch (type)
+            {
+            case SDL_EVENT_KEY_DOWN:
+            case SDL_EVENT_KEY_UP:
+                return sizeof(SDL_KeyboardEvent);
+            case SDL_EVENT_MOUSE_MOTION:
+                return sizeof(SDL_MouseMotionEvent);
+            case SDL_EVENT_MOUSE_BUTTON_DOWN:
+            case SDL_EVENT_MOUSE_BUTTON_UP:
+                return sizeof(SDL_MouseButtonEvent);
+            case SDL_EVENT_MOUSE_WHEEL:
+                return sizeof(SDL_MouseWheelEvent);
+            default:
+                if (type >= SDL_EVENT_WINDOW_FIRST && type <= SDL_EVENT_WINDOW_LAST)
+                    return sizeof(SDL_WindowEvent);
+                return 0;
+            }
+        }
+    }
+
+    InputRecorder::InputRecorder() : m_previousFrame(0), m_previousTimestamp(0), m_lastFrame(0), m_eventCount(0) {}
+
+    InputRecorder::~InputRecorder() { Close(); }
+
+    bool InputRecorder::Open(const std::string &path)
+    {
+        m_file.open(path, std::ios::binary | std::ios::trunc);
+        if (!m_file)
+        {
+            std::cerr << "Failed to open input log for writing: " << path << std::endl;
+            return false;
+        }
+
+        uint32_t header[2] = {LOG_VERSION, (uint32_t)SDL_VERSION};
+        m_file.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+        m_file.write(reinterpret_cast<const char *>(header), sizeof(header));
+        m_previousFrame = 0;
+        m_previousTimestamp = 0;
+        m_lastFrame = 0;
+        m_eventCount = 0;
+        return true;
+    }
+
+    void InputRecorder::Close()
+    {
+        if (!m_file.is_open())
+            return;
+
+        // Terminator: frame delta up to the frame count, zero timestamp delta, type 0
+        WriteVarint(m_lastFrame + 1 - m_previousFrame);
+        WriteVarint(0);
+        WriteVarint(END_OF_LOG);
+        m_file.close();
+        std::cout << "Recorded " << m_eventCount << " input events over " << m_lastFrame + 1 << " frames" << std::endl;
+    }
+
+    void InputRecorder::WriteVarint(uint64_t value)
+    {
+        char bytes[10];
+        int count = 0;
+        do
+        {
+            uint8_t byte = value & 0x7F;
+            value >>= 7;
+            bytes[count++] = (char)(value ? byte | 0x80 : byte);
+        } while (value);
+        m_file.write(bytes, count);
+    }
+
+    void InputRecorder::Record(const SDL_Event &event, uint64_t frame)
+    {
+        if (!m_file.is_open())
+            return;
+
+        size_t structSize = EventStructSize(event.type);
+        bool isText = event.type == SDL_EVENT_TEXT_INPUT || event.type == SDL_EVENT_TEXT_EDITING;
+        if (structSize == 0 && !isText)
+            return;
+
+        uint64_t timestamp = event.common.timestamp;
+        WriteVarint(frame - m_previousFrame);
+        WriteVarint(timestamp >= m_previousTimestamp ? timestamp - m_previousTimestamp : 0);
+        WriteVarint(event.type);
+        m_previousFrame = frame;
+        m_previousTimestamp = timestamp;
+
+        if (isText)
+        {
+            const char *text = event.type == SDL_EVENT_TEXT_INPUT ? event.text.text : event.edit.text;
+            size_t length = text ? strlen(text) : 0;
+            WriteVarint(length);
+            m_file.write(text, (std::streamsize)length);
+            if (event.type == SDL_EVENT_TEXT_EDITING)
+            {
+                WriteVarint((uint32_t)event.edit.start);
+                WriteVarint((uint32_t)event.edit.length);
+            }
+        }
+        else
+        {
+            // Type-specific part only; the common header is already encoded above
+            size_t payload = structSize - sizeof(SDL_CommonEvent);
+            WriteVarint(payload);
+            m_file.write(reinterpret_cast<const char *>(&event) + sizeof(SDL_CommonEvent), (std::streamsize)payload);
+        }
+        m_eventCount++;
+    }
+
+    InputReplayer::InputReplayer()
+        : m_cursor(0), m_recordFrame(0), m_recordTimestamp(0), m_totalFrames(UINT64_MAX), m_mouseX(0.0f), m_mouseY(0.0f), m_hasMouse(false), m_active(false) {}
+
+    bool InputReplayer::Open(const std::string &path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            std::cerr << "Failed to open input log: " << path << std::endl;
+            return false;
+        }
+        m_data.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        uint32_t header[2] = {};
+        const size_t headerSize = sizeof(LOG_MAGIC) + sizeof(header);
+        if (m_data.size() < headerSize || memcmp(m_data.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0)
+        {
+            std::cerr << "Not an input log: " << path << std::endl;
+            return false;
+        }
+        memcpy(header, m_data.data() + sizeof(LOG_MAGIC), sizeof(header));
+        if (header[0] != LOG_VERSION || header[1] != (uint32_t)SDL_VERSION)
+        {
+            // Raw event layouts are only stable within one SDL version
+            std::cerr << "Input log was recorded with a different format or SDL version: " << path << std::endl;
+            return false;
+        }
+
+        m_cursor = headerSize;
+        m_recordFrame = 0;
+        m_recordTimestamp = 0;
+        m_totalFrames = UINT64_MAX;
+        m_hasMouse = false;
+        m_active = true;
+        return true;
+    }
+
+    bool InputReplayer::IsFinished(uint64_t frame) const
+    {
+        return m_active && m_cursor >= m_data.size() && (m_totalFrames == UINT64_MAX || frame >= m_totalFrames);
+    }
+
+    bool InputReplayer::ReadVarint(uint64_t &value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64 && m_cursor < m_data.size(); shift += 7)
+        {
+            uint8_t byte = m_data[m_cursor++];
+            value |= (uint64_t)(byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                return true;
+        }
+        return false;
+    }
+
+    bool InputReplayer::Next(uint64_t frame, SDL_WindowID windowID, SDL_Event &event)
+    {
+        if (!m_active || m_cursor >= m_data.size())
+            return false;
+
+        // Leave the record in place if it belongs to a later frame
+        size_t start = m_cursor;
+        uint64_t frameDelta = 0;
+        if (!ReadVarint(frameDelta) || m_recordFrame + frameDelta > frame)
+        {
+            m_cursor = start;
+            return false;
+        }
+
+        uint64_t timestampDelta = 0;
+        uint64_t type = 0;
+        if (!ReadVarint(timestampDelta) || !ReadVarint(type))
+        {
+            m_cursor = m_data.size();
+            return false;
+        }
+        m_recordFrame += frameDelta;
+        m_recordTimestamp += timestampDelta;
+
+        if (type == END_OF_LOG)
+        {
+            m_totalFrames = m_recordFrame;
+            m_cursor = m_data.size();
+            return false;
+        }
+
+        SDL_zero(event);
+        event.type = (uint32_t)type;
+        event.common.timestamp = m_recordTimestamp;
+
+        uint64_t length = 0;
+        if (!ReadVarint(length) || length > m_data.size() - m_cursor)
+        {
+            m_cursor = m_data.size();
+            return false;
+        }
+
+        if (event.type == SDL_EVENT_TEXT_INPUT || event.type == SDL_EVENT_TEXT_EDITING)
+        {
+            m_text.assign(reinterpret_cast<const char *>(m_data.data() + m_cursor), (size_t)length);
+            m_cursor += (size_t)length;
+            if (event.type == SDL_EVENT_TEXT_INPUT)
+            {
+                event.text.windowID = windowID;
+                event.text.text = m_text.c_str();
+            }
+            else
+            {
+                uint64_t editStart = 0;
+                uint64_t editLength = 0;
+                ReadVarint(editStart);
+                ReadVarint(editLength);
+                event.edit.windowID = windowID;
+                event.edit.text = m_text.c_str();
+                event.edit.start = (Sint32)editStart;
+                event.edit.length = (Sint32)editLength;
+            }
+            return true;
+        }
+
+        size_t structSize = EventStructSize(event.type);
+        if (structSize == 0 || length != structSize - sizeof(SDL_CommonEvent))
+        {
+            // Unknown or mismatched record: skip it
+            m_cursor += (size_t)length;
+            return Next(frame, windowID, event);
+        }
+        memcpy(reinterpret_cast<uint8_t *>(&event) + sizeof(SDL_CommonEvent), m_data.data() + m_cursor, (size_t)length);
+        m_cursor += (size_t)length;
+
+        switch (event.type)
+        {
+        case SDL_EVENT_KEY_DOWN:
+        case SDL_EVENT_KEY_UP:
+            event.key.windowID = windowID;
+            break;
+        case SDL_EVENT_MOUSE_MOTION:
+            event.motion.windowID = windowID;
+            m_mouseX = event.motion.x;
+            m_mouseY = event.motion.y;
+            m_hasMouse = true;
+            break;
+        case SDL_EVENT_MOUSE_BUTTON_DOWN:
+        case SDL_EVENT_MOUSE_BUTTON_UP:
+            event.button.windowID = windowID;
+            m_mouseX = event.button.x;
+            m_mouseY = event.button.y;
+            m_hasMouse = true;
+            break;
+        case SDL_EVENT_MOUSE_WHEEL:
+            event.wheel.windowID = windowID;
+            break;
+        default:
+            event.window.windowID = windowID;
+            break;
+        }
+        return true;
+    }
+
+    bool InputReplayer::GetMousePosition(float &x, float &y) const
+    {
+        if (!m_hasMouse)
+            return false;
+        x = m_mouseX;
+        y = m_mouseY;
+        return true;
+    }
+}
\ No newline at end of file
@@ -4,11 +4,14 @@
 #include <SDL3/SDL_opengl.h>
 #include <SDL3/SDL_render.h>
 #include <SDL3/SDL_video.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 
 namespace Platform
 {
-    LinuxPlatform::LinuxPlatform() : m_window(nullptr), m_glContext(nullptr), m_imguiContext(nullptr), m_io(nullptr), m_shouldClose(false) {}
+    LinuxPlatform::LinuxPlatform() : m_window(nullptr), m_glContext(nullptr), m_imguiContext(nullptr), m_io(nullptr), m_shouldClose(false), m_showRenderStats(false), m_frameIndex(0), m_replayDeltaTime(1.0f / 60.0f) {}
 
     LinuxPlatform::~LinuxPlatform() { Shutdown(); }
 
@@ -35,12 +38,29 @@ namespace Platform
         SDL_GL_SetAttribute(SDL_GL_DEPTH_SIZE, 24);
         SDL_GL_SetAttribute(SDL_GL_STENCIL_SIZE, 8);
         float main_scale = SDL_GetDisplayContentScale(SDL_GetPrimaryDisplay());
-        SDL_WindowFlags window_flags = SDL_WINDOW_OPENGL | SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIDDEN | SDL_WINDOW_HIGH_PIXEL_DENSITY;
-        m_window = SDL_CreateWindow(config.title.c_str(), (int)(config.width * main_scale), (int)(config.height * main_scale), window_flags);
+        SDL_WindowFlags window_flags = SDL_WINDOW_RESIZABLE | SDL_WINDOW_HIDDEN | SDL_WINDOW_HIGH_PIXEL_DENSITY;
+        if (SDL_getenv("SNAP_TOOLS_SOFTWARE_RENDERER") != nullptr)
+        {
+            m_softwareRenderer = std::make_unique<SoftwareRenderer>();
+        }
+        else
+        {
+            m_window = SDL_CreateWindow(config.title.c_str(), (int)(config.width * main_scale), (int)(config.height * main_scale), window_flags | SDL_WINDOW_OPENGL);
+            if (m_window == nullptr)
+            {
+                std::cout << "Error: SDL_CreateWindow() with OpenGL: " << SDL_GetError() << ", falling back to the software renderer" << std::endl;
+                m_softwareRenderer = std::make_unique<SoftwareRenderer>();
+            }
+        }
+
         if (m_window == nullptr)
         {
-            std::cout << "Error: SDL_CreateWindow(): " << SDL_GetError() << std::endl;
-            return false;
+            m_window = SDL_CreateWindow(config.title.c_str(), (int)(config.width * main_scale), (int)(config.height * main_scale), window_flags);
+            if (m_window == nullptr)
+            {
+                std::cout << "Error: SDL_CreateWindow(): " << SDL_GetError() << std::endl;
+                return false;
+            }
         }
 
         if (!InitializeRenderer())
@@ -58,15 +78,31 @@ namespace Platform
 
     bool LinuxPlatform::InitializeRenderer()
     {
-        m_glContext = SDL_GL_CreateContext(m_window);
-        if (m_glContext == nullptr)
+        if (!m_softwareRenderer)
         {
-            std::cout << "Error: SDL_GL_CreateContext(): " << SDL_GetError() << std::endl;
-            return false;
+            m_glContext = SDL_GL_CreateContext(m_window);
+            if (m_glContext == nullptr)
+            {
+                std::cout << "Error: SDL_GL_CreateContext(): " << SDL_GetError() << ", falling back to the software renderer" << std::endl;
+                m_softwareRenderer = std::make_unique<SoftwareRenderer>();
+            }
         }
 
-        SDL_GL_MakeCurrent(m_window, m_glContext);
-        SDL_GL_SetSwapInterval(1); // Enable vsync
+        if (m_glContext)
+        {
+            SDL_GL_MakeCurrent(m_window, m_glContext);
+            SDL_GL_SetSwapInterval(1); // Enable vsync
+
+            if (!m_gpuTimer.Initialize())
+            {
+                std::cout << "GL timer queries unavailable, GPU frame time will not be reported" << std::endl;
+            }
+
+            if (!m_damageSwap.Initialize(m_window))
+            {
+                std::cout << "EGL buffer age unavailable, redrawing the full window every frame" << std::endl;
+            }
+        }
         SDL_SetWindowPosition(m_window, SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED);
         SDL_ShowWindow(m_window);
 
@@ -87,21 +123,63 @@ namespace Platform
 
         ImGui::StyleColorsDark();
 
-        m_style = &ImGui::GetStyle();
-        m_style->ScaleAllSizes(main_scale);
-        m_style->FontScaleDpi = main_scale;
+        m_dpiScaler.Initialize(main_scale);
 
-        ImGui_ImplSDL3_InitForOpenGL(m_window, m_glContext);
-        ImGui_ImplOpenGL3_Init(m_glslVersion);
+        if (m_softwareRenderer)
+        {
+            ImGui_ImplSDL3_InitForOther(m_window);
+            m_io->BackendRendererName = "software";
+            m_io->BackendFlags |= ImGuiBackendFlags_RendererHasTextures;
+            m_io->BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
+        }
+        else
+        {
+            ImGui_ImplSDL3_InitForOpenGL(m_window, m_glContext);
+            ImGui_ImplOpenGL3_Init(m_glslVersion);
+        }
+        RegisterMemorySources();
 
         return true;
     }
 
+    void LinuxPlatform::RegisterMemorySources()
+    {
+        if (m_softwareRenderer)
+        {
+            // The binning scratch is rebuilt on the next frame, so it is the cheapest thing to give back
+            m_softwareMemory.Register("Software renderer", MemoryKind::Heap, [this]()
+                                      { return m_softwareRenderer->GetMemoryBytes(); },
+                                      [this](size_t)
+                                      { return m_softwareRenderer->TrimMemory(); });
+            return;
+        }
+
+        m_textureMemory.Register("GL textures", MemoryKind::Gpu, [this]()
+                                 { return m_renderStats.GetTextureBytes(); });
+        m_bufferMemory.Register("GL buffers", MemoryKind::Gpu, [this]()
+                                { return m_renderStats.GetBufferBytes(); });
+    }
+
     void LinuxPlatform::Shutdown()
     {
+        m_textureMemory.Reset();
+        m_bufferMemory.Reset();
+        m_softwareMemory.Reset();
+        m_screenGrabber.Shutdown();
+        m_desktopCapture.Shutdown();
+        m_recorder.Close();
         if (m_imguiContext)
         {
-            ImGui_ImplOpenGL3_Shutdown();
+            if (m_softwareRenderer)
+            {
+                m_softwareRenderer->DestroyAllTextures();
+                m_io->BackendRendererName = nullptr;
+                m_io->BackendFlags &= ~(ImGuiBackendFlags_RendererHasTextures | ImGuiBackendFlags_RendererHasVtxOffset);
+            }
+            else
+            {
+                ImGui_ImplOpenGL3_Shutdown();
+            }
             ImGui_ImplSDL3_Shutdown();
             ImGui::DestroyContext();
             m_imguiContext = nullptr;
@@ -110,6 +188,7 @@ namespace Platform
 
         if (m_glContext)
         {
+            m_gpuTimer.Shutdown();
             SDL_GL_DestroyContext(m_glContext);
             m_glContext = nullptr;
         }
@@ -130,34 +209,176 @@ namespace Platform
         SDL_Event event;
         while (SDL_PollEvent(&event))
         {
-            ImGui_ImplSDL3_ProcessEvent(&event);
+            // While replaying, live input is dropped so only the log drives the UI
+            if (!m_replayer.IsActive())
+            {
+                m_recorder.Record(event, m_frameIndex);
+                ImGui_ImplSDL3_ProcessEvent(&event);
+            }
             if (event.type == SDL_EVENT_QUIT)
                 m_shouldClose = true;
             if (event.type == SDL_EVENT_WINDOW_CLOSE_REQUESTED && event.window.windowID == SDL_GetWindowID(m_window))
                 m_shouldClose = true;
+            if (event.type == SDL_EVENT_KEY_DOWN && event.key.key == SDLK_F3 && !event.key.repeat)
+                m_showRenderStats = !m_showRenderStats;
+            if (event.type == SDL_EVENT_WINDOW_DISPLAY_SCALE_CHANGED && event.window.windowID == SDL_GetWindowID(m_window))
+                m_dpiScaler.RequestScale(SDL_GetWindowDisplayScale(m_window));
+        }
+
+        if (m_replayer.IsActive())
+        {
+            SDL_WindowID windowID = SDL_GetWindowID(m_window);
+            while (m_replayer.Next(m_frameIndex, windowID, event))
+            {
+                // The backend reads the window size directly, so recorded resizes are applied for real
+                if (event.type == SDL_EVENT_WINDOW_RESIZED)
+                    SDL_SetWindowSize(m_window, event.window.data1, event.window.data2);
+                ImGui_ImplSDL3_ProcessEvent(&event);
+            }
+            if (m_replayer.IsFinished(m_frameIndex))
+                m_shouldClose = true;
         }
+
+        m_recorder.EndFrame(m_frameIndex);
+        m_frameIndex++;
     }
 
     void LinuxPlatform::NewFrame()
     {
-        ImGui_ImplOpenGL3_NewFrame();
+        m_renderStats.BeginCpuFrame();
+        if (!m_softwareRenderer)
+            ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplSDL3_NewFrame();
+
+        if (m_replayer.IsActive())
+        {
+            // Fixed timestep and the recorded cursor, so a replay depends on neither the wall clock nor the live mouse
+            m_io->DeltaTime = m_replayDeltaTime;
+            float mouseX = 0.0f;
+            float mouseY = 0.0f;
+            if (m_replayer.GetMousePosition(mouseX, mouseY))
+                m_io->AddMousePosEvent(mouseX, mouseY);
+        }
+
+        m_dpiScaler.BeginFrame();
         ImGui::NewFrame();
+        m_dpiScaler.Prewarm();
     }
 
     void LinuxPlatform::SetClearColor(ImVec4 &color)
     {
+        if (color.x != m_clearColor.x || color.y != m_clearColor.y || color.z != m_clearColor.z || color.w != m_clearColor.w)
+            m_damageTracker.Invalidate();
         m_clearColor = color;
     }
 
     void LinuxPlatform::RenderFrame()
     {
+        // The overlay shows the previous frame's numbers since it has to be submitted before ImGui::Render()
+        if (m_showRenderStats)
+            m_renderStats.DrawOverlay(&m_showRenderStats);
+
         ImGui::Render();
+        ImDrawData *drawData = ImGui::GetDrawData();
+
+        double gpuTimeMs = 0.0;
+        if (m_gpuTimer.ReadLatest(gpuTimeMs))
+            m_renderStats.SetGpuTime(gpuTimeMs);
+        m_renderStats.Collect(drawData);
+
+        // Redraw only what changed since the back buffer was last presented, if its age is known
+        // The window surface keeps its contents between presents, so in software mode the age is always 1
+        m_damageTracker.Update(drawData);
+        ImVec4 damage;
+        bool partial = m_damageTracker.GetDamage(m_softwareRenderer ? 1 : m_damageSwap.QueryBufferAge(), damage);
+        if (m_softwareRenderer)
+        {
+            PresentSoftwareFrame(drawData, partial ? &damage : nullptr);
+            m_renderStats.EndCpuFrame();
+            return;
+        }
+
+        FramebufferRect damageRect;
+        if (partial)
+        {
+            damageRect = DamageTracker::ToFramebufferRect(drawData, damage);
+            DamageTracker::ClipDrawData(drawData, damage);
+        }
+
+        m_gpuTimer.BeginFrame();
         glViewport(0, 0, (int)m_io->DisplaySize.x, (int)m_io->DisplaySize.y);
         glClearColor(m_clearColor.x * m_clearColor.w, m_clearColor.y * m_clearColor.w, m_clearColor.z * m_clearColor.w, m_clearColor.w);
-        glClear(GL_COLOR_BUFFER_BIT);
-        ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
-        SDL_GL_SwapWindow(m_window);
+        if (partial)
+        {
+            glEnable(GL_SCISSOR_TEST);
+            glScissor(damageRect.x, damageRect.y, damageRect.width, damageRect.height);
+            glClear(GL_COLOR_BUFFER_BIT);
+            glDisable(GL_SCISSOR_TEST);
+        }
+        else
+        {
+            glClear(GL_COLOR_BUFFER_BIT);
+        }
+        UploadTextures(drawData);
+        ImGui_ImplOpenGL3_RenderDrawData(drawData);
+        m_gpuTimer.EndFrame();
+        m_renderStats.EndCpuFrame();
+        m_damageSwap.Swap(partial ? &damageRect : nullptr);
+    }
+
+    void LinuxPlatform::UploadTextures(ImDrawData *drawData)
+    {
+        if (drawData->Textures == nullptr)
+            return;
+
+        // Done here rather than inside RenderDrawData so each upload can be timed; the backend
+        // then finds these textures up to date. glTex(Sub)Image2D copies the pixels before it
+        // returns, so this is the CPU side of the upload.
+        for (ImTextureData *tex : *drawData->Textures)
+        {
+            if (tex->Status != ImTextureStatus_WantCreate && tex->Status != ImTextureStatus_WantUpdates)
+                continue;
+            auto start = std::chrono::steady_clock::now();
+            ImGui_ImplOpenGL3_UpdateTexture(tex);
+            m_renderStats.SetTextureUploadTime(tex->UniqueID, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+
+    void LinuxPlatform::PresentSoftwareFrame(ImDrawData *drawData, const ImVec4 *damage)
+    {
+        int previousWidth = m_softwareRenderer->GetWidth();
+        int previousHeight = m_softwareRenderer->GetHeight();
+        m_softwareRenderer->UpdateTextures(drawData);
+        m_softwareRenderer->Render(drawData, m_clearColor, damage);
+
+        SDL_Surface *surface = SDL_GetWindowSurface(m_window);
+        if (surface == nullptr)
+            return;
+
+        // Copy only the damaged rows and columns, unless the surface was just recreated by a resize
+        int width = m_softwareRenderer->GetWidth();
+        int height = m_softwareRenderer->GetHeight();
+        SDL_Rect rect = {0, 0, std::min(width, surface->w), std::min(height, surface->h)};
+        if (damage != nullptr && width == previousWidth && height == previousHeight)
+        {
+            FramebufferRect damageRect = DamageTracker::ToFramebufferRect(drawData, *damage);
+            rect.x = damageRect.x;
+            rect.y = height - (damageRect.y + damageRect.height);
+            rect.w = std::min(damageRect.width, surface->w - rect.x);
+            rect.h = std::min(damageRect.height, surface->h - rect.y);
+        }
+        if (rect.w <= 0 || rect.h <= 0)
+            return;
+
+        if (SDL_MUSTLOCK(surface) && !SDL_LockSurface(surface))
+            return;
+        const uint32_t *src = m_softwareRenderer->GetPixels() + (size_t)rect.y * width + rect.x;
+        unsigned char *dst = (unsigned char *)surface->pixels + (size_t)rect.y * surface->pitch + (size_t)rect.x * SDL_BYTESPERPIXEL(surface->format);
+        SDL_ConvertPixels(rect.w, rect.h, SDL_PIXELFORMAT_RGBA32, src, m_softwareRenderer->GetPitch(), surface->format, dst, surface->pitch);
+        if (SDL_MUSTLOCK(surface))
+            SDL_UnlockSurface(surface);
+
+        SDL_UpdateWindowSurfaceRects(m_window, &rect, 1);
     }
 
     void LinuxPlatform::SetWindowTitle(const std::string &title)
@@ -178,4 +399,48 @@ namespace Platform
     void *LinuxPlatform::GetNativeWindow() { return m_window; }
 
     void *LinuxPlatform::GetNativeRenderer() { return nullptr; }
+
+    bool LinuxPlatform::StartInputRecording(const std::string &path)
+    {
+        if (m_replayer.IsActive())
+        {
+            std::cout << "Error: cannot record input while replaying" << std::endl;
+            return false;
+        }
+        m_frameIndex = 0;
+        return m_recorder.Open(path);
+    }
+
+    bool LinuxPlatform::StartInputReplay(const std::string &path, float fixedDeltaTime)
+    {
+        if (m_recorder.IsOpen())
+        {
+            std::cout << "Error: cannot replay input while recording" << std::endl;
+            return false;
+        }
+        m_frameIndex = 0;
+        m_replayDeltaTime = fixedDeltaTime;
+        return m_replayer.Open(path);
+    }
+
+    bool LinuxPlatform::GetGlobalMousePosition(int &x, int &y)
+    {
+        // Desktop coordinates under X11; Wayland only reports the cursor over our own window
+        float mouseX = 0.0f;
+        float mouseY = 0.0f;
+        SDL_GetGlobalMouseState(&mouseX, &mouseY);
+        x = (int)std::floor(mouseX);
+        y = (int)std::floor(mouseY);
+        return true;
+    }
+
+    bool LinuxPlatform::GrabScreenRegion(int x, int y, int width, int height, Imaging::Image &out)
+    {
+        return m_screenGrabber.Grab(x, y, width, height, out);
+    }
+
+    bool LinuxPlatform::CaptureDesktop(Imaging::Image &out, std::vector<DesktopOutput> &outputs)
+    {
+        return m_desktopCapture.Capture(out, outputs);
+    }
 }
\ No newline at end of file
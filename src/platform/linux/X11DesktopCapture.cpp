@@ -0,0 +1,113 @@
+#include "platform/X11DesktopCapture.h"
+#include <algorithm>
+#include <climits>
+
+namespace Platform
+{
+    namespace
+    {
+        void FillBlack(Imaging::Image &canvas, int x, int y, int width, int height)
+        {
+            for (int row = y; row < y + height; row++)
+                std::fill_n(canvas.Row(row) + x, width, 0xFF000000u);
+        }
+    }
+
+    X11DesktopCapture::X11DesktopCapture() : m_originX(0), m_originY(0), m_width(0), m_height(0), m_hasGaps(false), m_configured(false) {}
+
+    X11DesktopCapture::~X11DesktopCapture() { Shutdown(); }
+
+    void X11DesktopCapture::Shutdown()
+    {
+        m_pool.reset();
+        m_outputs.clear();
+        m_probe.Shutdown();
+        m_configured = false;
+    }
+
+    bool X11DesktopCapture::Configure()
+    {
+        std::vector<X11Output> sources;
+        if (!m_probe.QueryOutputs(sources))
+            return false;
+
+        int x0 = INT_MAX, y0 = INT_MAX, x1 = INT_MIN, y1 = INT_MIN;
+        int64_t coveredArea = 0;
+        for (const X11Output &source : sources)
+        {
+            x0 = std::min(x0, source.desktopX);
+            y0 = std::min(y0, source.desktopY);
+            x1 = std::max(x1, source.desktopX + source.width);
+            y1 = std::max(y1, source.desktopY + source.height);
+            coveredArea += (int64_t)source.width * source.height;
+        }
+        m_originX = x0;
+        m_originY = y0;
+        m_width = x1 - x0;
+        m_height = y1 - y0;
+        // Monitors of different sizes leave uncovered corners in the bounding box
+        m_hasGaps = coveredArea != (int64_t)m_width * m_height;
+
+        // Grabbers keep their connection and buffers as long as their X screen stays the same.
+        // They connect here rather than on the worker threads.
+        m_outputs.resize(sources.size());
+        for (size_t i = 0; i < sources.size(); i++)
+        {
+            Output &output = m_outputs[i];
+            if (!output.grabber || output.source.screen != sources[i].screen)
+            {
+                output.grabber = std::make_unique<X11ScreenGrabber>();
+                output.grabber->SetScreen(sources[i].screen);
+            }
+            output.source = sources[i];
+            if (!output.grabber->Initialize())
+                return false;
+        }
+
+        if (!m_pool || m_pool->GetThreadCount() != (int)m_outputs.size())
+            m_pool = std::make_unique<ThreadPool>((int)m_outputs.size());
+        m_configured = true;
+        return true;
+    }
+
+    bool X11DesktopCapture::Capture(Imaging::Image &canvas, std::vector<DesktopOutput> &outputs)
+    {
+        outputs.clear();
+        if (!m_configured && !Configure())
+            return false;
+
+        if (canvas.width != m_width || canvas.height != m_height)
+            canvas.Allocate(m_width, m_height);
+        if (m_hasGaps)
+            std::fill(canvas.pixels.begin(), canvas.pixels.end(), 0xFF000000u);
+
+        // Mirrored monitors were merged when enumerating, so the grabs write disjoint parts of the canvas
+        m_pool->ParallelFor((int)m_outputs.size(), [&](int index)
+                            {
+                                Output &output = m_outputs[index];
+                                const X11Output &source = output.source;
+                                output.captured = output.grabber->GrabInto(source.x, source.y, source.width, source.height, canvas,
+                                                                           source.desktopX - m_originX, source.desktopY - m_originY); });
+
+        bool anyCaptured = false;
+        for (const Output &output : m_outputs)
+        {
+            DesktopOutput placement;
+            placement.x = output.source.desktopX - m_originX;
+            placement.y = output.source.desktopY - m_originY;
+            placement.width = output.source.width;
+            placement.height = output.source.height;
+            outputs.push_back(placement);
+
+            if (output.captured)
+            {
+                anyCaptured = true;
+                continue;
+            }
+            // The layout probably changed; enumerate again next time
+            FillBlack(canvas, placement.x, placement.y, placement.width, placement.height);
+            m_configured = false;
+        }
+        return anyCaptured;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,470 @@
+#include "platform/X11ScreenGrabber.h"
+#include <X11/Xlib.h>
+#include <X11/Xutil.h>
+#include <X11/extensions/XShm.h>
+#include <algorithm>
+#include <bit>
+#include <dlfcn.h>
+#include <iostream>
+#include <mutex>
+#include <sys/shm.h>
+
+namespace Platform
+{
+    namespace
+    {
+        // Resolved at runtime so we do not link libX11 directly
+        typedef Display *(*OpenDisplayProc)(const char *name);
+        typedef int (*CloseDisplayProc)(Display *display);
+        typedef Status (*GetGeometryProc)(Display *display, Drawable drawable, Window *root, int *x, int *y, unsigned int *width,
+                                          unsigned int *height, unsigned int *border, unsigned int *depth);
+        typedef XImage *(*CreateImageProc)(Display *display, Visual *visual, unsigned int depth, int format, int offset, char *data,
+                                           unsigned int width, unsigned int height, int pad, int bytesPerLine);
+        typedef XImage *(*GetSubImageProc)(Display *display, Drawable drawable, int x, int y, unsigned int width, unsigned int height,
+                                           unsigned long planes, int format, XImage *dest, int destX, int destY);
+        typedef XErrorHandler (*SetErrorHandlerProc)(XErrorHandler handler);
+        typedef int (*SyncProc)(Display *display, Bool discard);
+        typedef int (*FreeProc)(void *data);
+
+        // MIT-SHM, from libXext
+        typedef Bool (*ShmQueryExtensionProc)(Display *display);
+        typedef XImage *(*ShmCreateImageProc)(Display *display, Visual *visual, unsigned int depth, int format, char *data,
+                                              XShmSegmentInfo *segment, unsigned int width, unsigned int height);
+        typedef Bool (*ShmAttachProc)(Display *display, XShmSegmentInfo *segment);
+        typedef Bool (*ShmDetachProc)(Display *display, XShmSegmentInfo *segment);
+        typedef Bool (*ShmGetImageProc)(Display *display, Drawable drawable, XImage *image, int x, int y, unsigned long planes);
+
+        // Xinerama; declared here as its headers are often not installed
+        struct XineramaScreenInfo
+        {
+            int screen_number;
+            short x_org;
+            short y_org;
+            short width;
+            short height;
+        };
+        typedef Bool (*XineramaIsActiveProc)(Display *display);
+        typedef XineramaScreenInfo *(*XineramaQueryScreensProc)(Display *display, int *count);
+
+        OpenDisplayProc s_XOpenDisplay = nullptr;
+        CloseDisplayProc s_XCloseDisplay = nullptr;
+        GetGeometryProc s_XGetGeometry = nullptr;
+        CreateImageProc s_XCreateImage = nullptr;
+        GetSubImageProc s_XGetSubImage = nullptr;
+        SyncProc s_XSync = nullptr;
+        FreeProc s_XFree = nullptr;
+
+        ShmQueryExtensionProc s_XShmQueryExtension = nullptr;
+        ShmCreateImageProc s_XShmCreateImage = nullptr;
+        ShmAttachProc s_XShmAttach = nullptr;
+        ShmDetachProc s_XShmDetach = nullptr;
+        ShmGetImageProc s_XShmGetImage = nullptr;
+
+        XineramaIsActiveProc s_XineramaIsActive = nullptr;
+        XineramaQueryScreensProc s_XineramaQueryScreens = nullptr;
+
+        std::mutex s_mutex;
+        void *s_library = nullptr;
+        bool s_loadFailed = false;
+        void *s_extLibrary = nullptr;
+        bool s_extLoadFailed = false;
+        void *s_xineramaLibrary = nullptr;
+        bool s_xineramaLoadFailed = false;
+
+        // Xlib's default error handler exits the process. Errors on our own connections are
+        // recorded for the thread that made the request; everything else goes to the
+        // previous handler (SDL's, when it uses X11 too).
+        std::vector<Display *> s_displays;
+        XErrorHandler s_previousHandler = nullptr;
+        thread_local bool t_errorRaised = false;
+
+        int OnXError(Display *display, XErrorEvent *event)
+        {
+            bool ours;
+            {
+                std::lock_guard<std::mutex> lock(s_mutex);
+                ours = std::find(s_displays.begin(), s_displays.end(), display) != s_displays.end();
+            }
+            if (ours)
+            {
+                t_errorRaised = true;
+                return 0;
+            }
+            return s_previousHandler != nullptr ? s_previousHandler(display, event) : 0;
+        }
+
+        template <typename T>
+        bool Resolve(void *library, T &proc, const char *name)
+        {
+            proc = reinterpret_cast<T>(dlsym(library, name));
+            return proc != nullptr;
+        }
+
+        // Called with s_mutex held
+        bool LoadX11()
+        {
+            if (s_library != nullptr || s_loadFailed)
+                return s_library != nullptr;
+
+            s_library = dlopen("libX11.so.6", RTLD_NOW | RTLD_LOCAL);
+            SetErrorHandlerProc setErrorHandler = nullptr;
+            if (s_library == nullptr || !Resolve(s_library, s_XOpenDisplay, "XOpenDisplay") || !Resolve(s_library, s_XCloseDisplay, "XCloseDisplay") ||
+                !Resolve(s_library, s_XGetGeometry, "XGetGeometry") || !Resolve(s_library, s_XCreateImage, "XCreateImage") ||
+                !Resolve(s_library, s_XGetSubImage, "XGetSubImage") || !Resolve(s_library, s_XSync, "XSync") ||
+                !Resolve(s_library, s_XFree, "XFree") || !Resolve(s_library, setErrorHandler, "XSetErrorHandler"))
+            {
+                if (s_library != nullptr)
+                    dlclose(s_library);
+                s_library = nullptr;
+                s_loadFailed = true;
+                return false;
+            }
+            s_previousHandler = setErrorHandler(OnXError);
+            return true;
+        }
+
+        // Optional extensions; called with s_mutex held, after LoadX11() succeeded
+        bool LoadXext()
+        {
+            if (s_extLibrary != nullptr || s_extLoadFailed)
+                return s_extLibrary != nullptr;
+
+            s_extLibrary = dlopen("libXext.so.6", RTLD_NOW | RTLD_LOCAL);
+            if (s_extLibrary == nullptr || !Resolve(s_extLibrary, s_XShmQueryExtension, "XShmQueryExtension") ||
+                !Resolve(s_extLibrary, s_XShmCreateImage, "XShmCreateImage") || !Resolve(s_extLibrary, s_XShmAttach, "XShmAttach") ||
+                !Resolve(s_extLibrary, s_XShmDetach, "XShmDetach") || !Resolve(s_extLibrary, s_XShmGetImage, "XShmGetImage"))
+            {
+                if (s_extLibrary != nullptr)
+                    dlclose(s_extLibrary);
+                s_extLibrary = nullptr;
+                s_extLoadFailed = true;
+                return false;
+            }
+            return true;
+        }
+
+        bool LoadXinerama()
+        {
+            if (s_xineramaLibrary != nullptr || s_xineramaLoadFailed)
+                return s_xineramaLibrary != nullptr;
+
+            s_xineramaLibrary = dlopen("libXinerama.so.1", RTLD_NOW | RTLD_LOCAL);
+            if (s_xineramaLibrary == nullptr || !Resolve(s_xineramaLibrary, s_XineramaIsActive, "XineramaIsActive") ||
+                !Resolve(s_xineramaLibrary, s_XineramaQueryScreens, "XineramaQueryScreens"))
+            {
+                if (s_xineramaLibrary != nullptr)
+                    dlclose(s_xineramaLibrary);
+                s_xineramaLibrary = nullptr;
+                s_xineramaLoadFailed = true;
+                return false;
+            }
+            return true;
+        }
+
+        uint32_t ExtractChannel(unsigned long pixel, unsigned long mask)
+        {
+            if (mask == 0)
+                return 0;
+            int shift = std::countr_zero(mask);
+            unsigned long maximum = mask >> shift;
+            return (uint32_t)(((pixel & mask) >> shift) * 255 / maximum);
+        }
+
+        void ConvertPixels(XImage *image, int width, int height, Imaging::Image &out, int outX, int outY)
+        {
+            // Every common visual is 32-bit BGRX; only swap red and blue
+            if (image->bits_per_pixel == 32 && image->byte_order == LSBFirst && image->red_mask == 0xFF0000 &&
+                image->green_mask == 0xFF00 && image->blue_mask == 0xFF)
+            {
+                for (int y = 0; y < height; y++)
+                {
+                    const uint32_t *src = reinterpret_cast<const uint32_t *>(image->data + (size_t)y * image->bytes_per_line);
+                    uint32_t *dst = out.Row(outY + y) + outX;
+                    for (int x = 0; x < width; x++)
+                    {
+                        uint32_t p = src[x];
+                        dst[x] = 0xFF000000u | (p & 0xFF00u) | ((p >> 16) & 0xFFu) | ((p & 0xFFu) << 16);
+                    }
+                }
+                return;
+            }
+
+            for (int y = 0; y < height; y++)
+            {
+                uint32_t *dst = out.Row(outY + y) + outX;
+                for (int x = 0; x < width; x++)
+                {
+                    unsigned long p = XGetPixel(image, x, y);
+                    dst[x] = 0xFF000000u | ExtractChannel(p, image->red_mask) | (ExtractChannel(p, image->green_mask) << 8) |
+                             (ExtractChannel(p, image->blue_mask) << 16);
+                }
+            }
+        }
+    }
+
+    X11ScreenGrabber::X11ScreenGrabber()
+        : m_display(nullptr), m_image(nullptr), m_root(0), m_desktopWidth(0), m_desktopHeight(0), m_imageWidth(0), m_imageHeight(0), m_screen(-1),
+          m_sharedImage(nullptr), m_sharedSegment(nullptr), m_sharedAvailable(false), m_failed(false)
+    {
+    }
+
+    X11ScreenGrabber::~X11ScreenGrabber() { Shutdown(); }
+
+    bool X11ScreenGrabber::Initialize()
+    {
+        if (m_display != nullptr)
+            return true;
+        if (m_failed)
+            return false;
+
+        std::lock_guard<std::mutex> lock(s_mutex);
+        Display *display = LoadX11() ? s_XOpenDisplay(nullptr) : nullptr;
+        if (display == nullptr)
+        {
+            std::cout << "Screen capture unavailable: cannot load libX11 or connect to the X server" << std::endl;
+            m_failed = true;
+            return false;
+        }
+
+        s_displays.push_back(display);
+        m_display = display;
+        if (m_screen < 0 || m_screen >= ScreenCount(display))
+            m_screen = DefaultScreen(display);
+        m_root = RootWindow(display, m_screen);
+        m_desktopWidth = DisplayWidth(display, m_screen);
+        m_desktopHeight = DisplayHeight(display, m_screen);
+
+        // Shared memory only works when the server runs on this machine; a failed attach
+        // later falls back to XGetSubImage
+        m_sharedAvailable = LoadXext() && s_XShmQueryExtension(display);
+        return true;
+    }
+
+    void X11ScreenGrabber::Shutdown()
+    {
+        DestroySharedImage();
+        DestroyImage();
+        std::vector<uint8_t>().swap(m_buffer);
+        if (m_display == nullptr)
+            return;
+
+        Display *display = (Display *)m_display;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            s_displays.erase(std::remove(s_displays.begin(), s_displays.end(), display), s_displays.end());
+        }
+        s_XCloseDisplay(display);
+        m_display = nullptr;
+    }
+
+    bool X11ScreenGrabber::Grab(int x, int y, int width, int height, Imaging::Image &out)
+    {
+        if (width <= 0 || height <= 0 || !Initialize())
+            return false;
+
+        if (out.width != width || out.height != height)
+            out.Allocate(width, height);
+
+        int x0 = std::max(x, 0);
+        int y0 = std::max(y, 0);
+        int x1 = std::min(x + width, m_desktopWidth);
+        int y1 = std::min(y + height, m_desktopHeight);
+        if (x0 != x || y0 != y || x1 != x + width || y1 != y + height)
+            std::fill(out.pixels.begin(), out.pixels.end(), 0xFF000000u);
+        if (x1 <= x0 || y1 <= y0)
+            return true;
+
+        return GrabInto(x0, y0, x1 - x0, y1 - y0, out, x0 - x, y0 - y);
+    }
+
+    bool X11ScreenGrabber::GrabInto(int x, int y, int width, int height, Imaging::Image &canvas, int canvasX, int canvasY)
+    {
+        if (width <= 0 || height <= 0 || !Initialize())
+            return false;
+
+        Display *display = (Display *)m_display;
+        XImage *image;
+        t_errorRaised = false;
+        if (m_sharedAvailable && EnsureSharedImage(width, height))
+        {
+            // The server writes straight into our segment, nothing crosses the socket
+            image = (XImage *)m_sharedImage;
+            if (!s_XShmGetImage(display, m_root, image, x, y, AllPlanes))
+                t_errorRaised = true;
+        }
+        else
+        {
+            if (!EnsureImage(width, height))
+                return false;
+            image = (XImage *)m_image;
+            if (s_XGetSubImage(display, m_root, x, y, width, height, AllPlanes, ZPixmap, image, 0, 0) == nullptr)
+                t_errorRaised = true;
+        }
+
+        if (t_errorRaised)
+        {
+            // Usually the desktop shrank, e.g. a monitor was unplugged; the next grab uses the new size
+            RefreshDesktopSize();
+            return false;
+        }
+        ConvertPixels(image, width, height, canvas, canvasX, canvasY);
+        return true;
+    }
+
+    bool X11ScreenGrabber::QueryOutputs(std::vector<X11Output> &outputs)
+    {
+        outputs.clear();
+        if (!Initialize())
+            return false;
+
+        Display *display = (Display *)m_display;
+        int screenCount = ScreenCount(display);
+        if (screenCount > 1)
+        {
+            // Separate X screens share no coordinate space; lay them out left to right
+            int desktopX = 0;
+            for (int screen = 0; screen < screenCount; screen++)
+            {
+                X11Output output = {screen, 0, 0, DisplayWidth(display, screen), DisplayHeight(display, screen), desktopX, 0};
+                outputs.push_back(output);
+                desktopX += output.width;
+            }
+            return true;
+        }
+
+        bool xinerama;
+        {
+            std::lock_guard<std::mutex> lock(s_mutex);
+            xinerama = LoadXinerama();
+        }
+        int count = 0;
+        XineramaScreenInfo *screens = xinerama && s_XineramaIsActive(display) ? s_XineramaQueryScreens(display, &count) : nullptr;
+        for (int i = 0; i < count; i++)
+        {
+            X11Output output = {m_screen, screens[i].x_org, screens[i].y_org, screens[i].width, screens[i].height, screens[i].x_org, screens[i].y_org};
+            // Mirrored monitors show up once per monitor with the same rectangle
+            bool duplicate = std::any_of(outputs.begin(), outputs.end(), [&](const X11Output &other)
+                                         { return other.x == output.x && other.y == output.y && other.width == output.width && other.height == output.height; });
+            if (!duplicate)
+                outputs.push_back(output);
+        }
+        if (screens != nullptr)
+            s_XFree(screens);
+
+        if (outputs.empty())
+        {
+            RefreshDesktopSize();
+            outputs.push_back({m_screen, 0, 0, m_desktopWidth, m_desktopHeight, 0, 0});
+        }
+        return true;
+    }
+
+    bool X11ScreenGrabber::EnsureImage(int width, int height)
+    {
+        if (m_image != nullptr && width <= m_imageWidth && height <= m_imageHeight)
+            return true;
+
+        // Grow to cover both the old and new sizes, so alternating requests do not reallocate
+        width = std::max(width, m_imageWidth);
+        height = std::max(height, m_imageHeight);
+        DestroyImage();
+
+        Display *display = (Display *)m_display;
+        XImage *image = s_XCreateImage(display, DefaultVisual(display, m_screen), DefaultDepth(display, m_screen), ZPixmap, 0, nullptr, width, height, 32, 0);
+        if (image == nullptr)
+            return false;
+
+        m_buffer.resize((size_t)image->bytes_per_line * height);
+        image->data = reinterpret_cast<char *>(m_buffer.data());
+        m_image = image;
+        m_imageWidth = width;
+        m_imageHeight = height;
+        return true;
+    }
+
+    void X11ScreenGrabber::DestroyImage()
+    {
+        if (m_image == nullptr)
+            return;
+
+        // The pixel buffer is ours; keep XDestroyImage from freeing it
+        XImage *image = (XImage *)m_image;
+        image->data = nullptr;
+        XDestroyImage(image);
+        m_image = nullptr;
+        m_imageWidth = 0;
+        m_imageHeight = 0;
+    }
+
+    bool X11ScreenGrabber::EnsureSharedImage(int width, int height)
+    {
+        // The server packs rows for the requested size, so the image must match it exactly
+        XImage *image = (XImage *)m_sharedImage;
+        if (image != nullptr && image->width == width && image->height == height)
+            return true;
+        DestroySharedImage();
+
+        Display *display = (Display *)m_display;
+        XShmSegmentInfo *segment = new XShmSegmentInfo();
+        image = s_XShmCreateImage(display, DefaultVisual(display, m_screen), DefaultDepth(display, m_screen), ZPixmap, nullptr, segment, width, height);
+        segment->shmid = image != nullptr ? shmget(IPC_PRIVATE, (size_t)image->bytes_per_line * height, IPC_CREAT | 0600) : -1;
+        segment->shmaddr = segment->shmid >= 0 ? (char *)shmat(segment->shmid, nullptr, 0) : (char *)-1;
+        segment->readOnly = False;
+
+        bool attached = false;
+        if (segment->shmaddr != (char *)-1)
+        {
+            t_errorRaised = false;
+            attached = s_XShmAttach(display, segment) && s_XSync(display, False) && !t_errorRaised;
+        }
+        // Marked for removal right away, so the segment is freed with the last detach even if we crash
+        if (segment->shmid >= 0)
+            shmctl(segment->shmid, IPC_RMID, nullptr);
+
+        if (!attached)
+        {
+            std::cout << "Screen capture: shared memory unavailable, using XGetSubImage" << std::endl;
+            if (segment->shmaddr != (char *)-1)
+                shmdt(segment->shmaddr);
+            if (image != nullptr)
+                XDestroyImage(image);
+            delete segment;
+            m_sharedAvailable = false;
+            return false;
+        }
+
+        image->data = segment->shmaddr;
+        m_sharedImage = image;
+        m_sharedSegment = segment;
+        return true;
+    }
+
+    void X11ScreenGrabber::DestroySharedImage()
+    {
+        if (m_sharedImage == nullptr)
+            return;
+
+        XImage *image = (XImage *)m_sharedImage;
+        XShmSegmentInfo *segment = (XShmSegmentInfo *)m_sharedSegment;
+        s_XShmDetach((Display *)m_display, segment);
+        shmdt(segment->shmaddr);
+        // Shared memory images only free their own header
+        XDestroyImage(image);
+        delete segment;
+        m_sharedImage = nullptr;
+        m_sharedSegment = nullptr;
+    }
+
+    void X11ScreenGrabber::RefreshDesktopSize()
+    {
+        Window root;
+        int x, y;
+        unsigned int width, height, border, depth;
+        t_errorRaised = false;
+        if (s_XGetGeometry((Display *)m_display, m_root, &root, &x, &y, &width, &height, &border, &depth) && !t_errorRaised)
+        {
+            m_desktopWidth = (int)width;
+            m_desktopHeight = (int)height;
+        }
+    }
+}
\ No newline at end of file
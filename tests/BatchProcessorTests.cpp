@@ -0,0 +1,121 @@
+// Runs the batch pipeline on real files in a scratch directory: conversion, and refusing to
+// start when two inputs would be written to the same output.
+
+#include "BatchProcessor.h"
+#include "TestCheck.h"
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace
+{
+    void WriteImage(const fs::path &path, Imaging::ImageFormat format, uint32_t color)
+    {
+        Imaging::ImageFile file;
+        file.image.Allocate(8, 6);
+        for (uint32_t &pixel : file.image.pixels)
+            pixel = color;
+        std::vector<uint8_t> data;
+        Imaging::EncodeImage(file, format, data);
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char *>(data.data()), (std::streamsize)data.size());
+    }
+
+    bool ReadImage(const fs::path &path, Imaging::ImageFile &file)
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::string error;
+        return Imaging::DecodeImage(data.data(), data.size(), file, error);
+    }
+
+    BatchOptions MakeOptions(const fs::path &root)
+    {
+        BatchOptions options;
+        options.outputDirectory = (root / "out").string();
+        options.jobs = 2;
+        return options;
+    }
+
+    void TestConvertsAndResizes(const fs::path &root)
+    {
+        fs::create_directories(root / "in");
+        WriteImage(root / "in" / "a.bmp", Imaging::ImageFormat::Bmp, 0xFF00FF00u);
+        WriteImage(root / "in" / "b.tga", Imaging::ImageFormat::Tga, 0xFF0000FFu);
+
+        BatchOptions options = MakeOptions(root);
+        options.inputs = {(root / "in").string()};
+        options.format = Imaging::ImageFormat::Png;
+        options.scale = 0.5f;
+        BatchProcessor processor(options);
+        CHECK(processor.Run() == 0);
+
+        Imaging::ImageFile file;
+        CHECK(ReadImage(root / "out" / "a.png", file));
+        CHECK(file.format == Imaging::ImageFormat::Png && file.image.width == 4 && file.image.height == 3);
+        CHECK(!file.image.pixels.empty() && file.image.pixels[0] == 0xFF00FF00u);
+        CHECK(ReadImage(root / "out" / "b.png", file));
+    }
+
+    void TestSameNameInTwoDirectories(const fs::path &root)
+    {
+        fs::create_directories(root / "in1");
+        fs::create_directories(root / "in2");
+        WriteImage(root / "in1" / "x.png", Imaging::ImageFormat::Png, 0xFFFFFFFFu);
+        WriteImage(root / "in2" / "x.png", Imaging::ImageFormat::Png, 0xFF000000u);
+
+        BatchOptions options = MakeOptions(root);
+        options.inputs = {(root / "in1").string(), (root / "in2").string()};
+        BatchProcessor processor(options);
+        CHECK(processor.Run() == 2);
+        CHECK(!fs::exists(root / "out" / "x.png"));
+    }
+
+    void TestSameStemConvertedToOneFormat(const fs::path &root)
+    {
+        fs::create_directories(root / "in");
+        WriteImage(root / "in" / "shot.png", Imaging::ImageFormat::Png, 0xFFFFFFFFu);
+        WriteImage(root / "in" / "shot.bmp", Imaging::ImageFormat::Bmp, 0xFF000000u);
+
+        // Kept in their own formats the outputs differ, converted they collide
+        BatchOptions options = MakeOptions(root);
+        options.inputs = {(root / "in").string()};
+        BatchProcessor keep(options);
+        CHECK(keep.Run() == 0);
+
+        options.outputDirectory = (root / "converted").string();
+        options.format = Imaging::ImageFormat::Png;
+        BatchProcessor convert(options);
+        CHECK(convert.Run() == 2);
+        CHECK(!fs::exists(root / "converted" / "shot.png"));
+    }
+
+    void TestOutputOverInput(const fs::path &root)
+    {
+        fs::create_directories(root / "in");
+        WriteImage(root / "in" / "a.png", Imaging::ImageFormat::Png, 0xFFFFFFFFu);
+
+        BatchOptions options = MakeOptions(root);
+        options.inputs = {(root / "in" / "a.png").string()};
+        options.outputDirectory = (root / "in").string();
+        BatchProcessor processor(options);
+        CHECK(processor.Run() == 2);
+    }
+}
+
+int main()
+{
+    fs::path scratch = fs::temp_directory_path() / "snap_tools_batch_tests";
+    void (*const tests[])(const fs::path &) = {TestConvertsAndResizes, TestSameNameInTwoDirectories, TestSameStemConvertedToOneFormat,
+                                               TestOutputOverInput};
+    for (auto test : tests)
+    {
+        fs::remove_all(scratch);
+        test(scratch);
+    }
+    fs::remove_all(scratch);
+    return TestResult("batch_processor_tests");
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+// Round-trips and malformed-stream handling for the zlib wrapper in image/Deflate, including
+// streams produced by every compression level and the output limit PNG decoding relies on.
+
+#include "TestCheck.h"
+#include "image/Deflate.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Text-like runs, a long repeat and incompressible noise, so stored, fixed and dynamic
+    // blocks all get exercised
+    std::vector<uint8_t> MakeSample(size_t size)
+    {
+        std::vector<uint8_t> data(size);
+        uint32_t state = 0x9E3779B9u;
+        const char *words = "the quick brown fox jumps over the lazy dog ";
+        size_t wordsLength = strlen(words);
+        for (size_t i = 0; i < size; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            if (i < size / 3)
+                data[i] = (uint8_t)words[i % wordsLength];
+            else if (i < size * 2 / 3)
+                data[i] = (uint8_t)(i / 4096);
+            else
+                data[i] = (uint8_t)(state >> 24);
+        }
+        return data;
+    }
+
+    void TestRoundTrip()
+    {
+        const size_t sizes[] = {0, 1, 100, 70000, 300000};
+        for (size_t size : sizes)
+        {
+            std::vector<uint8_t> data = MakeSample(size);
+            for (int level = 0; level <= 9; level++)
+            {
+                std::vector<uint8_t> compressed;
+                Imaging::ZlibCompress(data.data(), data.size(), compressed, level);
+                std::vector<uint8_t> restored;
+                CHECK(Imaging::ZlibDecompress(compressed.data(), compressed.size(), restored));
+                CHECK(restored == data);
+            }
+        }
+    }
+
+    void TestCompressesRedundantData()
+    {
+        std::vector<uint8_t> zeros(1 << 20, 0);
+        std::vector<uint8_t> compressed;
+        Imaging::ZlibCompress(zeros.data(), zeros.size(), compressed, 6);
+        CHECK(compressed.size() < zeros.size() / 100);
+    }
+
+    // Known-good stream produced by zlib: "hello hello hello hello" at the default level
+    void TestDecodesReferenceStream()
+    {
+        const uint8_t stream[] = {0x78, 0x9c, 0xcb, 0x48, 0xcd, 0xc9, 0xc9, 0x57, 0xc8, 0x40, 0x27, 0x01, 0x68, 0x03, 0x08, 0xb1};
+        std::vector<uint8_t> out;
+        CHECK(Imaging::ZlibDecompress(stream, sizeof(stream), out));
+        CHECK(std::string(out.begin(), out.end()) == "hello hello hello hello");
+    }
+
+    void TestTruncatedInput()
+    {
+        std::vector<uint8_t> data = MakeSample(50000);
+        std::vector<uint8_t> compressed;
+        Imaging::ZlibCompress(data.data(), data.size(), compressed, 6);
+
+        // Every prefix must fail cleanly rather than crash or report success
+        std::vector<uint8_t> out;
+        for (size_t length = 0; length < compressed.size(); length += length < 64 ? 1 : 97)
+            CHECK(!Imaging::ZlibDecompress(compressed.data(), length, out));
+    }
+
+    void TestCorruptInput()
+    {
+        std::vector<uint8_t> data = MakeSample(50000);
+        std::vector<uint8_t> compressed;
+        Imaging::ZlibCompress(data.data(), data.size(), compressed, 6);
+        std::vector<uint8_t> out;
+
+        // Bad header check bits
+        std::vector<uint8_t> badHeader = compressed;
+        badHeader[1] ^= 0x01;
+        CHECK(!Imaging::ZlibDecompress(badHeader.data(), badHeader.size(), out));
+
+        // Adler-32 mismatch
+        std::vector<uint8_t> badChecksum = compressed;
+        badChecksum.back() ^= 0xFF;
+        CHECK(!Imaging::ZlibDecompress(badChecksum.data(), badChecksum.size(), out));
+
+        // Flipped bits inside the deflate data either fail to decode or fail the checksum
+        for (size_t i = 2; i + 4 < compressed.size(); i += 131)
+        {
+            std::vector<uint8_t> damaged = compressed;
+            damaged[i] ^= 0x5A;
+            CHECK(!Imaging::ZlibDecompress(damaged.data(), damaged.size(), out));
+        }
+    }
+
+    void TestOutputLimit()
+    {
+        std::vector<uint8_t> zeros(1 << 20, 0);
+        std::vector<uint8_t> compressed;
+        Imaging::ZlibCompress(zeros.data(), zeros.size(), compressed, 9);
+        std::vector<uint8_t> out;
+        CHECK(!Imaging::ZlibDecompress(compressed.data(), compressed.size(), out, zeros.size() - 1));
+        CHECK(Imaging::ZlibDecompress(compressed.data(), compressed.size(), out, zeros.size()));
+    }
+
+    void TestChecksums()
+    {
+        const char *text = "123456789";
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(text);
+        CHECK(Imaging::Crc32(0, bytes, 9) == 0xCBF43926u);
+        CHECK(Imaging::Adler32(1, bytes, 9) == 0x091E01DEu);
+    }
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestCompressesRedundantData();
+    TestDecodesReferenceStream();
+    TestTruncatedInput();
+    TestCorruptInput();
+    TestOutputLimit();
+    TestChecksums();
+    return TestResult("deflate_tests");
+}
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Drives the real application on the headless platform through display scale changes and
+// checks that each switch lands within a few frames and leaves exactly the style derived from
+// the unscaled base. How long those frames take is measured by the bench's dpi_switch scenario,
+// not here, so the test does not depend on the machine's speed.
+
+#include "Application.h"
+#include "TestCheck.h"
+#include "platform/HeadlessPlatform.h"
+#include <memory>
+
+namespace
+{
+    // Glyph prewarm for the default font takes two frames, the switch itself one more
+    constexpr int MAX_SWITCH_FRAMES = 4;
+
+    bool StyleMatches(const ImGuiStyle &style, const ImGuiStyle &expected, float scale)
+    {
+        return style.WindowPadding.x == expected.WindowPadding.x && style.WindowPadding.y == expected.WindowPadding.y &&
+               style.FramePadding.x == expected.FramePadding.x && style.FramePadding.y == expected.FramePadding.y &&
+               style.ItemSpacing.x == expected.ItemSpacing.x && style.ItemSpacing.y == expected.ItemSpacing.y &&
+               style.ScrollbarSize == expected.ScrollbarSize && style.GrabMinSize == expected.GrabMinSize &&
+               style.WindowRounding == expected.WindowRounding && style.FontScaleDpi == scale;
+    }
+
+    void TestScaleSwitches(Application &app, Platform::HeadlessPlatform &platform)
+    {
+        const Platform::DpiScaler &scaler = platform.GetDpiScaler();
+        const ImGuiStyle base = scaler.GetBaseStyle();
+
+        // Back and forth, ending at 1.0 so any accumulated rounding would show
+        const float scales[] = {1.5f, 2.0f, 1.25f, 1.0f, 2.0f, 1.0f};
+        for (float scale : scales)
+        {
+            platform.SetDisplayScale(scale);
+            int frames = 0;
+            while (scaler.IsSwitching() && frames <= MAX_SWITCH_FRAMES)
+            {
+                app.Tick();
+                frames++;
+            }
+            if (frames > MAX_SWITCH_FRAMES)
+                fprintf(stderr, "switch to %.2f took %d frames\n", scale, frames);
+            CHECK(!scaler.IsSwitching());
+            CHECK(frames <= MAX_SWITCH_FRAMES);
+            CHECK(scaler.GetScale() == scale);
+
+            // The style is always derived from the unscaled base, never from the previous scale
+            ImGuiStyle expected = base;
+            expected.ScaleAllSizes(scale);
+            app.Tick();
+            CHECK(StyleMatches(ImGui::GetStyle(), expected, scale));
+        }
+
+        CHECK(StyleMatches(ImGui::GetStyle(), base, 1.0f));
+    }
+
+    void TestRepeatedAndChangedRequests(Application &app, Platform::HeadlessPlatform &platform)
+    {
+        const Platform::DpiScaler &scaler = platform.GetDpiScaler();
+        platform.SetDisplayScale(scaler.GetScale());
+        CHECK(!scaler.IsSwitching());
+
+        // A new target mid-switch replaces the old one
+        platform.SetDisplayScale(1.75f);
+        app.Tick();
+        platform.SetDisplayScale(1.5f);
+        for (int i = 0; i < MAX_SWITCH_FRAMES && scaler.IsSwitching(); i++)
+            app.Tick();
+        CHECK(scaler.GetScale() == 1.5f);
+        CHECK(ImGui::GetStyle().FontScaleDpi == 1.5f);
+    }
+}
+
+int main()
+{
+    auto platform = std::make_unique<Platform::HeadlessPlatform>();
+    Platform::HeadlessPlatform *headless = platform.get();
+
+    Application app;
+    if (!app.Initialize(std::move(platform)))
+    {
+        fprintf(stderr, "Failed to initialize the headless application\n");
+        return 1;
+    }
+    headless->SetWindowSize(1280, 800);
+    app.GetUI()->SetToolOpen(UIManager::TOOL_SETTINGS, true);
+
+    // Settle the first frames, which build the font atlas
+    for (int i = 0; i < 5; i++)
+        app.Tick();
+
+    TestScaleSwitches(app, *headless);
+    TestRepeatedAndChangedRequests(app, *headless);
+
+    app.Shutdown();
+    return TestResult("dpi_switch_tests");
+}
\ No newline at end of file
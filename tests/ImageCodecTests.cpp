@@ -0,0 +1,193 @@
+// Encode/decode round-trips for every supported format, detection from the data rather than
+// the file name, PNG metadata handling, and rejection of truncated or corrupt files.
+
+#include "TestCheck.h"
+#include "image/Deflate.h"
+#include "image/ImageCodec.h"
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+    Imaging::Image MakeImage(int width, int height, bool opaque)
+    {
+        Imaging::Image image;
+        image.Allocate(width, height);
+        for (int y = 0; y < height; y++)
+        {
+            uint32_t *row = image.Row(y);
+            for (int x = 0; x < width; x++)
+            {
+                uint32_t r = (uint32_t)(x * 37) & 0xFF;
+                uint32_t g = (uint32_t)(y * 59) & 0xFF;
+                uint32_t b = (uint32_t)((x ^ y) * 13) & 0xFF;
+                uint32_t a = opaque ? 255u : (uint32_t)((x + y) * 7) & 0xFF;
+                row[x] = r | (g << 8) | (b << 16) | (a << 24);
+            }
+        }
+        return image;
+    }
+
+    bool SamePixels(const Imaging::Image &a, const Imaging::Image &b)
+    {
+        return a.width == b.width && a.height == b.height && a.pixels == b.pixels;
+    }
+
+    bool Decode(const std::vector<uint8_t> &data, Imaging::ImageFile &file)
+    {
+        std::string error;
+        bool ok = Imaging::DecodeImage(data.data(), data.size(), file, error);
+        if (ok != error.empty())
+            fprintf(stderr, "decode result and error message disagree: %s\n", error.c_str());
+        return ok;
+    }
+
+    void TestRoundTrips()
+    {
+        const Imaging::ImageFormat formats[] = {Imaging::ImageFormat::Png, Imaging::ImageFormat::Bmp, Imaging::ImageFormat::Tga,
+                                                Imaging::ImageFormat::Ppm};
+        const int sizes[][2] = {{1, 1}, {3, 5}, {64, 48}, {257, 3}};
+        for (Imaging::ImageFormat format : formats)
+        {
+            // PPM has no alpha channel, so it only round-trips opaque images
+            for (int alpha = 0; alpha < (format == Imaging::ImageFormat::Ppm ? 1 : 2); alpha++)
+            {
+                for (const auto &size : sizes)
+                {
+                    Imaging::ImageFile source;
+                    source.image = MakeImage(size[0], size[1], alpha == 0);
+                    source.format = format;
+                    std::vector<uint8_t> encoded;
+                    CHECK(Imaging::EncodeImage(source, format, encoded));
+
+                    Imaging::ImageFile decoded;
+                    CHECK(Decode(encoded, decoded));
+                    CHECK(decoded.format == format);
+                    CHECK(SamePixels(decoded.image, source.image));
+                }
+            }
+        }
+    }
+
+    void TestPngCompressionLevels()
+    {
+        Imaging::ImageFile source;
+        source.image = MakeImage(100, 80, false);
+        for (int level = 0; level <= 9; level++)
+        {
+            std::vector<uint8_t> encoded;
+            CHECK(Imaging::EncodeImage(source, Imaging::ImageFormat::Png, encoded, level));
+            Imaging::ImageFile decoded;
+            CHECK(Decode(encoded, decoded));
+            CHECK(SamePixels(decoded.image, source.image));
+        }
+    }
+
+    void TestFormatNames()
+    {
+        CHECK(Imaging::FormatFromPath("shot.PNG") == Imaging::ImageFormat::Png);
+        CHECK(Imaging::FormatFromPath("dir.bmp/shot.tga") == Imaging::ImageFormat::Tga);
+        CHECK(Imaging::FormatFromPath("shot.pnm") == Imaging::ImageFormat::Ppm);
+        CHECK(Imaging::FormatFromPath("shot") == Imaging::ImageFormat::Unknown);
+        CHECK(Imaging::FormatFromName("Bmp") == Imaging::ImageFormat::Bmp);
+        CHECK(Imaging::FormatFromName("jpeg") == Imaging::ImageFormat::Unknown);
+    }
+
+    // Appends a PNG chunk with its CRC
+    void AppendChunk(std::vector<uint8_t> &png, const char *type, const std::vector<uint8_t> &data)
+    {
+        uint32_t length = (uint32_t)data.size();
+        for (int shift = 24; shift >= 0; shift -= 8)
+            png.push_back((uint8_t)(length >> shift));
+        size_t start = png.size();
+        png.insert(png.end(), type, type + 4);
+        png.insert(png.end(), data.begin(), data.end());
+        uint32_t crc = Imaging::Crc32(0, png.data() + start, png.size() - start);
+        for (int shift = 24; shift >= 0; shift -= 8)
+            png.push_back((uint8_t)(crc >> shift));
+    }
+
+    // A 2x1 RGB PNG built by hand, with a text chunk and an sRGB chunk before IDAT
+    std::vector<uint8_t> MakePngWithMetadata()
+    {
+        std::vector<uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        AppendChunk(png, "IHDR", {0, 0, 0, 2, 0, 0, 0, 1, 8, 2, 0, 0, 0});
+        AppendChunk(png, "sRGB", {0});
+        const char *text = "Comment\0secret";
+        AppendChunk(png, "tEXt", std::vector<uint8_t>(text, text + 14));
+        const uint8_t scanline[] = {0, 255, 0, 0, 0, 0, 255};
+        std::vector<uint8_t> idat;
+        Imaging::ZlibCompress(scanline, sizeof(scanline), idat);
+        AppendChunk(png, "IDAT", idat);
+        AppendChunk(png, "IEND", {});
+        return png;
+    }
+
+    void TestPngMetadata()
+    {
+        Imaging::ImageFile file;
+        CHECK(Decode(MakePngWithMetadata(), file));
+        CHECK(file.image.width == 2 && file.image.height == 1);
+        CHECK(file.image.pixels.size() == 2 && file.image.pixels[0] == 0xFF0000FFu && file.image.pixels[1] == 0xFFFF0000u);
+        CHECK(file.metadata.size() == 2);
+
+        // Metadata survives a PNG round-trip; stripping keeps only the color space chunk
+        std::vector<uint8_t> encoded;
+        CHECK(Imaging::EncodeImage(file, Imaging::ImageFormat::Png, encoded));
+        Imaging::ImageFile reloaded;
+        CHECK(Decode(encoded, reloaded));
+        CHECK(reloaded.metadata.size() == 2);
+
+        Imaging::StripMetadata(reloaded);
+        CHECK(reloaded.metadata.size() == 1 && strcmp(reloaded.metadata[0].type, "sRGB") == 0);
+    }
+
+    void TestTruncatedFiles()
+    {
+        const Imaging::ImageFormat formats[] = {Imaging::ImageFormat::Png, Imaging::ImageFormat::Bmp, Imaging::ImageFormat::Tga,
+                                                Imaging::ImageFormat::Ppm};
+        for (Imaging::ImageFormat format : formats)
+        {
+            Imaging::ImageFile source;
+            source.image = MakeImage(40, 30, format == Imaging::ImageFormat::Ppm);
+            std::vector<uint8_t> encoded;
+            CHECK(Imaging::EncodeImage(source, format, encoded));
+
+            // Any strict prefix must be rejected, never read past the end or decoded partially
+            for (size_t length = 0; length < encoded.size(); length += length < 128 ? 1 : 61)
+            {
+                std::vector<uint8_t> prefix(encoded.begin(), encoded.begin() + (std::ptrdiff_t)length);
+                Imaging::ImageFile decoded;
+                CHECK(!Decode(prefix, decoded));
+            }
+        }
+    }
+
+    void TestCorruptFiles()
+    {
+        Imaging::ImageFile file;
+        CHECK(!Decode({}, file));
+        CHECK(!Decode({'n', 'o', 't', ' ', 'a', 'n', ' ', 'i', 'm', 'a', 'g', 'e'}, file));
+
+        // A PNG chunk whose CRC no longer matches
+        std::vector<uint8_t> png = MakePngWithMetadata();
+        png[20] ^= 0x01; // Inside IHDR's width
+        CHECK(!Decode(png, file));
+
+        // Dimensions far larger than the data that follows
+        std::vector<uint8_t> ppm = {'P', '6', '\n', '9', '9', '9', '9', '9', ' ', '9', '9', '9', '9', '9', '\n', '2', '5', '5', '\n', 1, 2, 3};
+        CHECK(!Decode(ppm, file));
+    }
+}
+
+int main()
+{
+    TestRoundTrips();
+    TestPngCompressionLevels();
+    TestFormatNames();
+    TestPngMetadata();
+    TestTruncatedFiles();
+    TestCorruptFiles();
+    return TestResult("image_codec_tests");
+}
\ No newline at end of file
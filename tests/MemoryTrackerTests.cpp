@@ -0,0 +1,73 @@
+// Budget enforcement order and re-entrancy of the memory tracker's evict callbacks.
+
+#include "MemoryTracker.h"
+#include "TestCheck.h"
+#include <vector>
+
+namespace
+{
+    void TestEvictsLowestPriorityFirst()
+    {
+        MemoryTracker &tracker = MemoryTracker::Get();
+        std::vector<int> order;
+        size_t cheap = 100, expensive = 100;
+        int a = tracker.Register("expensive", MemoryKind::Gpu, [&]()
+                                 { return expensive; }, [&](size_t)
+                                 { order.push_back(2); size_t bytes = expensive; expensive = 0; return bytes; }, 5);
+        int b = tracker.Register("cheap", MemoryKind::Gpu, [&]()
+                                 { return cheap; }, [&](size_t)
+                                 { order.push_back(1); size_t bytes = cheap; cheap = 0; return bytes; }, 0);
+
+        // 200 tracked against a 150 budget: evicting down to 135 only needs the cheap source
+        tracker.SetBudgets(0, 150);
+        tracker.Sample();
+        CHECK(order.size() == 1 && order[0] == 1);
+        CHECK(cheap == 0 && expensive == 100);
+        CHECK(tracker.GetTrackedBytes(MemoryKind::Gpu) == 100);
+
+        // Everything, still in priority order
+        order.clear();
+        CHECK(tracker.EvictAll(MemoryKind::Gpu) == 100);
+        CHECK(order.size() == 2 && order[0] == 1 && order[1] == 2);
+        CHECK(expensive == 0);
+
+        tracker.SetBudgets(0, 0);
+        tracker.Unregister(a);
+        tracker.Unregister(b);
+    }
+
+    // Callbacks run without the tracker's lock, so they may register and unregister sources;
+    // a source unregistered by an earlier callback is not called any more
+    void TestCallbacksMayReenter()
+    {
+        MemoryTracker &tracker = MemoryTracker::Get();
+        int later = 0;
+        bool laterCalled = false;
+        int first = tracker.Register("first", MemoryKind::Heap, nullptr, [&](size_t)
+                                     {
+                                         tracker.Unregister(later);
+                                         int replacement = tracker.Register("replacement", MemoryKind::Heap, nullptr);
+                                         tracker.Unregister(replacement);
+                                         return (size_t)60; }, 0);
+        later = tracker.Register("later", MemoryKind::Heap, nullptr, [&](size_t)
+                                 { laterCalled = true; return (size_t)5; }, 1);
+
+        CHECK(tracker.EvictAll(MemoryKind::Heap) == 60);
+        CHECK(!laterCalled);
+        bool recorded = false;
+        for (const MemorySourceStats &stats : tracker.GetSources())
+        {
+            if (stats.id == first)
+                recorded = stats.evictedBytes == 60;
+        }
+        CHECK(recorded);
+        tracker.Unregister(first);
+    }
+}
+
+int main()
+{
+    TestEvictsLowestPriorityFirst();
+    TestCallbacksMayReenter();
+    return TestResult("memory_tracker_tests");
+}
\ No newline at end of file
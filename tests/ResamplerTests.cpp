@@ -0,0 +1,282 @@
+// Resampler correctness: same-size copies are bit-exact, flat images stay flat under every
+// filter, a 2:1 box downscale averages each 2x2 block in premultiplied linear light, odd and
+// one-pixel sizes stay in bounds, and banding across threads changes nothing. Built twice, as for
+// this machine and forced onto the scalar path; the scalar run writes its results and the other
+// compares against them byte for byte.
+
+#include "TestCheck.h"
+#include "image/Resampler.h"
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+    constexpr Imaging::ResampleFilter FILTERS[] = {Imaging::ResampleFilter::Box, Imaging::ResampleFilter::Mitchell,
+                                                   Imaging::ResampleFilter::Lanczos3};
+
+    struct SizeCase
+    {
+        int srcWidth, srcHeight, dstWidth, dstHeight;
+    };
+
+    // Down, up, one axis only, odd ratios and one-pixel edges
+    constexpr SizeCase SIZES[] = {
+        {64, 48, 32, 24}, {37, 23, 16, 9}, {37, 23, 80, 50}, {7, 5, 3, 2}, {5, 9, 9, 5}, {40, 30, 40, 11},
+        {40, 30, 13, 30}, {1, 17, 1, 6},   {17, 1, 6, 1},    {1, 1, 5, 3}, {3, 1, 1, 1}, {9, 9, 1, 1},
+    };
+
+    uint32_t Pack(uint32_t r, uint32_t g, uint32_t b, uint32_t a)
+    {
+        return r | (g << 8) | (b << 16) | (a << 24);
+    }
+
+    uint32_t Channel(uint32_t pixel, int c)
+    {
+        return (pixel >> (c * 8)) & 0xFF;
+    }
+
+    // Hard edges, gradients and varying alpha, so ringing and premultiplication both show
+    Imaging::Image MakeImage(int width, int height)
+    {
+        Imaging::Image image;
+        image.Allocate(width, height);
+        for (int y = 0; y < height; y++)
+        {
+            uint32_t *row = image.Row(y);
+            for (int x = 0; x < width; x++)
+            {
+                uint32_t r = ((x / 3 + y / 2) & 1) ? 250u : 10u;
+                uint32_t g = (uint32_t)(x * 255 / (width > 1 ? width - 1 : 1));
+                uint32_t b = (uint32_t)((x * 31 + y * 17) & 0xFF);
+                uint32_t a = (uint32_t)(255 - ((x + y * 3) * 11) % 200);
+                row[x] = Pack(r, g, b, a);
+            }
+        }
+        return image;
+    }
+
+    Imaging::Image MakeFlat(int width, int height, uint32_t pixel)
+    {
+        Imaging::Image image;
+        image.Allocate(width, height);
+        for (uint32_t &p : image.pixels)
+            p = pixel;
+        return image;
+    }
+
+    double ToLinear(uint32_t v)
+    {
+        double c = v / 255.0;
+        return c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+    }
+
+    uint32_t ToSrgb(double l)
+    {
+        l = l < 0.0 ? 0.0 : (l > 1.0 ? 1.0 : l);
+        double c = l <= 0.0031308 ? l * 12.92 : 1.055 * std::pow(l, 1.0 / 2.4) - 0.055;
+        return (uint32_t)std::lround(c * 255.0);
+    }
+
+    void TestIdentity()
+    {
+        Imaging::Resampler resampler(2);
+        Imaging::Image src = MakeImage(33, 21);
+        for (Imaging::ResampleFilter filter : FILTERS)
+        {
+            Imaging::Image dst;
+            CHECK(resampler.Resample(src, dst, src.width, src.height, filter));
+            CHECK(dst.width == src.width && dst.height == src.height && dst.pixels == src.pixels);
+        }
+    }
+
+    void TestConstantColor()
+    {
+        Imaging::Resampler resampler(2);
+        const uint32_t colors[] = {Pack(200, 120, 40, 255), Pack(0, 0, 0, 255), Pack(255, 255, 255, 255),
+                                   Pack(90, 180, 30, 128), Pack(12, 34, 56, 1)};
+        for (uint32_t color : colors)
+        {
+            for (const SizeCase &size : SIZES)
+            {
+                Imaging::Image src = MakeFlat(size.srcWidth, size.srcHeight, color);
+                for (Imaging::ResampleFilter filter : FILTERS)
+                {
+                    Imaging::Image dst;
+                    CHECK(resampler.Resample(src, dst, size.dstWidth, size.dstHeight, filter));
+                    bool flat = dst.width == size.dstWidth && dst.height == size.dstHeight;
+                    for (uint32_t p : dst.pixels)
+                        flat = flat && p == color;
+                    if (!flat)
+                        fprintf(stderr, "  %08X %dx%d -> %dx%d with %s is not flat\n", color, size.srcWidth,
+                                size.srcHeight, size.dstWidth, size.dstHeight, Imaging::GetFilterName(filter));
+                    CHECK(flat);
+                }
+            }
+        }
+    }
+
+    // Weights are rounded to float and the linear-to-sRGB table is quantized, so allow one step
+    void TestBoxHalving()
+    {
+        Imaging::Resampler resampler(2);
+        Imaging::Image src = MakeImage(30, 22);
+        Imaging::Image dst;
+        CHECK(resampler.Resample(src, dst, 15, 11, Imaging::ResampleFilter::Box));
+        CHECK(dst.width == 15 && dst.height == 11);
+        if (dst.width != 15 || dst.height != 11)
+            return;
+
+        int worst = 0;
+        for (int y = 0; y < dst.height; y++)
+        {
+            for (int x = 0; x < dst.width; x++)
+            {
+                double sum[4] = {0.0, 0.0, 0.0, 0.0};
+                for (int k = 0; k < 4; k++)
+                {
+                    uint32_t p = src.Row(y * 2 + k / 2)[x * 2 + k % 2];
+                    double a = Channel(p, 3) / 255.0;
+                    for (int c = 0; c < 3; c++)
+                        sum[c] += ToLinear(Channel(p, c)) * a;
+                    sum[3] += a;
+                }
+                uint32_t actual = dst.Row(y)[x];
+                double alpha = sum[3] / 4.0;
+                for (int c = 0; c < 4; c++)
+                {
+                    uint32_t expected = c == 3 ? (uint32_t)std::lround(alpha * 255.0) : ToSrgb(sum[c] / 4.0 / alpha);
+                    int diff = std::abs((int)Channel(actual, c) - (int)expected);
+                    worst = diff > worst ? diff : worst;
+                }
+            }
+        }
+        if (worst > 1)
+            fprintf(stderr, "  2:1 box differs from the 2x2 average by %d\n", worst);
+        CHECK(worst <= 1);
+    }
+
+    // A single source row or column has nothing to blend with along that axis
+    void TestOnePixelEdges()
+    {
+        Imaging::Resampler resampler(1);
+        Imaging::Image column;
+        column.Allocate(1, 12);
+        for (int y = 0; y < 12; y++)
+            column.Row(y)[0] = Pack(y * 20, 255 - y * 20, 77, 255);
+        for (Imaging::ResampleFilter filter : FILTERS)
+        {
+            Imaging::Image dst;
+            CHECK(resampler.Resample(column, dst, 7, 12, filter));
+            bool rowsFlat = dst.width == 7 && dst.height == 12;
+            for (int y = 0; rowsFlat && y < 12; y++)
+            {
+                for (int x = 0; x < 7; x++)
+                    rowsFlat = rowsFlat && dst.Row(y)[x] == column.Row(y)[0];
+            }
+            CHECK(rowsFlat);
+        }
+
+        Imaging::Image empty;
+        Imaging::Image dst;
+        CHECK(!resampler.Resample(empty, dst, 4, 4, Imaging::ResampleFilter::Box));
+        CHECK(!resampler.Resample(column, dst, 0, 4, Imaging::ResampleFilter::Box));
+
+        CHECK(resampler.ResampleToFit(MakeImage(9, 3), dst, 4, 4, Imaging::ResampleFilter::Lanczos3));
+        CHECK(dst.width == 4 && dst.height == 1);
+        CHECK(resampler.ResampleToFit(MakeImage(3, 9), dst, 100, 100, Imaging::ResampleFilter::Lanczos3));
+        CHECK(dst.width == 3 && dst.height == 9);
+    }
+
+    // Every case and filter on the patterned image, appended in a fixed order
+    std::vector<uint32_t> RunAll(int threadCount)
+    {
+        Imaging::Resampler resampler(threadCount);
+        std::vector<uint32_t> results;
+        for (const SizeCase &size : SIZES)
+        {
+            Imaging::Image src = MakeImage(size.srcWidth, size.srcHeight);
+            for (Imaging::ResampleFilter filter : FILTERS)
+            {
+                Imaging::Image dst;
+                CHECK(resampler.Resample(src, dst, size.dstWidth, size.dstHeight, filter));
+                CHECK(dst.width == size.dstWidth && dst.height == size.dstHeight);
+                results.insert(results.end(), dst.pixels.begin(), dst.pixels.end());
+            }
+        }
+        // Tall enough to be split into several bands
+        Imaging::Image large = MakeImage(300, 700);
+        for (Imaging::ResampleFilter filter : FILTERS)
+        {
+            Imaging::Image dst;
+            CHECK(resampler.Resample(large, dst, 170, 333, filter));
+            results.insert(results.end(), dst.pixels.begin(), dst.pixels.end());
+        }
+        return results;
+    }
+
+    bool WriteResults(const char *path, const std::vector<uint32_t> &results)
+    {
+        FILE *file = fopen(path, "wb");
+        if (!file)
+            return false;
+        bool ok = fwrite(results.data(), sizeof(uint32_t), results.size(), file) == results.size();
+        return fclose(file) == 0 && ok;
+    }
+
+    bool ReadResults(const char *path, std::vector<uint32_t> &results)
+    {
+        FILE *file = fopen(path, "rb");
+        if (!file)
+            return false;
+        uint32_t value;
+        while (fread(&value, sizeof(value), 1, file) == 1)
+            results.push_back(value);
+        fclose(file);
+        return true;
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 3 || (strcmp(argv[1], "--write") != 0 && strcmp(argv[1], "--compare") != 0))
+    {
+        fprintf(stderr, "Usage: %s --write|--compare <results file>\n", argv[0]);
+        return 2;
+    }
+
+#ifdef RESAMPLER_NO_SSE2
+    printf("Scalar resampler\n");
+#else
+    printf("Default resampler (SSE2 where available)\n");
+#endif
+    TestIdentity();
+    TestConstantColor();
+    TestBoxHalving();
+    TestOnePixelEdges();
+
+    std::vector<uint32_t> single = RunAll(1);
+    std::vector<uint32_t> banded = RunAll(4);
+    CHECK(single == banded);
+
+    if (strcmp(argv[1], "--write") == 0)
+    {
+        CHECK(WriteResults(argv[2], single));
+    }
+    else
+    {
+        std::vector<uint32_t> other;
+        CHECK(ReadResults(argv[2], other));
+        CHECK(other.size() == single.size());
+        size_t mismatches = 0;
+        for (size_t i = 0; i < other.size() && i < single.size(); i++)
+            mismatches += other[i] != single[i];
+        if (mismatches)
+            fprintf(stderr, "  %zu of %zu pixels differ from %s\n", mismatches, single.size(), argv[2]);
+        CHECK(mismatches == 0);
+    }
+
+    return TestResult("resampler_tests");
+}
\ No newline at end of file
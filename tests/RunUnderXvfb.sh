@@ -0,0 +1,42 @@
+#!/usr/bin/env bash
+# Starts a virtual X server with two screens of different sizes and runs the X11 desktop
+# capture test against it. Exits with 77, which CTest reports as skipped, when Xvfb is not
+# installed.
+#
+# Usage: tests/RunUnderXvfb.sh <snap_tools_x11_capture_tests>
+#
+# Xvfb picks a free display number itself (-displayfd), so parallel runs and machines that
+# already have a server on :99 do not collide.
+
+set -euo pipefail
+
+TEST_BINARY="$1"
+SCREEN0="1280x1024"
+SCREEN1="800x600"
+
+if ! command -v Xvfb >/dev/null 2>&1; then
+    echo "Xvfb not found, skipping"
+    exit 77
+fi
+
+# Xvfb writes the display number to fd 3 once it accepts connections
+DISPLAY_FILE="$(mktemp)"
+Xvfb -displayfd 3 -screen 0 "${SCREEN0}x24" -screen 1 "${SCREEN1}x24" -nolisten tcp 3>"${DISPLAY_FILE}" &
+XVFB_PID=$!
+trap 'kill "${XVFB_PID}" 2>/dev/null || true; wait "${XVFB_PID}" 2>/dev/null || true; rm -f "${DISPLAY_FILE}"' EXIT
+
+for _ in $(seq 100); do
+    [ -s "${DISPLAY_FILE}" ] && break
+    if ! kill -0 "${XVFB_PID}" 2>/dev/null; then
+        echo "Xvfb failed to start"
+        exit 1
+    fi
+    sleep 0.1
+done
+DISPLAY_NUMBER="$(head -n 1 "${DISPLAY_FILE}")"
+if [ -z "${DISPLAY_NUMBER}" ] || ! kill -0 "${XVFB_PID}" 2>/dev/null; then
+    echo "Xvfb did not report a display"
+    exit 1
+fi
+
+DISPLAY=":${DISPLAY_NUMBER}" "${TEST_BINARY}" "${SCREEN0}" "${SCREEN1}"
@@ -0,0 +1,310 @@
+// Pixel-exact output of the software renderer. A fixed ImDrawData with solid and textured
+// triangles, an Alpha8 texture, clip rects and a partial redraw is rendered and compared
+// byte-for-byte with the reference snapshots in tests/golden. The SSE2 and scalar builds, with
+// one and with several threads, all have to produce the same references.
+//
+// Usage: snap_tools_software_renderer_tests <golden dir> [--update]
+
+#include "TestCheck.h"
+#include "platform/SoftwareRenderer.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Framebuffer of 2x2 tiles, the right and bottom ones partial. The display starts away from
+    // the origin so the DisplayPos offset is exercised too.
+    constexpr float DISPLAY_X = 10.0f;
+    constexpr float DISPLAY_Y = 20.0f;
+    constexpr int WIDTH = 96;
+    constexpr int HEIGHT = 80;
+    const ImVec4 CLEAR_COLOR(0.1f, 0.2f, 0.3f, 1.0f);
+    constexpr uint32_t CLEAR_PIXEL = 0xFF4D331Au;
+
+    // Display coordinates of the partial redraw, fractional so the rounding outwards is covered
+    const ImVec4 DAMAGE(28.5f, 38.2f, 70.3f, 72.9f);
+
+    constexpr uint32_t CHECKER[4] = {0xFF2040E0u, 0xFFF0F0F0u, 0xFF10C020u, 0xFF000000u};
+
+    int g_callbackCalls = 0;
+
+    void CountCallback(const ImDrawList *, const ImDrawCmd *)
+    {
+        g_callbackCalls++;
+    }
+
+    // Everything ImDrawData points to, built by hand so the test does not need an ImGui context
+    struct Scene
+    {
+        ImTextureData checker;  // RGBA32 4x4
+        ImTextureData coverage; // Alpha8 8x8, like the font atlas
+        ImVector<ImTextureData *> textures;
+        ImDrawList list;
+        ImDrawData drawData;
+
+        Scene() : list(nullptr) {}
+    };
+
+    void BeginCommand(ImDrawList &list, const ImVec4 &clipRect, ImTextureRef texture)
+    {
+        ImDrawCmd cmd;
+        cmd.ClipRect = clipRect;
+        cmd.TexRef = texture;
+        cmd.VtxOffset = 0;
+        cmd.IdxOffset = (unsigned int)list.IdxBuffer.Size;
+        cmd.ElemCount = 0;
+        cmd.UserCallback = nullptr;
+        cmd.UserCallbackData = nullptr;
+        list.CmdBuffer.push_back(cmd);
+    }
+
+    void AddCallback(ImDrawList &list, ImDrawCallback callback)
+    {
+        BeginCommand(list, ImVec4(0, 0, 0, 0), ImTextureRef());
+        list.CmdBuffer.back().UserCallback = callback;
+    }
+
+    void AddVertex(ImDrawList &list, ImVec2 pos, ImVec2 uv, ImU32 color)
+    {
+        ImDrawVert vertex;
+        vertex.pos = pos;
+        vertex.uv = uv;
+        vertex.col = color;
+        list.VtxBuffer.push_back(vertex);
+    }
+
+    void AddTriangle(ImDrawList &list, ImVec2 a, ImVec2 b, ImVec2 c, ImU32 colorA, ImU32 colorB, ImU32 colorC)
+    {
+        ImDrawIdx first = (ImDrawIdx)list.VtxBuffer.Size;
+        AddVertex(list, a, ImVec2(0, 0), colorA);
+        AddVertex(list, b, ImVec2(0, 0), colorB);
+        AddVertex(list, c, ImVec2(0, 0), colorC);
+        for (int i = 0; i < 3; i++)
+            list.IdxBuffer.push_back((ImDrawIdx)(first + i));
+        list.CmdBuffer.back().ElemCount += 3;
+    }
+
+    void AddQuad(ImDrawList &list, ImVec2 min, ImVec2 max, ImVec2 uvMin, ImVec2 uvMax, ImU32 color)
+    {
+        ImDrawIdx first = (ImDrawIdx)list.VtxBuffer.Size;
+        AddVertex(list, min, uvMin, color);
+        AddVertex(list, ImVec2(max.x, min.y), ImVec2(uvMax.x, uvMin.y), color);
+        AddVertex(list, max, uvMax, color);
+        AddVertex(list, ImVec2(min.x, max.y), ImVec2(uvMin.x, uvMax.y), color);
+        const ImDrawIdx order[6] = {0, 1, 2, 0, 2, 3};
+        for (ImDrawIdx index : order)
+            list.IdxBuffer.push_back((ImDrawIdx)(first + index));
+        list.CmdBuffer.back().ElemCount += 6;
+    }
+
+    void CreateTextures(Scene &scene)
+    {
+        scene.checker.Create(ImTextureFormat_RGBA32, 4, 4);
+        uint32_t *checker = (uint32_t *)scene.checker.GetPixels();
+        for (int y = 0; y < 4; y++)
+        {
+            for (int x = 0; x < 4; x++)
+                checker[y * 4 + x] = CHECKER[(x + y * 2) % 4];
+        }
+
+        scene.coverage.Create(ImTextureFormat_Alpha8, 8, 8);
+        unsigned char *coverage = scene.coverage.GetPixels();
+        for (int y = 0; y < 8; y++)
+        {
+            for (int x = 0; x < 8; x++)
+                coverage[y * 8 + x] = (unsigned char)((x * 36 + y * 9) & 0xFF);
+        }
+
+        scene.checker.Status = ImTextureStatus_WantCreate;
+        scene.coverage.Status = ImTextureStatus_WantCreate;
+        scene.textures.push_back(&scene.checker);
+        scene.textures.push_back(&scene.coverage);
+    }
+
+    // Frame 1 changes the translucent quad, which the partial redraw then picks up only
+    // inside the damage rect
+    void BuildDrawData(Scene &scene, int frame)
+    {
+        ImDrawList &list = scene.list;
+        list.CmdBuffer.resize(0);
+        list.IdxBuffer.resize(0);
+        list.VtxBuffer.resize(0);
+
+        const ImVec4 fullClip(DISPLAY_X, DISPLAY_Y, DISPLAY_X + WIDTH, DISPLAY_Y + HEIGHT);
+
+        // Solid: a gradient across all four tiles, a translucent quad at fractional coordinates
+        // and a clockwise triangle, which the renderer has to flip
+        BeginCommand(list, fullClip, ImTextureRef());
+        AddTriangle(list, ImVec2(12.0f, 22.0f), ImVec2(104.0f, 30.0f), ImVec2(40.0f, 98.0f), IM_COL32(255, 0, 0, 255),
+                    IM_COL32(0, 255, 0, 255), IM_COL32(0, 0, 255, 255));
+        ImU32 translucent = frame == 0 ? IM_COL32(255, 255, 0, 128) : IM_COL32(0, 255, 255, 160);
+        AddQuad(list, ImVec2(30.25f, 40.5f), ImVec2(90.75f, 70.25f), ImVec2(0, 0), ImVec2(0, 0), translucent);
+        AddTriangle(list, ImVec2(100.0f, 90.0f), ImVec2(104.5f, 99.0f), ImVec2(62.0f, 95.5f), IM_COL32(255, 255, 255, 200),
+                    IM_COL32(255, 128, 0, 200), IM_COL32(128, 0, 255, 60));
+
+        // Magnified checker, bilinear filtered and cut by a fractional clip rect
+        BeginCommand(list, ImVec4(20.6f, 25.3f, 80.9f, 60.7f), scene.checker.GetTexRef());
+        AddQuad(list, ImVec2(14.0f, 24.0f), ImVec2(78.0f, 88.0f), ImVec2(0, 0), ImVec2(1, 1), IM_COL32(255, 255, 255, 255));
+
+        // The same checker at 1:1, where every sample lands on a texel center
+        BeginCommand(list, fullClip, scene.checker.GetTexRef());
+        AddQuad(list, ImVec2(86.0f, 24.0f), ImVec2(90.0f, 28.0f), ImVec2(0, 0), ImVec2(1, 1), IM_COL32(255, 255, 255, 255));
+
+        AddCallback(list, CountCallback);
+        AddCallback(list, ImDrawCallback_ResetRenderState);
+
+        // Alpha8 coverage tinted like text, at 2x
+        BeginCommand(list, fullClip, scene.coverage.GetTexRef());
+        AddQuad(list, ImVec2(60.0f, 76.0f), ImVec2(76.0f, 92.0f), ImVec2(0, 0), ImVec2(1, 1), IM_COL32(0, 128, 255, 255));
+
+        // Clipped away entirely
+        BeginCommand(list, ImVec4(200.0f, 200.0f, 220.0f, 220.0f), ImTextureRef());
+        AddQuad(list, ImVec2(10.0f, 20.0f), ImVec2(106.0f, 100.0f), ImVec2(0, 0), ImVec2(0, 0), IM_COL32(255, 0, 255, 255));
+
+        ImDrawData &drawData = scene.drawData;
+        drawData.Valid = true;
+        drawData.CmdLists.resize(0);
+        drawData.CmdLists.push_back(&list);
+        drawData.CmdListsCount = 1;
+        drawData.TotalVtxCount = list.VtxBuffer.Size;
+        drawData.TotalIdxCount = list.IdxBuffer.Size;
+        drawData.DisplayPos = ImVec2(DISPLAY_X, DISPLAY_Y);
+        drawData.DisplaySize = ImVec2((float)WIDTH, (float)HEIGHT);
+        drawData.FramebufferScale = ImVec2(1.0f, 1.0f);
+        drawData.Textures = &scene.textures;
+    }
+
+    bool ReadFile(const std::string &path, std::vector<char> &contents)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+            return false;
+        contents.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+
+    // With update set, (re)writes the reference instead. A mismatching frame is left next to
+    // the test binary for inspection.
+    bool MatchesGolden(const Platform::SoftwareRenderer &renderer, const std::string &goldenDir, const char *name, bool update)
+    {
+        std::string goldenPath = goldenDir + "/" + name;
+        if (update)
+            return renderer.SaveSnapshot(goldenPath);
+
+        std::string actualPath = (std::filesystem::temp_directory_path() / ("snap_tools_actual_" + std::string(name))).string();
+        std::vector<char> expected, actual;
+        if (!renderer.SaveSnapshot(actualPath) || !ReadFile(actualPath, actual))
+            return false;
+        if (!ReadFile(goldenPath, expected))
+        {
+            fprintf(stderr, "Missing reference %s\n", goldenPath.c_str());
+            return false;
+        }
+        if (expected == actual)
+        {
+            std::filesystem::remove(actualPath);
+            return true;
+        }
+
+        // Pixels follow a "P6\n<w> <h>\n255\n" header of the same length in both files
+        size_t header = actual.size() - (size_t)WIDTH * HEIGHT * 3;
+        size_t count = std::min(expected.size(), actual.size());
+        for (size_t i = header; i < count; i++)
+        {
+            if (expected[i] != actual[i])
+            {
+                size_t pixel = (i - header) / 3;
+                fprintf(stderr, "%s differs first at pixel %zu, %zu; actual frame kept as %s\n", name, pixel % WIDTH, pixel / WIDTH,
+                        actualPath.c_str());
+                break;
+            }
+        }
+        return false;
+    }
+
+    uint32_t PixelAt(const Platform::SoftwareRenderer &renderer, int x, int y)
+    {
+        return renderer.GetPixels()[(size_t)y * renderer.GetWidth() + x];
+    }
+
+    void TestRender(int threads, const std::string &goldenDir, bool update)
+    {
+        Platform::SoftwareRenderer renderer(threads);
+        Scene scene;
+        CreateTextures(scene);
+        BuildDrawData(scene, 0);
+
+        renderer.UpdateTextures(&scene.drawData);
+        CHECK(scene.checker.Status == ImTextureStatus_OK && scene.coverage.Status == ImTextureStatus_OK);
+        CHECK(scene.checker.TexID != ImTextureID_Invalid && scene.coverage.TexID != ImTextureID_Invalid);
+
+        g_callbackCalls = 0;
+        renderer.Render(&scene.drawData, CLEAR_COLOR);
+        CHECK(renderer.GetWidth() == WIDTH && renderer.GetHeight() == HEIGHT);
+        CHECK(g_callbackCalls == 1);
+        CHECK(MatchesGolden(renderer, goldenDir, "software_renderer_full.ppm", update));
+
+        // Spot checks that do not depend on the references: the cleared corner, and the 1:1
+        // checker whose pixels are exact texel copies
+        CHECK(PixelAt(renderer, 0, HEIGHT - 1) == CLEAR_PIXEL);
+        for (int y = 0; y < 4; y++)
+        {
+            for (int x = 0; x < 4; x++)
+                CHECK(PixelAt(renderer, 76 + x, 4 + y) == CHECKER[(x + y * 2) % 4]);
+        }
+        std::vector<uint32_t> fullFrame(renderer.GetPixels(), renderer.GetPixels() + WIDTH * HEIGHT);
+
+        // Partial redraw of the changed frame: outside the damage rect the previous frame stays
+        BuildDrawData(scene, 1);
+        renderer.Render(&scene.drawData, CLEAR_COLOR, &DAMAGE);
+        CHECK(g_callbackCalls == 2);
+        CHECK(MatchesGolden(renderer, goldenDir, "software_renderer_damage.ppm", update));
+
+        // The renderer rounds the damage rect outwards to whole pixels
+        int damageX0 = (int)std::floor(DAMAGE.x - DISPLAY_X), damageY0 = (int)std::floor(DAMAGE.y - DISPLAY_Y);
+        int damageX1 = (int)std::ceil(DAMAGE.z - DISPLAY_X), damageY1 = (int)std::ceil(DAMAGE.w - DISPLAY_Y);
+        int changedInside = 0;
+        bool outsideKept = true;
+        for (int y = 0; y < HEIGHT; y++)
+        {
+            for (int x = 0; x < WIDTH; x++)
+            {
+                bool inside = x >= damageX0 && x < damageX1 && y >= damageY0 && y < damageY1;
+                bool changed = PixelAt(renderer, x, y) != fullFrame[(size_t)y * WIDTH + x];
+                if (inside)
+                    changedInside += changed ? 1 : 0;
+                else
+                    outsideKept = outsideKept && !changed;
+            }
+        }
+        CHECK(outsideKept);
+        CHECK(changedInside > 0);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2 || (argc == 3 && strcmp(argv[2], "--update") != 0) || argc > 3)
+    {
+        fprintf(stderr, "Usage: %s <golden dir> [--update]\n", argv[0]);
+        return 2;
+    }
+    std::string goldenDir = argv[1];
+    bool update = argc == 3;
+
+#ifdef SOFTWARE_RENDERER_NO_SSE2
+    printf("Scalar rasterizer\n");
+#else
+    printf("Default rasterizer (SSE2 where available)\n");
+#endif
+    TestRender(1, goldenDir, update);
+    TestRender(4, goldenDir, false);
+
+    return TestResult(update ? "software_renderer_tests (references updated)" : "software_renderer_tests");
+}
\ No newline at end of file
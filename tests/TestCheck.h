@@ -0,0 +1,34 @@
+#ifndef TEST_CHECK_H
+#define TEST_CHECK_H
+
+// Minimal assertion helpers for the unit test executables: every failed CHECK is reported with
+// its location and counted, and main() returns TestResult() so CTest sees a non-zero exit code.
+
+#include <cstdio>
+
+inline int &TestFailureCount()
+{
+    static int failures = 0;
+    return failures;
+}
+
+#define CHECK(condition)                                                                    \
+    do                                                                                      \
+    {                                                                                       \
+        if (!(condition))                                                                   \
+        {                                                                                   \
+            fprintf(stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #condition);   \
+            TestFailureCount()++;                                                           \
+        }                                                                                   \
+    } while (0)
+
+inline int TestResult(const char *name)
+{
+    if (TestFailureCount() == 0)
+        printf("%s: all checks passed\n", name);
+    else
+        printf("%s: %d check(s) failed\n", name, TestFailureCount());
+    return TestFailureCount() == 0 ? 0 : 1;
+}
+
+#endif // TEST_CHECK_H
\ No newline at end of file
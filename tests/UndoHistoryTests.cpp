@@ -0,0 +1,219 @@
+// Undo/redo round-trips over random edits, resizing steps, the memory cap and Trim() for the
+// tiled undo history.
+
+#include "TestCheck.h"
+#include "image/Redact.h"
+#include "image/UndoHistory.h"
+#include <algorithm>
+#include <vector>
+
+namespace
+{
+    // Flat areas with some noise, like a screenshot: exercises runs as well as literals
+    Imaging::Image MakeImage(int width, int height, uint32_t seed)
+    {
+        Imaging::Image image;
+        image.Allocate(width, height);
+        uint32_t state = seed;
+        for (int y = 0; y < height; y++)
+        {
+            uint32_t *row = image.Row(y);
+            for (int x = 0; x < width; x++)
+            {
+                state = state * 1664525u + 1013904223u;
+                uint32_t band = (uint32_t)(y / 40) * 0x00203040u;
+                row[x] = 0xFF000000u | ((x % 97 < 3 || (state >> 28) == 0) ? (state >> 8) : band);
+            }
+        }
+        return image;
+    }
+
+    bool Same(const Imaging::Image &a, const Imaging::Image &b)
+    {
+        return a.width == b.width && a.height == b.height && a.pixels == b.pixels;
+    }
+
+    void RedactStep(Imaging::UndoHistory &history, Imaging::Image &image, const Imaging::RedactRegion &region)
+    {
+        history.BeginEdit(image, "Redact");
+        history.Touch(region.x, region.y, region.width, region.height);
+        Imaging::Redact(image, region);
+        CHECK(history.EndEdit(image));
+    }
+
+    void CropStep(Imaging::UndoHistory &history, Imaging::Image &image, int x, int y, int width, int height)
+    {
+        history.BeginEdit(image, "Crop");
+        history.TouchAll();
+        Imaging::Image cropped;
+        cropped.Allocate(width, height);
+        for (int row = 0; row < height; row++)
+            std::copy_n(image.Row(y + row) + x, width, cropped.Row(row));
+        image = std::move(cropped);
+        CHECK(history.EndEdit(image));
+    }
+
+    void TestRoundTrip()
+    {
+        Imaging::UndoHistory history;
+        Imaging::Image image = MakeImage(301, 217, 1);
+        std::vector<Imaging::Image> states = {image};
+
+        uint32_t state = 7;
+        for (int i = 0; i < 12; i++)
+        {
+            state = state * 1664525u + 1013904223u;
+            Imaging::RedactRegion region;
+            region.x = (int)(state % 280) - 10;
+            region.y = (int)((state >> 9) % 200) - 10;
+            region.width = 5 + (int)((state >> 17) % 120);
+            region.height = 5 + (int)((state >> 24) % 90);
+            region.mode = (i & 1) ? Imaging::RedactMode::Pixelate : Imaging::RedactMode::Fill;
+            region.color = 0xFF000000u | state;
+            RedactStep(history, image, region);
+            states.push_back(image);
+        }
+        CHECK(history.GetStepCount() == 12);
+        CHECK(history.GetUndoLabel() == "Redact");
+
+        // All the way back, checking every intermediate state, then all the way forward
+        for (size_t i = states.size() - 1; i > 0; i--)
+        {
+            CHECK(history.Undo(image));
+            CHECK(Same(image, states[i - 1]));
+        }
+        CHECK(!history.CanUndo() && !history.Undo(image));
+        for (size_t i = 1; i < states.size(); i++)
+        {
+            CHECK(history.Redo(image));
+            CHECK(Same(image, states[i]));
+        }
+        CHECK(!history.CanRedo());
+
+        // A new edit after undoing discards the redo branch
+        CHECK(history.Undo(image) && history.Undo(image));
+        Imaging::RedactRegion region;
+        region.width = region.height = 10;
+        RedactStep(history, image, region);
+        CHECK(!history.CanRedo());
+        CHECK(history.GetStepCount() == 11);
+    }
+
+    void TestEmptyEditRecordsNothing()
+    {
+        Imaging::UndoHistory history;
+        Imaging::Image image = MakeImage(64, 64, 2);
+        history.BeginEdit(image, "Nothing");
+        history.Touch(100, 100, 10, 10); // Entirely outside
+        CHECK(history.EndEdit(image));
+        CHECK(history.GetStepCount() == 0 && !history.CanUndo());
+    }
+
+    void TestResizeSteps()
+    {
+        Imaging::UndoHistory history;
+        Imaging::Image image = MakeImage(200, 150, 3);
+        Imaging::Image original = image;
+
+        CropStep(history, image, 30, 20, 100, 70);
+        Imaging::Image cropped = image;
+        Imaging::RedactRegion region;
+        region.x = 10;
+        region.y = 10;
+        region.width = 50;
+        region.height = 30;
+        RedactStep(history, image, region);
+        Imaging::Image redacted = image;
+
+        CHECK(history.Undo(image) && Same(image, cropped));
+        CHECK(history.Undo(image) && Same(image, original));
+        CHECK(history.Redo(image) && Same(image, cropped));
+        CHECK(history.Redo(image) && Same(image, redacted));
+
+        // Undo refuses an image that is not in the state the history left it in
+        Imaging::Image wrongSize = MakeImage(10, 10, 4);
+        CHECK(!history.Undo(wrongSize));
+
+        // Resizing without TouchAll() cannot be undone, so it is not recorded
+        history.BeginEdit(image, "Bad crop");
+        history.Touch(0, 0, 10, 10);
+        image.Allocate(50, 50);
+        CHECK(!history.EndEdit(image));
+        CHECK(history.GetStepCount() == 2 && history.GetUndoLabel() == "Redact");
+    }
+
+    void TestMemoryCap()
+    {
+        Imaging::Image image = MakeImage(512, 512, 5);
+
+        // Measure one full-image step, then cap the history at about three of them
+        size_t stepBytes;
+        {
+            Imaging::UndoHistory probe;
+            Imaging::Image copy = image;
+            Imaging::RedactRegion region;
+            region.width = region.height = 512;
+            region.mode = Imaging::RedactMode::Pixelate;
+            RedactStep(probe, copy, region);
+            stepBytes = probe.GetMemoryBytes();
+        }
+        CHECK(stepBytes > 0);
+
+        Imaging::UndoHistory history(stepBytes * 3 + stepBytes / 2);
+        for (int i = 0; i < 8; i++)
+        {
+            Imaging::RedactRegion region;
+            region.width = region.height = 512;
+            region.mode = Imaging::RedactMode::Pixelate;
+            region.blockSize = 4 + i;
+            RedactStep(history, image, region);
+            CHECK(history.GetMemoryBytes() <= history.GetMemoryLimit());
+        }
+        // Older steps were dropped to stay under the cap
+        CHECK(history.GetStepCount() >= 1 && history.GetStepCount() < 8);
+
+        // The newest step is kept even when it alone exceeds the limit
+        history.SetMemoryLimit(1);
+        CHECK(history.GetStepCount() == 1 && history.CanUndo());
+
+        // Trim() may drop everything, and reports what it released
+        size_t before = history.GetMemoryBytes();
+        CHECK(history.Trim(0) == before);
+        CHECK(history.GetMemoryBytes() == 0 && !history.CanUndo() && !history.CanRedo());
+    }
+
+    void TestTrimKeepsRecentSteps()
+    {
+        Imaging::UndoHistory history;
+        Imaging::Image image = MakeImage(256, 256, 6);
+        std::vector<Imaging::Image> states = {image};
+        for (int i = 0; i < 6; i++)
+        {
+            Imaging::RedactRegion region;
+            region.x = i * 40;
+            region.width = 40;
+            region.height = 256;
+            RedactStep(history, image, region);
+            states.push_back(image);
+        }
+
+        // Oldest steps go first; what remains still undoes correctly
+        history.Trim(history.GetMemoryBytes() / 2);
+        size_t remaining = history.GetStepCount();
+        CHECK(remaining > 0 && remaining < 6);
+        for (size_t i = 0; i < remaining; i++)
+            CHECK(history.Undo(image));
+        CHECK(Same(image, states[6 - remaining]));
+        CHECK(!history.CanUndo());
+    }
+}
+
+int main()
+{
+    TestRoundTrip();
+    TestEmptyEditRecordsNothing();
+    TestResizeSteps();
+    TestMemoryCap();
+    TestTrimKeepsRecentSteps();
+    return TestResult("undo_history_tests");
+}
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Desktop capture across separate X screens. Needs a running X server with two screens of the
+// sizes given on the command line; run it through tests/RunUnderXvfb.sh.
+
+#include "TestCheck.h"
+#include "platform/X11DesktopCapture.h"
+#include <X11/Xlib.h>
+#include <cstdio>
+
+namespace
+{
+    struct ScreenSize
+    {
+        int width = 0;
+        int height = 0;
+    };
+
+    // Solid root window backgrounds, so each monitor's pixels can be told apart in the canvas
+    constexpr unsigned long SCREEN_COLORS[2] = {0xFF0000, 0x0000FF};
+    // The same colors in the canvas' RGBA layout
+    constexpr uint32_t CANVAS_COLORS[2] = {0xFF0000FFu, 0xFFFF0000u};
+    constexpr uint32_t GAP_COLOR = 0xFF000000u;
+
+    bool PaintRoots(Display *display)
+    {
+        if (ScreenCount(display) != 2)
+            return false;
+        for (int screen = 0; screen < 2; screen++)
+        {
+            Window root = RootWindow(display, screen);
+            XSetWindowBackground(display, root, SCREEN_COLORS[screen]);
+            XClearWindow(display, root);
+        }
+        XSync(display, False);
+        return true;
+    }
+
+    void TestScreensSideBySide(const ScreenSize (&screens)[2])
+    {
+        Platform::X11DesktopCapture capture;
+        Imaging::Image canvas;
+        std::vector<Platform::DesktopOutput> outputs;
+        CHECK(capture.Capture(canvas, outputs));
+
+        // Separate screens are laid out left to right, top-aligned
+        int expectedWidth = screens[0].width + screens[1].width;
+        int expectedHeight = screens[0].height > screens[1].height ? screens[0].height : screens[1].height;
+        CHECK(canvas.width == expectedWidth && canvas.height == expectedHeight);
+        CHECK(capture.GetOriginX() == 0 && capture.GetOriginY() == 0);
+        CHECK(outputs.size() == 2);
+        if (outputs.size() != 2 || canvas.width != expectedWidth || canvas.height != expectedHeight)
+            return;
+
+        int x = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            const Platform::DesktopOutput &output = outputs[i];
+            CHECK(output.x == x && output.y == 0);
+            CHECK(output.width == screens[i].width && output.height == screens[i].height);
+            // Corners and center of each monitor's rectangle
+            CHECK(canvas.Row(0)[x] == CANVAS_COLORS[i]);
+            CHECK(canvas.Row(0)[x + output.width - 1] == CANVAS_COLORS[i]);
+            CHECK(canvas.Row(output.height - 1)[x] == CANVAS_COLORS[i]);
+            CHECK(canvas.Row(output.height - 1)[x + output.width - 1] == CANVAS_COLORS[i]);
+            CHECK(canvas.Row(output.height / 2)[x + output.width / 2] == CANVAS_COLORS[i]);
+            // Below the shorter monitor nothing was grabbed
+            if (output.height < canvas.height)
+            {
+                CHECK(canvas.Row(output.height)[x] == GAP_COLOR);
+                CHECK(canvas.Row(canvas.height - 1)[x + output.width - 1] == GAP_COLOR);
+            }
+            x += output.width;
+        }
+
+        // A second capture fills the same canvas
+        const uint32_t *pixels = canvas.pixels.data();
+        CHECK(capture.Capture(canvas, outputs));
+        CHECK(canvas.pixels.data() == pixels);
+        CHECK(canvas.Row(0)[0] == CANVAS_COLORS[0]);
+        CHECK(canvas.Row(0)[screens[0].width] == CANVAS_COLORS[1]);
+    }
+
+    bool ParseSize(const char *text, ScreenSize &size)
+    {
+        return sscanf(text, "%dx%d", &size.width, &size.height) == 2 && size.width > 0 && size.height > 0;
+    }
+}
+
+// Usage: snap_tools_x11_capture_tests <screen 0 WxH> <screen 1 WxH>, with DISPLAY set
+int main(int argc, char **argv)
+{
+    ScreenSize screens[2];
+    if (argc != 3 || !ParseSize(argv[1], screens[0]) || !ParseSize(argv[2], screens[1]))
+    {
+        fprintf(stderr, "Usage: %s <screen 0 WxH> <screen 1 WxH>\n", argv[0]);
+        return 2;
+    }
+
+    Display *display = XOpenDisplay(nullptr);
+    CHECK(display != nullptr);
+    if (display == nullptr)
+        return TestResult("x11_capture_tests");
+    CHECK(PaintRoots(display));
+
+    TestScreensSideBySide(screens);
+
+    XCloseDisplay(display);
+    return TestResult("x11_capture_tests");
+}
\ No newline at end of file
@@ -0,0 +1,169 @@
+// Fuzz target for the image decoders. Every input must either be rejected or decode to an image
+// that survives a PNG round trip unchanged; anything else aborts, and the sanitizers catch reads
+// past the end of the data.
+//
+// Built with Clang and SNAP_TOOLS_FUZZ=ON this links libFuzzer:
+//     snap_tools_image_codec_fuzz -max_len=65536 corpus/
+// Other builds get a driver that replays the files named on the command line, or with no
+// arguments runs a fixed number of mutations of small encoded images (the image_codec_fuzz CTest).
+
+#include "image/Deflate.h"
+#include "image/ImageCodec.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+namespace
+{
+    void Require(bool condition, const char *what)
+    {
+        if (!condition)
+        {
+            fprintf(stderr, "image_codec_fuzz: %s\n", what);
+            abort();
+        }
+    }
+}
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t *data, size_t size)
+{
+    // The deflate layer on its own, with the output cap PNG decoding relies on
+    std::vector<uint8_t> inflated;
+    if (Imaging::ZlibDecompress(data, size, inflated, 1 << 20))
+        Require(inflated.size() <= (1 << 20), "inflate exceeded its output limit");
+
+    Imaging::ImageFile file;
+    std::string error;
+    if (!Imaging::DecodeImage(data, size, file, error))
+    {
+        Require(!error.empty(), "rejected without an error message");
+        return 0;
+    }
+    Require(file.image.width > 0 && file.image.height > 0, "decoded an empty image");
+    Require(file.image.pixels.size() == (size_t)file.image.width * file.image.height, "pixel count mismatch");
+
+    std::vector<uint8_t> encoded;
+    Require(Imaging::EncodeImage(file, Imaging::ImageFormat::Png, encoded, 1), "cannot re-encode");
+    Imaging::ImageFile decoded;
+    Require(Imaging::DecodeImage(encoded.data(), encoded.size(), decoded, error), "cannot decode own PNG");
+    Require(decoded.image.width == file.image.width && decoded.image.height == file.image.height &&
+                decoded.image.pixels == file.image.pixels,
+            "PNG round trip changed the image");
+    return 0;
+}
+
+#ifndef SNAP_TOOLS_LIBFUZZER
+namespace
+{
+    bool ReadFile(const char *path, std::vector<uint8_t> &data)
+    {
+        FILE *file = fopen(path, "rb");
+        if (!file)
+            return false;
+        uint8_t buffer[4096];
+        size_t read;
+        while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            data.insert(data.end(), buffer, buffer + read);
+        fclose(file);
+        return true;
+    }
+
+    std::vector<std::vector<uint8_t>> MakeSeeds()
+    {
+        Imaging::ImageFile source;
+        source.image.Allocate(13, 7);
+        for (size_t i = 0; i < source.image.pixels.size(); i++)
+            source.image.pixels[i] = (uint32_t)(i * 0x9E3779B9u) | (i % 3 == 0 ? 0xFF000000u : 0u);
+        Imaging::ImageFile opaque = source;
+        for (uint32_t &pixel : opaque.image.pixels)
+            pixel |= 0xFF000000u;
+
+        std::vector<std::vector<uint8_t>> seeds;
+        const Imaging::ImageFormat formats[] = {Imaging::ImageFormat::Png, Imaging::ImageFormat::Bmp, Imaging::ImageFormat::Tga,
+                                                Imaging::ImageFormat::Ppm};
+        for (Imaging::ImageFormat format : formats)
+        {
+            for (const Imaging::ImageFile *file : {&source, &opaque})
+            {
+                std::vector<uint8_t> encoded;
+                if (Imaging::EncodeImage(*file, format, encoded, 0))
+                    seeds.push_back(std::move(encoded));
+            }
+        }
+        return seeds;
+    }
+
+    // Byte flips, boundary values, truncation and duplicated spans: enough to walk every header
+    // field, not a replacement for a coverage-guided run
+    void Mutate(std::vector<uint8_t> &data, uint32_t &state)
+    {
+        auto next = [&state]()
+        {
+            state = state * 1664525u + 1013904223u;
+            return state >> 8;
+        };
+        const uint8_t interesting[] = {0x00, 0x01, 0x7F, 0x80, 0xFF};
+        int count = 1 + (int)(next() % 4);
+        for (int i = 0; i < count && !data.empty(); i++)
+        {
+            size_t pos = next() % data.size();
+            switch (next() % 4)
+            {
+            case 0:
+                data[pos] ^= (uint8_t)(1u << (next() % 8));
+                break;
+            case 1:
+                data[pos] = interesting[next() % sizeof(interesting)];
+                break;
+            case 2:
+                data.resize(pos);
+                break;
+            default:
+            {
+                size_t length = std::min<size_t>(1 + next() % 16, data.size() - pos);
+                std::vector<uint8_t> span(data.begin() + (std::ptrdiff_t)pos, data.begin() + (std::ptrdiff_t)(pos + length));
+                data.insert(data.begin() + (std::ptrdiff_t)(next() % data.size()), span.begin(), span.end());
+                break;
+            }
+            }
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            std::vector<uint8_t> data;
+            if (!ReadFile(argv[i], data))
+            {
+                fprintf(stderr, "Cannot read %s\n", argv[i]);
+                return 2;
+            }
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+        printf("image_codec_fuzz: replayed %d file(s)\n", argc - 1);
+        return 0;
+    }
+
+    constexpr int MUTATIONS_PER_SEED = 5000;
+    std::vector<std::vector<uint8_t>> seeds = MakeSeeds();
+    uint32_t state = 12345;
+    for (const std::vector<uint8_t> &seed : seeds)
+    {
+        LLVMFuzzerTestOneInput(seed.data(), seed.size());
+        for (int i = 0; i < MUTATIONS_PER_SEED; i++)
+        {
+            std::vector<uint8_t> data = seed;
+            Mutate(data, state);
+            LLVMFuzzerTestOneInput(data.data(), data.size());
+        }
+    }
+    printf("image_codec_fuzz: %zu seeds x %d mutations passed\n", seeds.size(), MUTATIONS_PER_SEED);
+    return 0;
+}
+#endif
\ No newline at end of file